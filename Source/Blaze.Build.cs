@@ -23,6 +23,7 @@ public class Blaze : ModuleRules
         PublicDependencyModuleNames.AddRange(new[] {
             "Core",
             "CoreUObject",
+            "AssetRegistry",
             "InputCore",
             "Engine",
             "Slate",
@@ -32,5 +33,11 @@ public class Blaze : ModuleRules
             "CommonUI",
             "GameplayTags",
         });
+
+        // FInstancedStruct moved from the StructUtils plugin into CoreUObject in 5.5
+        if (Target.Version.MajorVersion == 5 && Target.Version.MinorVersion < 5)
+        {
+            PublicDependencyModuleNames.Add("StructUtils");
+        }
     }
 }
@@ -12,21 +12,56 @@
  * limitations under the License.
  */
 #include "Blaze.h"
+#include "Blaze/BlazeDependencyClosure.h"
+#include "Blaze/BlazeGarbageCollection.h"
+#include "Blaze/BlazeMemoryPressure.h"
+#include "Blaze/BlazeTrace.h"
+#include "Blaze/BlazeTransitionBudget.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 namespace BlazeAsyncLoadTests
 {
     void ForceLinkAsyncLoadTests();
 }
+namespace BlazePrimaryLayoutTests
+{
+    void ForceLinkPrimaryLayoutTests();
+}
+namespace BlazeSoakTests
+{
+    void ForceLinkSoakTests();
+}
+namespace BlazeTraceTests
+{
+    void ForceLinkTraceTests();
+}
 #endif
 
 void FBlazeModule::StartupModule()
 {
+    FBlazeDependencyClosure::Startup();
+    FBlazeGarbageCollection::Startup();
+    FBlazeMemoryPressure::Startup();
+    FBlazeTransitionBudget::Startup();
 #if WITH_DEV_AUTOMATION_TESTS
     BlazeAsyncLoadTests::ForceLinkAsyncLoadTests();
+    BlazePrimaryLayoutTests::ForceLinkPrimaryLayoutTests();
+    BlazeSoakTests::ForceLinkSoakTests();
+    BlazeTraceTests::ForceLinkTraceTests();
 #endif
 }
 
-void FBlazeModule::ShutdownModule() {}
+void FBlazeModule::ShutdownModule()
+{
+    // Save any trace that is still being recorded rather than losing the session
+    if (FBlazeTraceRecorder::IsRecording())
+    {
+        FBlazeTraceRecorder::Stop();
+    }
+    FBlazeTransitionBudget::Shutdown();
+    FBlazeMemoryPressure::Shutdown();
+    FBlazeGarbageCollection::Shutdown();
+    FBlazeDependencyClosure::Shutdown();
+}
 
 IMPLEMENT_MODULE(FBlazeModule, Blaze);
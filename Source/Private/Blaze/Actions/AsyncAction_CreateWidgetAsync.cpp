@@ -12,6 +12,7 @@
  * limitations under the License.
  */
 #include "Blaze/Actions/AsyncAction_CreateWidgetAsync.h"
+#include "Blaze/BlazeDependencyClosure.h"
 #include "Blaze/BlazeFunctionLibrary.h"
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
@@ -98,9 +99,33 @@ void UAsyncAction_CreateWidgetAsync::Activate()
         : NAME_None;
 
     TWeakObjectPtr Self(this);
+    FBlazeDependencyClosure::Request(
+        WidgetClass.ToSoftObjectPath(),
+        [Self, WeakPlayer, SuspendInputToken](const TArray<FSoftObjectPath>& Paths) {
+            if (Self.IsValid() && Self->IsActive())
+            {
+                Self->BeginLoad(Paths, WeakPlayer, SuspendInputToken);
+            }
+            // The action was canceled or collected while the dependency closure was computed
+            else if (Self.IsValid())
+            {
+                Self->OnCancel(WeakPlayer, SuspendInputToken, Self);
+            }
+            else if (const auto PlayerController = WeakPlayer.Get())
+            {
+                UBlazeFunctionLibrary::ResumeInputForPlayer(PlayerController, SuspendInputToken);
+            }
+        });
+}
+
+void UAsyncAction_CreateWidgetAsync::BeginLoad(const TArray<FSoftObjectPath>& Paths,
+                                               const TWeakObjectPtr<APlayerController> WeakPlayer,
+                                               const FName SuspendInputToken)
+{
+    TWeakObjectPtr Self(this);
 
     Handle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
-        WidgetClass.ToSoftObjectPath(),
+        Paths,
         FStreamableDelegate::CreateLambda([Self, WeakPlayer, SuspendInputToken] {
             if (const auto PlayerController = WeakPlayer.Get())
             {
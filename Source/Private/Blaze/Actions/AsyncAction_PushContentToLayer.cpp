@@ -14,8 +14,8 @@
 #include "Blaze/Actions/AsyncAction_PushContentToLayer.h"
 #include "Blaze/BlazeFunctionLibrary.h"
 #include "Blaze/BlazePrimaryLayout.h"
+#include "Blaze/BlazePrimaryLayoutManager.h"
 #include "Engine/Engine.h"
-#include "Engine/StreamableManager.h"
 #include "UObject/Stack.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AsyncAction_PushContentToLayer)
@@ -24,7 +24,8 @@ UAsyncAction_PushContentToLayer*
 UAsyncAction_PushContentToLayer::PushContentToLayerAsync(APlayerController* PlayerController,
                                                          const FGameplayTag LayerName,
                                                          const TSoftClassPtr<UCommonActivatableWidget> WidgetClass,
-                                                         const bool bSuspendInputUntilComplete)
+                                                         const bool bSuspendInputUntilComplete,
+                                                         const bool bRevealWhenResident)
 {
     if (!PlayerController)
     {
@@ -65,6 +66,7 @@ UAsyncAction_PushContentToLayer::PushContentToLayerAsync(APlayerController* Play
         Action->LayerName = LayerName;
         Action->WidgetClass = WidgetClass;
         Action->bSuspendInputUntilComplete = bSuspendInputUntilComplete;
+        Action->bRevealWhenResident = bRevealWhenResident;
         Action->RegisterWithGameInstance(World);
         return Action;
     }
@@ -74,46 +76,72 @@ UAsyncAction_PushContentToLayer::PushContentToLayerAsync(APlayerController* Play
     }
 }
 
+UAsyncAction_PushContentToLayer* UAsyncAction_PushContentToLayer::PushContentToLayerWithPayloadAsync(
+    APlayerController* PlayerController,
+    const FGameplayTag LayerName,
+    const TSoftClassPtr<UCommonActivatableWidget> WidgetClass,
+    const FInstancedStruct& Payload,
+    const bool bSuspendInputUntilComplete,
+    const bool bRevealWhenResident)
+{
+    const auto Action = PushContentToLayerAsync(PlayerController,
+                                                LayerName,
+                                                WidgetClass,
+                                                bSuspendInputUntilComplete,
+                                                bRevealWhenResident);
+    if (Action)
+    {
+        Action->Payload = Payload;
+    }
+    return Action;
+}
+
 void UAsyncAction_PushContentToLayer::Cancel()
 {
     Super::Cancel();
 
-    if (Handle.IsValid())
+    Request.Cancel();
+    Request.Reset();
+}
+
+void UAsyncAction_PushContentToLayer::OnRequestStateChanged(const EBlazePushWidgetToLayerState State,
+                                                            UCommonActivatableWidget* Widget)
+{
+    if (EBlazePushWidgetToLayerState::Initialize == State)
     {
-        Handle->CancelHandle();
-        Handle.Reset();
+        const auto Manager = UBlazeFunctionLibrary::GetPrimaryLayoutManager(PlayerController.Get());
+        if (Manager && Widget)
+        {
+            Manager->AssignSharedWidgetOwner(*Widget, PlayerController->GetLocalPlayer());
+        }
+        OnInitialize.Broadcast(Widget);
+    }
+    else if (EBlazePushWidgetToLayerState::AfterPush == State)
+    {
+        AfterPush.Broadcast(Widget);
+        SetReadyToDestroy();
+        Request.Reset();
+    }
+    else if (EBlazePushWidgetToLayerState::Canceled == State)
+    {
+        OnCancelled.Broadcast(Widget);
+        SetReadyToDestroy();
+        Request.Reset();
     }
 }
 
 void UAsyncAction_PushContentToLayer::Activate()
 {
-    if (const auto Layout = UBlazeFunctionLibrary::GetPrimaryLayout(PlayerController.Get()))
+    const auto LocalPlayer = PlayerController.IsValid() ? PlayerController->GetLocalPlayer() : nullptr;
+    if (const auto Layout = UBlazeFunctionLibrary::GetLayoutForLayer(LocalPlayer, LayerName))
     {
-        TWeakObjectPtr Self(this);
-
-        Handle = Layout->PushWidgetToLayerAsync<UCommonActivatableWidget>(
+        Request = Layout->PushWidgetToLayerAsyncWithPayload(
             LayerName,
             bSuspendInputUntilComplete,
             WidgetClass,
-            [Self](auto State, auto Widget) {
-                if (Self.IsValid())
-                {
-                    if (EBlazePushWidgetToLayerState::Initialize == State)
-                    {
-                        Self->OnInitialize.Broadcast(Widget);
-                    }
-                    else if (EBlazePushWidgetToLayerState::AfterPush == State)
-                    {
-                        Self->AfterPush.Broadcast(Widget);
-                        Self->SetReadyToDestroy();
-                    }
-                    else if (EBlazePushWidgetToLayerState::Canceled == State)
-                    {
-                        Self->OnCancelled.Broadcast(Widget);
-                        Self->SetReadyToDestroy();
-                    }
-                }
-            });
+            MoveTemp(Payload),
+            FBlazePushRequestDelegate::CreateUObject(this, &UAsyncAction_PushContentToLayer::OnRequestStateChanged),
+            bRevealWhenResident);
     }
     else
     {
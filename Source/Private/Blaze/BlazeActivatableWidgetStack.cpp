@@ -0,0 +1,65 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeActivatableWidgetStack.h"
+#include "CommonActivatableWidget.h"
+#include "Slate/SCommonAnimatedSwitcher.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BlazeActivatableWidgetStack)
+
+UCommonActivatableWidget*
+UBlazeActivatableWidgetStack::InsertWidget(const TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                           const int32 Index,
+                                           const TFunctionRef<void(UCommonActivatableWidget&)> InitFunc)
+{
+    const auto InsertIndex = FMath::Clamp(Index, 0, WidgetList.Num());
+    if (WidgetList.Num() == InsertIndex)
+    {
+        // A widget added to the top of the stack is displayed, which the stack already supports
+        return AddWidget<UCommonActivatableWidget>(WidgetClass, InitFunc);
+    }
+    else if (const auto Widget = GeneratedWidgetsPool.GetOrCreateInstance<UCommonActivatableWidget>(WidgetClass))
+    {
+        InitFunc(*Widget);
+        InsertWidgetInstance(*Widget, InsertIndex);
+        return Widget;
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void UBlazeActivatableWidgetStack::InsertWidgetInstance(UCommonActivatableWidget& Widget, const int32 Index)
+{
+    const auto InsertIndex = FMath::Clamp(Index, 0, WidgetList.Num());
+    WidgetList.Insert(&Widget, InsertIndex);
+    if (MySwitcher)
+    {
+        const auto ActiveIndex = MySwitcher->GetActiveWidgetIndex();
+        MySwitcher->AddSlot(InsertIndex)[Widget.TakeWidget()];
+        // An empty switcher reports index 0 although it displays nothing, so there is no widget to shift past
+        if (InsertIndex <= ActiveIndex && ActiveIndex + 1 < MySwitcher->GetNumWidgets())
+        {
+            // The switcher tracks the displayed widget by index, so shift the index past the inserted slot
+            // directly rather than via a transition that would deactivate the displayed widget
+            MySwitcher->SetActiveWidgetIndex(ActiveIndex + 1);
+        }
+    }
+}
+
+void UBlazeActivatableWidgetStack::ReleasePooledWidgets()
+{
+    // The pool does not distinguish the widgets on the stack, which keep their Slate widgets in the switcher
+    GeneratedWidgetsPool.ResetPool();
+}
@@ -0,0 +1,220 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeCoroutines.h"
+
+#if BLAZE_WITH_COROUTINES
+
+    #include "Blaze/BlazeDependencyClosure.h"
+    #include "Blaze/BlazePrimaryLayout.h"
+    #include "Blueprint/UserWidget.h"
+    #include "Blueprint/WidgetBlueprintLibrary.h"
+    #include "CommonActivatableWidget.h"
+    #include "Engine/AssetManager.h"
+    #include "Engine/StreamableManager.h"
+    #include "GameFramework/PlayerController.h"
+    #include "UObject/UObjectGlobals.h"
+
+// Each awaitable suspends by starting the operation inside await_suspend. An operation that completes
+// before it returns must not resume the coroutine from within await_suspend, so the completion callback
+// only records the result while bSuspending is set and await_suspend returns false to continue directly.
+
+FBlazePushWidgetAwaitable::FBlazePushWidgetAwaitable(UBlazePrimaryLayout* InLayout,
+                                                     const FGameplayTag& InLayerName,
+                                                     const TSoftClassPtr<UCommonActivatableWidget>& InWidgetClass,
+                                                     const bool bInSuspendInputUntilComplete,
+                                                     const bool bInRevealWhenResident)
+    : Layout(InLayout)
+    , LayerName(InLayerName)
+    , WidgetClass(InWidgetClass)
+    , bSuspendInputUntilComplete(bInSuspendInputUntilComplete)
+    , bRevealWhenResident(bInRevealWhenResident)
+{
+}
+
+bool FBlazePushWidgetAwaitable::await_suspend(const std::coroutine_handle<> InHandle)
+{
+    check(IsInGameThread());
+    Handle = InHandle;
+    bSuspending = true;
+    Request = Layout->PushWidgetToLayerAsync(
+        LayerName,
+        bSuspendInputUntilComplete,
+        WidgetClass,
+        FBlazePushRequestDelegate::CreateRaw(this, &FBlazePushWidgetAwaitable::OnStateChanged),
+        bRevealWhenResident);
+    bSuspending = false;
+    return !bDone;
+}
+
+UCommonActivatableWidget* FBlazePushWidgetAwaitable::await_resume() const
+{
+    return Widget.Get();
+}
+
+void FBlazePushWidgetAwaitable::OnStateChanged(const EBlazePushWidgetToLayerState State,
+                                               UCommonActivatableWidget* InWidget)
+{
+    if (EBlazePushWidgetToLayerState::Initialize != State)
+    {
+        Widget = InWidget;
+        bDone = true;
+        if (!bSuspending)
+        {
+            Handle.resume();
+        }
+    }
+}
+
+FBlazeCreateWidgetAwaitable::FBlazeCreateWidgetAwaitable(APlayerController* InOwningPlayer,
+                                                         const TSoftClassPtr<UUserWidget>& InWidgetClass)
+    : OwningPlayer(InOwningPlayer), WidgetClass(InWidgetClass)
+{
+}
+
+bool FBlazeCreateWidgetAwaitable::await_suspend(const std::coroutine_handle<> InHandle)
+{
+    check(IsInGameThread());
+    Handle = InHandle;
+    bSuspending = true;
+    // The closure is usually cached, in which case the load begins before Request returns
+    FBlazeDependencyClosure::Request(WidgetClass.ToSoftObjectPath(),
+                                     [this](const TArray<FSoftObjectPath>& Paths) { BeginLoad(Paths); });
+    bSuspending = false;
+    return !bDone;
+}
+
+void FBlazeCreateWidgetAwaitable::BeginLoad(const TArray<FSoftObjectPath>& Paths)
+{
+    LoadHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
+        Paths,
+        FStreamableDelegate::CreateRaw(this, &FBlazeCreateWidgetAwaitable::OnLoadFinished),
+        FStreamableManager::AsyncLoadHighPriority);
+    if (LoadHandle.IsValid() && !bDone)
+    {
+        LoadHandle->BindCancelDelegate(
+            FStreamableDelegate::CreateRaw(this, &FBlazeCreateWidgetAwaitable::OnLoadFinished));
+    }
+    else
+    {
+        OnLoadFinished();
+    }
+}
+
+UUserWidget* FBlazeCreateWidgetAwaitable::await_resume() const
+{
+    const auto PlayerController = OwningPlayer.Get();
+    const auto ResolvedClass = WidgetClass.Get();
+    if (PlayerController && ResolvedClass)
+    {
+        return UWidgetBlueprintLibrary::Create(PlayerController->GetWorld(), ResolvedClass, PlayerController);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void FBlazeCreateWidgetAwaitable::OnLoadFinished()
+{
+    if (!bDone)
+    {
+        bDone = true;
+        if (!bSuspending)
+        {
+            Handle.resume();
+        }
+    }
+}
+
+FBlazePreloadAwaitable::FBlazePreloadAwaitable(TArray<FSoftObjectPath> InPaths) : Paths(MoveTemp(InPaths)) {}
+
+bool FBlazePreloadAwaitable::await_suspend(const std::coroutine_handle<> InHandle)
+{
+    check(IsInGameThread());
+    Handle = InHandle;
+    bSuspending = true;
+    LoadHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
+        Paths,
+        FStreamableDelegate::CreateRaw(this, &FBlazePreloadAwaitable::OnLoadFinished),
+        FStreamableManager::AsyncLoadHighPriority);
+    if (LoadHandle.IsValid() && !bDone)
+    {
+        LoadHandle->BindCancelDelegate(FStreamableDelegate::CreateRaw(this, &FBlazePreloadAwaitable::OnLoadFinished));
+    }
+    else
+    {
+        bDone = true;
+    }
+    bSuspending = false;
+    return !bDone;
+}
+
+TSharedPtr<FStreamableHandle> FBlazePreloadAwaitable::await_resume() const
+{
+    if (LoadHandle.IsValid() && LoadHandle->HasLoadCompleted() && !LoadHandle->WasCanceled())
+    {
+        return LoadHandle;
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void FBlazePreloadAwaitable::OnLoadFinished()
+{
+    if (!bDone)
+    {
+        bDone = true;
+        if (!bSuspending)
+        {
+            Handle.resume();
+        }
+    }
+}
+
+FBlazeWidgetPoppedAwaitable::FBlazeWidgetPoppedAwaitable(UCommonActivatableWidget* InWidget) : Widget(InWidget) {}
+
+void FBlazeWidgetPoppedAwaitable::await_suspend(const std::coroutine_handle<> InHandle)
+{
+    check(IsInGameThread());
+    Handle = InHandle;
+    const auto CurrentWidget = Widget.Get();
+    // A stack deactivates the displayed widget when another widget covers it, so only the release by the layer is a pop
+    ReleasedHandle = CurrentWidget->OnSlateReleased().AddRaw(this, &FBlazeWidgetPoppedAwaitable::OnWidgetPopped);
+    // A widget that is collected without being popped broadcasts neither event, so resume rather than leak the frame
+    GarbageCollectedHandle =
+        FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FBlazeWidgetPoppedAwaitable::OnPostGarbageCollect);
+}
+
+void FBlazeWidgetPoppedAwaitable::OnWidgetPopped()
+{
+    if (const auto CurrentWidget = Widget.Get())
+    {
+        CurrentWidget->OnSlateReleased().Remove(ReleasedHandle);
+    }
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(GarbageCollectedHandle);
+    // Resuming may destroy the coroutine frame that holds the awaitable, so this must be the last access to it
+    Handle.resume();
+}
+
+void FBlazeWidgetPoppedAwaitable::OnPostGarbageCollect()
+{
+    if (!Widget.IsValid())
+    {
+        OnWidgetPopped();
+    }
+}
+
+#endif
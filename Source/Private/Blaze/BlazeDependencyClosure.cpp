@@ -0,0 +1,302 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeDependencyClosure.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blueprint/WidgetBlueprintGeneratedClass.h"
+#include "Engine/Font.h"
+#include "Engine/FontFace.h"
+#include "Engine/Texture.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/PackageName.h"
+#include "Tasks/Task.h"
+
+static TAutoConsoleVariable<int32>
+    CVarBlazePreloadSoftReferenceDepth(TEXT("Blaze.Preload.SoftReferenceDepth"),
+                                       1,
+                                       TEXT("The number of soft references that are followed when computing the "
+                                            "assets loaded alongside a widget class that is loaded asynchronously. "
+                                            "0 disables dependency preloading so only the widget class and its "
+                                            "hard references are loaded."),
+                                       ECVF_Default);
+
+// The state below is only accessed from the game thread
+
+/** The cached closures, keyed by the requested path. */
+static TMap<FSoftObjectPath, TArray<FSoftObjectPath>> Closures;
+
+/** The callbacks waiting on a closure that is being computed, keyed by the requested path. */
+static TMap<FSoftObjectPath, TArray<TUniqueFunction<void(const TArray<FSoftObjectPath>&)>>> PendingCallbacks;
+
+/** The soft reference depth that the cached closures were computed with. */
+static int32 ClosuresSoftReferenceDepth{ INDEX_NONE };
+
+/** Incremented whenever the cache is reset so that a closure computed from stale asset data is not cached. */
+static uint32 CacheGeneration{ 0 };
+
+/** The classes of the assets that are preloaded when softly referenced, computed on first use. */
+static TSet<FTopLevelAssetPath> PreloadClasses;
+
+static FDelegateHandle AssetAddedHandle;
+static FDelegateHandle AssetRemovedHandle;
+static FDelegateHandle AssetRenamedHandle;
+static FDelegateHandle AssetUpdatedHandle;
+
+static bool IsPreloadablePackage(const FName PackageName)
+{
+    TStringBuilder<256> Builder;
+    PackageName.ToString(Builder);
+    return !FPackageName::IsScriptPackage(Builder.ToView()) && !FPackageName::IsMemoryPackage(Builder.ToView());
+}
+
+static void OnAssetChanged(const FAssetData&)
+{
+    FBlazeDependencyClosure::ResetCache();
+}
+
+static void OnAssetRenamed(const FAssetData&, const FString&)
+{
+    FBlazeDependencyClosure::ResetCache();
+}
+
+void FBlazeDependencyClosure::Startup()
+{
+    if (const auto AssetRegistry = IAssetRegistry::Get())
+    {
+        // Editing, saving or mounting assets can change the references that the cached closures were computed from
+        AssetAddedHandle = AssetRegistry->OnAssetAdded().AddStatic(&OnAssetChanged);
+        AssetRemovedHandle = AssetRegistry->OnAssetRemoved().AddStatic(&OnAssetChanged);
+        AssetRenamedHandle = AssetRegistry->OnAssetRenamed().AddStatic(&OnAssetRenamed);
+        AssetUpdatedHandle = AssetRegistry->OnAssetUpdated().AddStatic(&OnAssetChanged);
+    }
+}
+
+void FBlazeDependencyClosure::Shutdown()
+{
+    if (const auto AssetRegistry = IAssetRegistry::Get())
+    {
+        AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+        AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+    }
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetRenamedHandle.Reset();
+    AssetUpdatedHandle.Reset();
+    ResetCache();
+}
+
+TSet<FTopLevelAssetPath> FBlazeDependencyClosure::GetPreloadClasses()
+{
+    const TArray<FTopLevelAssetPath> BaseClasses({
+        UTexture::StaticClass()->GetClassPathName(),
+        UFont::StaticClass()->GetClassPathName(),
+        UFontFace::StaticClass()->GetClassPathName(),
+        UMaterialInterface::StaticClass()->GetClassPathName(),
+        UWidgetBlueprintGeneratedClass::StaticClass()->GetClassPathName(),
+        // A widget blueprint is only an asset in the editor, where its generated class is loaded alongside it
+        FTopLevelAssetPath(TEXT("/Script/UMGEditor"), TEXT("WidgetBlueprint")),
+    });
+
+    TSet<FTopLevelAssetPath> Classes;
+    if (const auto AssetRegistry = IAssetRegistry::Get())
+    {
+        AssetRegistry->GetDerivedClassNames(BaseClasses, TSet<FTopLevelAssetPath>(), Classes);
+    }
+    Classes.Append(BaseClasses);
+    return Classes;
+}
+
+TArray<FSoftObjectPath>
+FBlazeDependencyClosure::ComputeClosure(const FSoftObjectPath& Path,
+                                        const int32 MaxSoftReferenceDepth,
+                                        const TSet<FTopLevelAssetPath>& InPreloadClasses,
+                                        const TFunctionRef<void(FName, TArray<FAssetDependency>&)> GetDependencies,
+                                        const TFunctionRef<void(FName, TArray<FAssetData>&)> GetAssets)
+{
+    TArray<FSoftObjectPath> Paths;
+    Paths.Add(Path);
+
+    // The minimum number of soft references traversed to reach each package
+    TMap<FName, int32> Visited;
+    TArray<TPair<FName, int32>> Queue;
+
+    const auto RootPackageName = Path.GetLongPackageFName();
+    Visited.Add(RootPackageName, 0);
+    Queue.Emplace(RootPackageName, 0);
+
+    TArray<FAssetDependency> Dependencies;
+    TArray<FAssetData> Assets;
+    for (auto i = 0; i < Queue.Num(); ++i)
+    {
+        const auto PackageName = Queue[i].Key;
+        const auto Depth = Queue[i].Value;
+
+        Dependencies.Reset();
+        GetDependencies(PackageName, Dependencies);
+        for (const auto& Dependency : Dependencies)
+        {
+            const auto DependencyName = Dependency.AssetId.PackageName;
+            const auto bHard = EnumHasAnyFlags(Dependency.Properties, UE::AssetRegistry::EDependencyProperty::Hard);
+            const auto DependencyDepth = bHard ? Depth : Depth + 1;
+            const auto ExistingDepth = Visited.Find(DependencyName);
+            // Revisit a package reached via fewer soft references, as more of its references are in range
+            if (!DependencyName.IsNone() && DependencyDepth <= MaxSoftReferenceDepth
+                && (!ExistingDepth || *ExistingDepth > DependencyDepth) && IsPreloadablePackage(DependencyName))
+            {
+                auto bFollow{ bHard };
+                if (!bHard)
+                {
+                    // A softly referenced package is not loaded with its referencer, so it is only preloaded if it
+                    // holds an asset that a widget displays rather than, say, a level that the widget travels to
+                    Assets.Reset();
+                    GetAssets(DependencyName, Assets);
+                    for (const auto& Asset : Assets)
+                    {
+                        if (InPreloadClasses.Contains(Asset.AssetClassPath))
+                        {
+                            if (!ExistingDepth && DependencyName != RootPackageName)
+                            {
+                                Paths.Add(Asset.ToSoftObjectPath());
+                            }
+                            bFollow = true;
+                        }
+                    }
+                }
+                if (bFollow)
+                {
+                    Visited.Add(DependencyName, DependencyDepth);
+                    Queue.Emplace(DependencyName, DependencyDepth);
+                }
+            }
+        }
+    }
+    return Paths;
+}
+
+static bool CanCacheClosures()
+{
+    // The closure of an asset is incomplete while the asset registry is still discovering assets
+    const auto AssetRegistry = IAssetRegistry::Get();
+    return AssetRegistry && !AssetRegistry->IsLoadingAssets();
+}
+
+// Invoked on a worker thread. The asset registry query interface is thread-safe and only on-disk
+// asset data is requested so no UObject is accessed.
+static TArray<FSoftObjectPath> ComputeClosureFromAssetRegistry(const FSoftObjectPath& Path,
+                                                               const int32 Depth,
+                                                               const TSet<FTopLevelAssetPath>& Classes)
+{
+    if (const auto AssetRegistry = IAssetRegistry::Get())
+    {
+        return FBlazeDependencyClosure::ComputeClosure(
+            Path,
+            Depth,
+            Classes,
+            [AssetRegistry](const FName PackageName, TArray<FAssetDependency>& OutDependencies) {
+                AssetRegistry->GetDependencies(PackageName,
+                                               OutDependencies,
+                                               UE::AssetRegistry::EDependencyCategory::Package);
+            },
+            [AssetRegistry](const FName PackageName, TArray<FAssetData>& OutAssets) {
+                AssetRegistry->GetAssetsByPackageName(PackageName, OutAssets, true);
+            });
+    }
+    else
+    {
+        return TArray{ Path };
+    }
+}
+
+static void OnClosureComputed(const FSoftObjectPath& Path,
+                              const int32 Depth,
+                              const uint32 Generation,
+                              const TArray<FSoftObjectPath>& Paths)
+{
+    check(IsInGameThread());
+    UE_LOGFMT(LogBlaze,
+              Verbose,
+              "Computed the dependency closure of [{Path}] with SoftReferenceDepth={Depth} "
+              "containing {Count} additional asset(s)",
+              Path.ToString(),
+              Depth,
+              Paths.Num() - 1);
+
+    if (Depth == ClosuresSoftReferenceDepth && Generation == CacheGeneration && CanCacheClosures())
+    {
+        Closures.Add(Path, Paths);
+    }
+
+    TArray<TUniqueFunction<void(const TArray<FSoftObjectPath>&)>> Callbacks;
+    PendingCallbacks.RemoveAndCopyValue(Path, Callbacks);
+    for (auto& Callback : Callbacks)
+    {
+        Callback(Paths);
+    }
+}
+
+void FBlazeDependencyClosure::Request(const FSoftObjectPath& Path,
+                                      TUniqueFunction<void(const TArray<FSoftObjectPath>&)>&& OnComplete)
+{
+    check(IsInGameThread());
+    const auto Depth = CVarBlazePreloadSoftReferenceDepth.GetValueOnGameThread();
+    if (Path.IsNull() || Depth <= 0)
+    {
+        OnComplete(TArray{ Path });
+    }
+    else
+    {
+        if (Depth != ClosuresSoftReferenceDepth)
+        {
+            ResetCache();
+            ClosuresSoftReferenceDepth = Depth;
+        }
+
+        if (const auto Closure = Closures.Find(Path))
+        {
+            OnComplete(*Closure);
+        }
+        else if (const auto Callbacks = PendingCallbacks.Find(Path))
+        {
+            // The closure is already being computed
+            Callbacks->Add(MoveTemp(OnComplete));
+        }
+        else
+        {
+            if (PreloadClasses.IsEmpty())
+            {
+                PreloadClasses = GetPreloadClasses();
+            }
+            PendingCallbacks.Add(Path).Add(MoveTemp(OnComplete));
+            const auto Generation = CacheGeneration;
+            UE::Tasks::Launch(UE_SOURCE_LOCATION, [Path, Depth, Generation, Classes = PreloadClasses] {
+                auto Paths = ComputeClosureFromAssetRegistry(Path, Depth, Classes);
+                AsyncTask(ENamedThreads::GameThread, [Path, Depth, Generation, Paths = MoveTemp(Paths)] {
+                    OnClosureComputed(Path, Depth, Generation, Paths);
+                });
+            });
+        }
+    }
+}
+
+void FBlazeDependencyClosure::ResetCache()
+{
+    check(IsInGameThread());
+    Closures.Reset();
+    PreloadClasses.Reset();
+    CacheGeneration++;
+}
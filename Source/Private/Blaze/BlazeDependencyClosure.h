@@ -0,0 +1,80 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Templates/Function.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/TopLevelAssetPath.h"
+
+struct FAssetData;
+struct FAssetDependency;
+
+/**
+ * Computes the assets that an asset references, so that an async load of a widget class can also cover the
+ * textures, fonts, materials and nested soft widget classes that would otherwise load on first paint or first
+ * interaction.
+ *
+ * The closure is computed from the asset registry on a worker thread and cached per asset until the asset registry
+ * reports an asset change. Hard references are followed without limit, as they are loaded alongside their
+ * referencer, while soft references are followed up to the depth specified by the
+ * "Blaze.Preload.SoftReferenceDepth" console variable. Soft references to any other kind of asset, such as a level
+ * that a menu can travel to, are not followed.
+ */
+class FBlazeDependencyClosure final
+{
+public:
+    static void Startup();
+
+    static void Shutdown();
+
+    /**
+     * Invoke the callback with the paths to load so that the asset and the assets it references are resident.
+     *
+     * The first path is always the requested path. The callback is always invoked on the game thread; immediately
+     * if the closure is cached or closure preloading is disabled, otherwise once the closure has been computed.
+     *
+     * @param Path The path of the asset.
+     * @param OnComplete The callback invoked with the paths to load.
+     */
+    static void Request(const FSoftObjectPath& Path,
+                        TUniqueFunction<void(const TArray<FSoftObjectPath>&)>&& OnComplete);
+
+    /** Discard every cached closure. */
+    static void ResetCache();
+
+    /**
+     * Return the classes of the assets that are preloaded when softly referenced.
+     * These are the texture, font, material and widget blueprint classes and the classes derived from them.
+     */
+    static TSet<FTopLevelAssetPath> GetPreloadClasses();
+
+    /**
+     * Compute the closure of the asset from the dependencies and assets reported by the queries.
+     *
+     * This is invoked on a worker thread with queries that read the asset registry, so it must not access UObjects.
+     *
+     * @param Path The path of the asset.
+     * @param MaxSoftReferenceDepth The number of soft references that are followed.
+     * @param PreloadClasses The classes of the assets that are preloaded when softly referenced.
+     * @param GetDependencies The query that returns the package dependencies of a package.
+     * @param GetAssets The query that returns the assets in a package.
+     * @return The path of the asset followed by the paths of the softly referenced assets to load.
+     */
+    static TArray<FSoftObjectPath>
+    ComputeClosure(const FSoftObjectPath& Path,
+                   int32 MaxSoftReferenceDepth,
+                   const TSet<FTopLevelAssetPath>& PreloadClasses,
+                   TFunctionRef<void(FName, TArray<FAssetDependency>&)> GetDependencies,
+                   TFunctionRef<void(FName, TArray<FAssetData>&)> GetAssets);
+};
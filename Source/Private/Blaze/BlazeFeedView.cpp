@@ -0,0 +1,182 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeFeedView.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/VerticalBox.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BlazeFeedView)
+
+void UBlazeFeedView::BeginDestroy()
+{
+    if (RefreshTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(RefreshTickerHandle);
+        RefreshTickerHandle.Reset();
+    }
+    Super::BeginDestroy();
+}
+
+void UBlazeFeedView::NativeOnInitialized()
+{
+    Super::NativeOnInitialized();
+    if (!EntryPanel && WidgetTree && !WidgetTree->RootWidget)
+    {
+        const auto VerticalBox = WidgetTree->ConstructWidget<UVerticalBox>();
+        WidgetTree->RootWidget = VerticalBox;
+        EntryPanel = VerticalBox;
+    }
+    else if (!EntryPanel)
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "Feed [{Feed}] will not display entries as the widget tree has a root but does not bind "
+                  "EntryPanel. World=[{WorldName}]",
+                  GetName(),
+                  GetNameSafe(GetWorld()));
+    }
+}
+
+void UBlazeFeedView::PushEntry(FInstancedStruct&& Payload)
+{
+    const auto Capacity = FMath::Max(1, MaxEntries);
+    if (Entries.Num() < Capacity)
+    {
+        Entries.Add(MoveTemp(Payload));
+    }
+    else
+    {
+        // The slot of the oldest entry is reused so the buffer never grows or shifts
+        Entries[static_cast<int32>(NumPushed % Capacity)] = MoveTemp(Payload);
+    }
+    NumPushed++;
+
+    if (ScrollOffset > 0)
+    {
+        // Keep the window on the entries the player scrolled to
+        ScrollOffset = FMath::Min(ScrollOffset + 1, FMath::Max(0, Entries.Num() - NumVisibleEntries));
+    }
+    MarkEntriesDirty();
+}
+
+void UBlazeFeedView::ClearEntries()
+{
+    Entries.Reset();
+    NumPushed = 0;
+    ScrollOffset = 0;
+    // Sequences restart from zero so the entries displayed before the clear must not be mistaken for new entries
+    DisplayedSequences.Init(INDEX_NONE, DisplayedSequences.Num());
+    MarkEntriesDirty();
+}
+
+void UBlazeFeedView::ScrollBy(const int32 Delta)
+{
+    const auto MaxScrollOffset = FMath::Max(0, Entries.Num() - NumVisibleEntries);
+    const auto NewScrollOffset = FMath::Clamp(ScrollOffset + Delta, 0, MaxScrollOffset);
+    if (NewScrollOffset != ScrollOffset)
+    {
+        ScrollOffset = NewScrollOffset;
+        MarkEntriesDirty();
+    }
+}
+
+void UBlazeFeedView::ScrollToLatest()
+{
+    ScrollBy(-ScrollOffset);
+}
+
+int32 UBlazeFeedView::GetNumEntries() const
+{
+    return Entries.Num();
+}
+
+void UBlazeFeedView::MarkEntriesDirty()
+{
+    if (!RefreshTickerHandle.IsValid())
+    {
+        RefreshTickerHandle =
+            FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](const float) {
+                // The ticker is removed by returning false so only the handle needs to be discarded
+                RefreshTickerHandle.Reset();
+                RefreshEntries();
+                return false;
+            }));
+    }
+}
+
+int32 UBlazeFeedView::ReleaseUnusedEntryWidgets()
+{
+    // Entry widgets that are not displaying an entry are always at the end of the list
+    const auto NumUsed = IsVisible() ? FMath::Min(FMath::Max(1, NumVisibleEntries), Entries.Num()) : 0;
+    const auto NumReleased = FMath::Max(0, EntryWidgets.Num() - NumUsed);
+    if (NumReleased > 0)
+    {
+        for (int32 Index = NumUsed; Index < EntryWidgets.Num(); Index++)
+        {
+            EntryWidgets[Index]->RemoveFromParent();
+        }
+        EntryWidgets.SetNum(NumUsed);
+        DisplayedSequences.SetNum(NumUsed);
+    }
+    return NumReleased;
+}
+
+void UBlazeFeedView::RefreshEntries()
+{
+    if (RefreshTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(RefreshTickerHandle);
+        RefreshTickerHandle.Reset();
+    }
+
+    if (EntryPanel && EntryWidgetClass)
+    {
+        const auto Capacity = FMath::Max(1, MaxEntries);
+        const auto NumVisible = FMath::Min(FMath::Max(1, NumVisibleEntries), Entries.Num());
+        const auto FirstSequence = NumPushed - ScrollOffset - NumVisible;
+
+        // Entry widgets are only created until there are enough to fill the window, after which they are recycled
+        while (EntryWidgets.Num() < NumVisible)
+        {
+            const auto EntryWidget = CreateWidget<UUserWidget>(this, EntryWidgetClass);
+            EntryPanel->AddChild(EntryWidget);
+            EntryWidgets.Add(EntryWidget);
+            DisplayedSequences.Add(INDEX_NONE);
+        }
+
+        for (int32 Index = 0; Index < EntryWidgets.Num(); Index++)
+        {
+            const auto EntryWidget = EntryWidgets[Index];
+            if (Index < NumVisible)
+            {
+                const auto Sequence = FirstSequence + Index;
+                if (Sequence != DisplayedSequences[Index])
+                {
+                    if (const auto Receiver = Cast<IBlazePayloadReceiver>(EntryWidget))
+                    {
+                        // The feed retains the entry so the widget receives a copy
+                        Receiver->ReceivePayload(FInstancedStruct(Entries[static_cast<int32>(Sequence % Capacity)]));
+                    }
+                    DisplayedSequences[Index] = Sequence;
+                }
+                EntryWidget->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+            }
+            else
+            {
+                EntryWidget->SetVisibility(ESlateVisibility::Collapsed);
+                DisplayedSequences[Index] = INDEX_NONE;
+            }
+        }
+    }
+}
@@ -30,6 +30,10 @@
 // See SuspendInputForPlayer
 static int32 InputSuspensions{ 0 };
 
+// The suspend tokens that have not yet been resumed and the player whose input they suspend.
+// This variable is not synchronized as it is only accessed from the GameThread.
+static TMap<FName, TWeakObjectPtr<const ULocalPlayer>> ActiveInputSuspensions;
+
 static ULocalPlayer* GetLocalPlayerFromController(const APlayerController* PlayerController)
 {
     return PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
@@ -39,6 +43,28 @@ UCommonActivatableWidget*
 UBlazeFunctionLibrary::PushContentToLayer(const ULocalPlayer* LocalPlayer,
                                           const FGameplayTag LayerName,
                                           const TSubclassOf<UCommonActivatableWidget> WidgetClass)
+{
+    return PushContentToLayerWithPayload(LocalPlayer, LayerName, WidgetClass, FInstancedStruct());
+}
+
+UCommonActivatableWidget*
+UBlazeFunctionLibrary::PushContentToLayerWithPayload(APlayerController* PlayerController,
+                                                     const FGameplayTag LayerName,
+                                                     const TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                                     const FInstancedStruct& Payload)
+{
+    // Blueprint supplies the payload by reference so a copy is moved into the widget
+    return PushContentToLayerWithPayload(GetLocalPlayerFromController(PlayerController),
+                                         LayerName,
+                                         WidgetClass,
+                                         FInstancedStruct(Payload));
+}
+
+UCommonActivatableWidget*
+UBlazeFunctionLibrary::PushContentToLayerWithPayload(const ULocalPlayer* LocalPlayer,
+                                                     const FGameplayTag LayerName,
+                                                     const TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                                     FInstancedStruct&& Payload)
 {
     const auto ResolvedWidgetClass = WidgetClass.Get();
     if (!LocalPlayer || !ResolvedWidgetClass || !LayerName.IsValid())
@@ -54,7 +80,7 @@ UBlazeFunctionLibrary::PushContentToLayer(const ULocalPlayer* LocalPlayer,
                   GetNameSafe(LocalPlayer ? LocalPlayer->GetWorld() : nullptr));
         return nullptr;
     }
-    else if (const auto Layout = GetPrimaryLayout(LocalPlayer))
+    else if (const auto Layout = GetLayoutForLayer(LocalPlayer, LayerName))
     {
         UE_LOGFMT(LogBlaze,
                   Log,
@@ -68,7 +94,12 @@ UBlazeFunctionLibrary::PushContentToLayer(const ULocalPlayer* LocalPlayer,
                   GetNameSafe(ResolvedWidgetClass),
                   GetNameSafe(LocalPlayer ? LocalPlayer->GetWorld() : nullptr));
 
-        return Layout->PushWidgetToLayer(LayerName, ResolvedWidgetClass);
+        const auto Manager = GetPrimaryLayoutManager(LocalPlayer->GetGameInstance());
+        return Layout->PushWidgetToLayerWithPayload(
+            LayerName,
+            ResolvedWidgetClass,
+            MoveTemp(Payload),
+            [Manager, LocalPlayer](auto& Widget) { Manager->AssignSharedWidgetOwner(Widget, LocalPlayer); });
     }
     else
     {
@@ -87,6 +118,105 @@ UBlazeFunctionLibrary::PushContentToLayer(const ULocalPlayer* LocalPlayer,
     }
 }
 
+bool UBlazeFunctionLibrary::EnqueueContentToLayer(APlayerController* PlayerController,
+                                                  const FGameplayTag LayerName,
+                                                  const TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                                  const FInstancedStruct& Payload,
+                                                  const int32 Priority,
+                                                  const FName MergeKey)
+{
+    // Blueprint supplies the payload by reference so a copy is moved into the queue
+    return EnqueueContentToLayer(GetLocalPlayerFromController(PlayerController),
+                                 LayerName,
+                                 WidgetClass,
+                                 FInstancedStruct(Payload),
+                                 Priority,
+                                 MergeKey);
+}
+
+bool UBlazeFunctionLibrary::EnqueueContentToLayer(const ULocalPlayer* LocalPlayer,
+                                                  const FGameplayTag LayerName,
+                                                  const TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                                  FInstancedStruct&& Payload,
+                                                  const int32 Priority,
+                                                  const FName MergeKey)
+{
+    if (!LocalPlayer || !WidgetClass || !LayerName.IsValid())
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "EnqueueContentToLayer"
+                  "(LocalPlayer=[{LocalPlayer}] LayerName=[{LayerName}] WidgetClass=[{WidgetClass}]) "
+                  "failed due to invalid parameters. World=[{WorldName}]",
+                  GetNameSafe(LocalPlayer),
+                  LayerName.GetTagName(),
+                  GetNameSafe(WidgetClass),
+                  GetNameSafe(LocalPlayer ? LocalPlayer->GetWorld() : nullptr));
+        return false;
+    }
+    else if (const auto Layout = GetLayoutForLayer(LocalPlayer, LayerName))
+    {
+        UE_LOGFMT(LogBlaze,
+                  Verbose,
+                  "EnqueueContentToLayer"
+                  "(LocalPlayer=[{LocalPlayer}](ControllerId={ControllerId}) "
+                  "LayerName=[{LayerName}] WidgetClass=[{WidgetClass}] Priority={Priority} MergeKey=[{MergeKey}]). "
+                  "World=[{WorldName}]",
+                  GetNameSafe(LocalPlayer),
+                  LocalPlayer->GetControllerId(),
+                  LayerName.GetTagName(),
+                  GetNameSafe(WidgetClass),
+                  Priority,
+                  MergeKey,
+                  GetNameSafe(LocalPlayer->GetWorld()));
+        return Layout->EnqueueWidgetToLayer(LayerName, WidgetClass, MoveTemp(Payload), Priority, MergeKey);
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "EnqueueContentToLayer"
+                  "(LocalPlayer=[{LocalPlayer}](ControllerId={ControllerId}) "
+                  "LayerName=[{LayerName}] WidgetClass=[{WidgetClass}]) "
+                  "failed as LocalPlayer has no PrimaryLayout. World=[{WorldName}]",
+                  GetNameSafe(LocalPlayer),
+                  LocalPlayer->GetControllerId(),
+                  LayerName.GetTagName(),
+                  GetNameSafe(WidgetClass),
+                  GetNameSafe(LocalPlayer->GetWorld()));
+        return false;
+    }
+}
+
+bool UBlazeFunctionLibrary::PushEntryToFeed(APlayerController* PlayerController,
+                                            const FGameplayTag LayerName,
+                                            const FInstancedStruct& Payload)
+{
+    // Blueprint supplies the payload by reference so a copy is moved into the feed
+    return PushEntryToFeed(GetLocalPlayerFromController(PlayerController), LayerName, FInstancedStruct(Payload));
+}
+
+bool UBlazeFunctionLibrary::PushEntryToFeed(const ULocalPlayer* LocalPlayer,
+                                            const FGameplayTag LayerName,
+                                            FInstancedStruct&& Payload)
+{
+    if (const auto Layout = LocalPlayer && LayerName.IsValid() ? GetLayoutForLayer(LocalPlayer, LayerName) : nullptr)
+    {
+        return Layout->PushEntryToFeed(LayerName, MoveTemp(Payload));
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "PushEntryToFeed(LocalPlayer=[{LocalPlayer}] LayerName=[{LayerName}]) "
+                  "failed due to invalid parameters or as LocalPlayer has no PrimaryLayout. World=[{WorldName}]",
+                  GetNameSafe(LocalPlayer),
+                  LayerName.GetTagName(),
+                  GetNameSafe(LocalPlayer ? LocalPlayer->GetWorld() : nullptr));
+        return false;
+    }
+}
+
 UBlazePrimaryLayoutManager* UBlazeFunctionLibrary::GetPrimaryLayoutManager(const UObject* WorldContextObject)
 {
     if (const auto World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
@@ -111,6 +241,14 @@ UBlazePrimaryLayout* UBlazeFunctionLibrary::GetPrimaryLayout(const APlayerContro
     return PlayerController ? GetPrimaryLayout(Cast<ULocalPlayer>(PlayerController->Player)) : nullptr;
 }
 
+UBlazePrimaryLayout* UBlazeFunctionLibrary::GetLayoutForLayer(const ULocalPlayer* LocalPlayer,
+                                                              const FGameplayTag LayerName)
+{
+    const auto GameInstance = LocalPlayer ? LocalPlayer->GetGameInstance() : nullptr;
+    const auto Manager = GameInstance ? GetPrimaryLayoutManager(GameInstance) : nullptr;
+    return Manager ? Manager->GetLayoutForLayer(LocalPlayer, LayerName) : nullptr;
+}
+
 UBlazePrimaryLayout* UBlazeFunctionLibrary::GetPrimaryLayout(const ULocalPlayer* LocalPlayer)
 {
     const auto GameInstance = LocalPlayer ? LocalPlayer->GetGameInstance() : nullptr;
@@ -118,6 +256,17 @@ UBlazePrimaryLayout* UBlazeFunctionLibrary::GetPrimaryLayout(const ULocalPlayer*
     return Manager ? Manager->GetPrimaryLayout(LocalPlayer) : nullptr;
 }
 
+UBlazeViewModelStore* UBlazeFunctionLibrary::GetViewModelStore(const APlayerController* PlayerController)
+{
+    return PlayerController ? GetViewModelStore(Cast<ULocalPlayer>(PlayerController->Player)) : nullptr;
+}
+
+UBlazeViewModelStore* UBlazeFunctionLibrary::GetViewModelStore(const ULocalPlayer* LocalPlayer)
+{
+    const auto Layout = GetPrimaryLayout(LocalPlayer);
+    return Layout ? Layout->GetViewModelStore() : nullptr;
+}
+
 UCommonActivatableWidget*
 UBlazeFunctionLibrary::PushContentToLayer(APlayerController* PlayerController,
                                           const FGameplayTag LayerName,
@@ -133,7 +282,7 @@ void UBlazeFunctionLibrary::PopContentFromLayer(const FGameplayTag LayerName,
     {
         if (const auto LocalPlayer = ActivatableWidget->GetOwningLocalPlayer())
         {
-            if (const auto Layout = GetPrimaryLayout(LocalPlayer))
+            if (const auto Layout = GetLayoutForLayer(LocalPlayer, LayerName))
             {
                 Layout->RemoveWidgetFromLayer(LayerName, ActivatableWidget);
             }
@@ -171,6 +320,78 @@ void UBlazeFunctionLibrary::PopContentFromLayer(const FGameplayTag LayerName,
     }
 }
 
+int32 UBlazeFunctionLibrary::ClearLayer(APlayerController* PlayerController, const FGameplayTag LayerName)
+{
+    return ClearLayer(GetLocalPlayerFromController(PlayerController), LayerName);
+}
+
+int32 UBlazeFunctionLibrary::ClearLayer(const ULocalPlayer* LocalPlayer, const FGameplayTag LayerName)
+{
+    if (const auto Layout = GetLayoutForLayer(LocalPlayer, LayerName))
+    {
+        return Layout->ClearLayer(LayerName);
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "ClearLayer(LocalPlayer=[{LocalPlayer}](ControllerId={ControllerId}) LayerName=[{LayerName}]) "
+                  "failed as LocalPlayer has no PrimaryLayout. World=[{WorldName}]",
+                  GetNameSafe(LocalPlayer),
+                  LocalPlayer ? LocalPlayer->GetControllerId() : -1,
+                  LayerName.GetTagName(),
+                  GetNameSafe(LocalPlayer ? LocalPlayer->GetWorld() : nullptr));
+        return 0;
+    }
+}
+
+int32 UBlazeFunctionLibrary::PopUntil(const FGameplayTag LayerName, UCommonActivatableWidget* ActivatableWidget)
+{
+    const auto LocalPlayer = ActivatableWidget ? ActivatableWidget->GetOwningLocalPlayer() : nullptr;
+    if (const auto Layout = GetLayoutForLayer(LocalPlayer, LayerName))
+    {
+        return Layout->PopUntil(LayerName, ActivatableWidget);
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "PopUntil(LayerName=[{LayerName}] ActivatableWidget=[{ActivatableWidget}]) "
+                  "failed as the widget has no OwningLocalPlayer with a PrimaryLayout. World=[{WorldName}]",
+                  LayerName.GetTagName(),
+                  GetNameSafe(ActivatableWidget),
+                  GetNameSafe(ActivatableWidget ? ActivatableWidget->GetWorld() : nullptr));
+        return 0;
+    }
+}
+
+int32 UBlazeFunctionLibrary::PopAll(APlayerController* PlayerController, const FBlazeWidgetQuery& Query)
+{
+    return PopAll(GetLocalPlayerFromController(PlayerController), Query);
+}
+
+int32 UBlazeFunctionLibrary::PopAll(const ULocalPlayer* LocalPlayer, const FBlazeWidgetQuery& Query)
+{
+    if (const auto Layout = GetPrimaryLayout(LocalPlayer))
+    {
+        // The widgets on shared layers are hosted by the shared layout rather than the player's primary layout
+        const auto Manager = GetPrimaryLayoutManager(LocalPlayer->GetGameInstance());
+        const auto NumShared = Manager ? Manager->PopAllSharedWidgets(LocalPlayer, Query) : 0;
+        return Layout->PopAll(Query) + NumShared;
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "PopAll(LocalPlayer=[{LocalPlayer}](ControllerId={ControllerId})) "
+                  "failed as LocalPlayer has no PrimaryLayout. World=[{WorldName}]",
+                  GetNameSafe(LocalPlayer),
+                  LocalPlayer ? LocalPlayer->GetControllerId() : -1,
+                  GetNameSafe(LocalPlayer ? LocalPlayer->GetWorld() : nullptr));
+        return 0;
+    }
+}
+
 FName UBlazeFunctionLibrary::SuspendInputForPlayer(const APlayerController* PlayerController,
                                                    const FName SuspendReasonBase)
 {
@@ -192,6 +413,7 @@ FName UBlazeFunctionLibrary::SuspendInputForPlayer(const ULocalPlayer* LocalPlay
         CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendToken, true);
         CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, SuspendToken, true);
         CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, SuspendToken, true);
+        ActiveInputSuspensions.Add(SuspendToken, LocalPlayer);
 
         return SuspendToken;
     }
@@ -219,6 +441,7 @@ void UBlazeFunctionLibrary::ResumeInputForPlayer(const ULocalPlayer* LocalPlayer
 {
     if (NAME_None != SuspendToken)
     {
+        ActiveInputSuspensions.Remove(SuspendToken);
         if (const auto CommonInputSubsystem = UCommonInputSubsystem::Get(LocalPlayer))
         {
             CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendToken, false);
@@ -251,3 +474,18 @@ void UBlazeFunctionLibrary::ResumeInputForPlayer(const ULocalPlayer* LocalPlayer
                   GetNameSafe(LocalPlayer ? LocalPlayer->GetWorld() : nullptr));
     }
 }
+
+bool UBlazeFunctionLibrary::IsInputSuspendedForPlayer(const ULocalPlayer* LocalPlayer)
+{
+    if (LocalPlayer)
+    {
+        for (const auto& Suspension : ActiveInputSuspensions)
+        {
+            if (Suspension.Value.Get() == LocalPlayer)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
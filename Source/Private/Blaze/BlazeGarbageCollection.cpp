@@ -0,0 +1,229 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeGarbageCollection.h"
+#include "Blaze/BlazeFeedView.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blaze/BlazePayloadReceiver.h"
+#include "Blaze/BlazePrimaryLayout.h"
+#include "Blaze/BlazeProfiling.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetBlueprintGeneratedClass.h"
+#include "Blueprint/WidgetTree.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+static TAutoConsoleVariable<bool>
+    CVarBlazeClusterWidgets(TEXT("Blaze.GC.ClusterWidgets"),
+                            true,
+                            TEXT("Whether widgets pushed onto layers that enable bClusterWidgets are placed in "
+                                 "GC clusters. Clusters are also only created when gc.CreateGCClusters is enabled."),
+                            ECVF_Default);
+
+static TAutoConsoleVariable<bool>
+    CVarBlazeLogObjectCounts(TEXT("Blaze.GC.LogObjectCounts"),
+                             false,
+                             TEXT("Whether the number of Blaze owned objects is logged after each garbage collection."),
+                             ECVF_Default);
+
+static FAutoConsoleCommandWithOutputDevice
+    BlazeGCReportCommand(TEXT("Blaze.GC.Report"),
+                         TEXT("Print the number of objects owned by each Blaze primary layout and how many of "
+                              "them the garbage collector traverses."),
+                         FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FBlazeGarbageCollection::Report));
+
+static FDelegateHandle PostGarbageCollectHandle;
+
+static bool IsClusteringEnabled()
+{
+    static const auto CVarCreateGCClusters = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.CreateGCClusters"));
+    return CVarBlazeClusterWidgets.GetValueOnGameThread() && CVarCreateGCClusters && CVarCreateGCClusters->GetBool();
+}
+
+static void AddObjectCounts(const UObject& Object, FBlazeGCObjectCounts& Counts)
+{
+    const auto Item = GUObjectArray.ObjectToObjectItem(&Object);
+    Counts.Objects++;
+    if (Item->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+    {
+        Counts.Clusters++;
+    }
+    else if (Item->GetOwnerIndex() > 0)
+    {
+        // A positive owner index identifies the root of the cluster that the object belongs to
+        Counts.ClusteredObjects++;
+    }
+}
+
+/** Return true if objects may be added to the tree of the widget after it has been pushed. */
+static bool IsMutableWidgetTree(const UUserWidget& Widget, const UWidgetTree& WidgetTree)
+{
+    // A payload receiver may assign the objects carried by each payload, and a feed view adds entry widgets
+    if (Cast<IBlazePayloadReceiver>(&Widget))
+    {
+        return true;
+    }
+    else
+    {
+        auto bHostsFeed{ false };
+        ForEachObjectWithOuterBreakable(
+            &WidgetTree,
+            [&bHostsFeed](const UObject* Object) {
+                bHostsFeed = Object->IsA<UBlazeFeedView>();
+                return !bHostsFeed;
+            },
+            true);
+        return bHostsFeed;
+    }
+}
+
+/** Return true if the widget tree is instanced from a widget blueprint that has not been cooked. */
+static bool IsUncookedWidgetTree(const UUserWidget& Widget)
+{
+    // The editor reinstances the widgets of a recompiled blueprint, which replaces objects within the cluster
+    const auto WidgetClass = Cast<UWidgetBlueprintGeneratedClass>(Widget.GetClass());
+    return WidgetClass && !WidgetClass->GetPackage()->HasAnyPackageFlags(PKG_Cooked);
+}
+
+template <typename FunctorType>
+static void ForEachPrimaryLayout(FunctorType&& Functor)
+{
+    ForEachObjectOfClass(
+        UBlazePrimaryLayout::StaticClass(),
+        [&Functor](UObject* Object) { Functor(*CastChecked<UBlazePrimaryLayout>(Object)); },
+        true,
+        RF_ClassDefaultObject | RF_ArchetypeObject);
+}
+
+static void OnPostGarbageCollect()
+{
+    auto bRecordCsvStats{ false };
+#if CSV_PROFILER
+    bRecordCsvStats = FCsvProfiler::Get()->IsCapturing();
+#endif
+    const auto bLog = CVarBlazeLogObjectCounts.GetValueOnGameThread();
+
+    // Counting visits every object owned by a layout so it is skipped when nothing consumes the result
+    if (bRecordCsvStats || bLog)
+    {
+        auto NumLayouts{ 0 };
+        FBlazeGCObjectCounts Counts;
+        ForEachPrimaryLayout([&Counts, &NumLayouts](const UBlazePrimaryLayout& Layout) {
+            Counts += FBlazeGarbageCollection::CountObjects(Layout);
+            NumLayouts++;
+        });
+
+        const auto TraversedObjects = Counts.GetTraversedObjects();
+        CSV_CUSTOM_STAT(Blaze, GCObjects, Counts.Objects, ECsvCustomStatOp::Set);
+        CSV_CUSTOM_STAT(Blaze, GCTraversedObjects, TraversedObjects, ECsvCustomStatOp::Set);
+
+        if (bLog)
+        {
+            UE_LOGFMT(LogBlaze,
+                      Log,
+                      "Garbage collection traversed {Traversed} of {Objects} object(s) owned by {Layouts} Blaze "
+                      "layout(s). {Clustered} object(s) are in {Clusters} cluster(s).",
+                      TraversedObjects,
+                      Counts.Objects,
+                      NumLayouts,
+                      Counts.ClusteredObjects,
+                      Counts.Clusters);
+        }
+    }
+}
+
+FBlazeGCObjectCounts& FBlazeGCObjectCounts::operator+=(const FBlazeGCObjectCounts& Other)
+{
+    Objects += Other.Objects;
+    ClusteredObjects += Other.ClusteredObjects;
+    Clusters += Other.Clusters;
+    return *this;
+}
+
+void FBlazeGarbageCollection::Startup()
+{
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&OnPostGarbageCollect);
+}
+
+void FBlazeGarbageCollection::Shutdown()
+{
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+    PostGarbageCollectHandle.Reset();
+}
+
+void FBlazeGarbageCollection::ClusterWidget(UUserWidget& Widget)
+{
+    check(IsInGameThread());
+    const auto WidgetTree = Widget.WidgetTree.Get();
+    if (WidgetTree && IsClusteringEnabled())
+    {
+        const auto Item = GUObjectArray.ObjectToObjectItem(WidgetTree);
+        if (IsMutableWidgetTree(Widget, *WidgetTree) || IsUncookedWidgetTree(Widget))
+        {
+            UE_LOGFMT(LogBlaze,
+                      Verbose,
+                      "Widget [{Widget}] was not placed in a GC cluster as its widget tree may change or is not "
+                      "from a cooked asset. World=[{WorldName}]",
+                      Widget.GetName(),
+                      GetNameSafe(Widget.GetWorld()));
+        }
+        // The widget may have been pushed before and be reused from the pool of its container
+        else if (0 == Item->GetOwnerIndex() && !Item->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+        {
+            // The widget tree rather than the widget is the root so that properties assigned to the
+            // widget itself after it has been pushed are still scanned by the garbage collector
+            WidgetTree->CreateCluster();
+
+            UE_LOGFMT(LogBlaze,
+                      Verbose,
+                      "Widget [{Widget}] {Result} a GC cluster for its widget tree. World=[{WorldName}]",
+                      Widget.GetName(),
+                      Item->HasAnyFlags(EInternalObjectFlags::ClusterRoot) ? TEXT("created") : TEXT("did not create"),
+                      GetNameSafe(Widget.GetWorld()));
+        }
+    }
+}
+
+FBlazeGCObjectCounts FBlazeGarbageCollection::CountObjects(const UObject& Root)
+{
+    FBlazeGCObjectCounts Counts;
+    AddObjectCounts(Root, Counts);
+    ForEachObjectWithOuter(
+        &Root,
+        [&Counts](const UObject* Object) { AddObjectCounts(*Object, Counts); },
+        true);
+    return Counts;
+}
+
+void FBlazeGarbageCollection::Report(FOutputDevice& Ar)
+{
+    check(IsInGameThread());
+    FBlazeGCObjectCounts Total;
+    ForEachPrimaryLayout([&Ar, &Total](const UBlazePrimaryLayout& Layout) {
+        const auto Counts = CountObjects(Layout);
+        Ar.Logf(TEXT("  Layout=[%s] Player=[%s] Objects=%d Traversed=%d Clustered=%d Clusters=%d"),
+                *Layout.GetName(),
+                *GetNameSafe(Layout.GetOwningLocalPlayer()),
+                Counts.Objects,
+                Counts.GetTraversedObjects(),
+                Counts.ClusteredObjects,
+                Counts.Clusters);
+        Total += Counts;
+    });
+    Ar.Logf(TEXT("Blaze layouts own %d object(s). The garbage collector traverses %d of them."),
+            Total.Objects,
+            Total.GetTraversedObjects());
+}
@@ -0,0 +1,65 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOutputDevice;
+class UUserWidget;
+
+/** The number of objects owned by a Blaze layout and how the garbage collector sees them. */
+struct FBlazeGCObjectCounts
+{
+    /** The number of objects, including the layout itself. */
+    int32 Objects{ 0 };
+
+    /** The number of objects that belong to a GC cluster and are not cluster roots. */
+    int32 ClusteredObjects{ 0 };
+
+    /** The number of objects that are the root of a GC cluster. */
+    int32 Clusters{ 0 };
+
+    /** Return the number of objects that a reachability pass visits individually. */
+    int32 GetTraversedObjects() const { return Objects - ClusteredObjects; }
+
+    FBlazeGCObjectCounts& operator+=(const FBlazeGCObjectCounts& Other);
+};
+
+/**
+ * Reduces and reports the cost of Blaze owned objects to the garbage collector.
+ *
+ * After each garbage collection the objects owned by every primary layout are counted and recorded into the
+ * CSV profiler as "GCObjects" and "GCTraversedObjects". They are also logged when "Blaze.GC.LogObjectCounts" is
+ * enabled and can be printed via the "Blaze.GC.Report" console command.
+ */
+class FBlazeGarbageCollection final
+{
+public:
+    static void Startup();
+
+    static void Shutdown();
+
+    /**
+     * Place the widget tree of the widget in a GC cluster, if it is not already in one and clustering is enabled.
+     * Widgets that receive payloads, widgets that host a feed and widgets instanced from a widget blueprint that
+     * has not been cooked are never clustered. See FBlazeLayerConfig::bClusterWidgets for the other restrictions
+     * that apply to clustered widgets.
+     */
+    static void ClusterWidget(UUserWidget& Widget);
+
+    /** Return the counts for the object and every object nested within it. */
+    static FBlazeGCObjectCounts CountObjects(const UObject& Root);
+
+    static void Report(FOutputDevice& Ar);
+};
@@ -0,0 +1,175 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeHitchDetector.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blaze/BlazeProfiling.h"
+#include "GenericPlatform/GenericPlatformCrashContext.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+static TAutoConsoleVariable<float>
+    CVarBlazeHitchThresholdMs(TEXT("Blaze.HitchDetector.ThresholdMs"),
+                              4.0f,
+                              TEXT("Blaze operations that take longer than this many milliseconds on the game "
+                                   "thread are recorded as hitches. A value of 0 or less disables the detector."),
+                              ECVF_Default);
+
+static TAutoConsoleVariable<int32>
+    CVarBlazeHitchMaxReports(TEXT("Blaze.HitchDetector.MaxReports"),
+                             64,
+                             TEXT("The maximum number of hitch reports retained. The oldest reports are discarded."),
+                             ECVF_Default);
+
+static FAutoConsoleCommandWithOutputDevice
+    BlazeHitchDumpCommand(TEXT("Blaze.HitchDetector.Dump"),
+                          TEXT("Print the retained Blaze hitch reports, oldest first."),
+                          FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FBlazeHitchDetector::Dump));
+
+static FAutoConsoleCommand BlazeHitchResetCommand(TEXT("Blaze.HitchDetector.Reset"),
+                                                  TEXT("Discard the retained Blaze hitch reports."),
+                                                  FConsoleCommandDelegate::CreateStatic(&FBlazeHitchDetector::Reset));
+
+// The number of reports that are copied into the crash context
+static constexpr int32 NumCrashContextReports{ 8 };
+
+// Timers and reports are only accessed from the game thread
+static FBlazeOperationTimer* CurrentTimer{ nullptr };
+static TArray<FBlazeHitchReport> Reports;
+
+FString FBlazeHitchReport::ToString() const
+{
+    return FString::Printf(TEXT("Frame=%llu Operation=%s Layer=[%s] WidgetClass=[%s] Player=[%s] "
+                                "Total=%.2fms Construct=%.2fms Activate=%.2fms Load=%.2fms"),
+                           FrameNumber,
+                           Operation,
+                           *LayerName.ToString(),
+                           *WidgetClass,
+                           *Player,
+                           TotalMs,
+                           ConstructMs,
+                           ActivateMs,
+                           LoadMs);
+}
+
+FBlazeOperationTimer::FBlazeOperationTimer(const TCHAR* InOperation,
+                                           const FGameplayTag& InLayerName,
+                                           const UObject* InPlayer,
+                                           const UClass* InWidgetClass)
+    : Operation(InOperation)
+    , LayerName(InLayerName)
+    , Player(InPlayer)
+    , WidgetClass(InWidgetClass)
+    , StartTime(FPlatformTime::Seconds())
+    , Outer(CurrentTimer)
+{
+    check(IsInGameThread());
+    CurrentTimer = this;
+}
+
+FBlazeOperationTimer::~FBlazeOperationTimer()
+{
+    CurrentTimer = Outer;
+
+    if (Outer)
+    {
+        Outer->ConstructSeconds += ConstructSeconds;
+        if (!Outer->WidgetClass)
+        {
+            Outer->WidgetClass = WidgetClass;
+        }
+        if (!Outer->LayerName.IsValid())
+        {
+            Outer->LayerName = LayerName;
+        }
+    }
+    else
+    {
+        const auto ConstructMs = static_cast<float>(ConstructSeconds * 1000.0);
+        CSV_CUSTOM_STAT(Blaze, ConstructMs, ConstructMs, ECsvCustomStatOp::Accumulate);
+
+        const auto ThresholdMs = CVarBlazeHitchThresholdMs.GetValueOnGameThread();
+        const auto TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        if (ThresholdMs > 0.0f && TotalMs > ThresholdMs)
+        {
+            FBlazeHitchReport Report;
+            Report.Operation = Operation;
+            Report.LayerName = LayerName;
+            Report.WidgetClass = GetNameSafe(WidgetClass);
+            Report.Player = GetNameSafe(Player);
+            Report.LoadMs = LoadSeconds * 1000.0;
+            Report.ConstructMs = ConstructSeconds * 1000.0;
+            Report.ActivateMs = FMath::Max(0.0, TotalMs - Report.ConstructMs);
+            Report.TotalMs = TotalMs;
+            Report.FrameNumber = GFrameCounter;
+            FBlazeHitchDetector::AddReport(MoveTemp(Report));
+        }
+    }
+}
+
+void FBlazeOperationTimer::MarkConstructed()
+{
+    ConstructSeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+void FBlazeHitchDetector::AddReport(FBlazeHitchReport&& Report)
+{
+    check(IsInGameThread());
+    UE_LOGFMT(LogBlaze,
+              Log,
+              "Hitch detected in Blaze operation: {Report}",
+              Report.ToString());
+
+    const auto MaxReports = FMath::Max(1, CVarBlazeHitchMaxReports.GetValueOnGameThread());
+    while (Reports.Num() >= MaxReports)
+    {
+        Reports.RemoveAt(0);
+    }
+    Reports.Add(MoveTemp(Report));
+
+    // Keep a summary of the most recent reports in the crash context so that crash reports from
+    // soak runs show which screens were spiking leading up to the crash
+    FString CrashData;
+    for (auto i = FMath::Max(0, Reports.Num() - NumCrashContextReports); i < Reports.Num(); ++i)
+    {
+        CrashData.Append(Reports[i].ToString());
+        CrashData.AppendChar(TEXT('\n'));
+    }
+    FGenericCrashContext::SetGameData(TEXT("BlazeHitches"), CrashData);
+}
+
+const TArray<FBlazeHitchReport>& FBlazeHitchDetector::GetReports()
+{
+    check(IsInGameThread());
+    return Reports;
+}
+
+void FBlazeHitchDetector::Reset()
+{
+    check(IsInGameThread());
+    Reports.Reset();
+    // An empty value removes the entry from the crash context
+    FGenericCrashContext::SetGameData(TEXT("BlazeHitches"), TEXT(""));
+}
+
+void FBlazeHitchDetector::Dump(FOutputDevice& Ar)
+{
+    check(IsInGameThread());
+    Ar.Logf(TEXT("%d Blaze hitch report(s) above %.2fms:"),
+            Reports.Num(),
+            CVarBlazeHitchThresholdMs.GetValueOnGameThread());
+    for (const auto& Report : Reports)
+    {
+        Ar.Logf(TEXT("  %s"), *Report.ToString());
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+class FOutputDevice;
+
+/** A Blaze operation that took longer than the "Blaze.HitchDetector.ThresholdMs" threshold. */
+struct FBlazeHitchReport
+{
+    /** The name of the operation, such as "Push" or "AddLayout". */
+    const TCHAR* Operation{ TEXT("") };
+
+    FGameplayTag LayerName{ FGameplayTag::EmptyTag };
+
+    FString WidgetClass;
+
+    FString Player;
+
+    /** The time between the operation being requested and the assets it required being loaded. */
+    double LoadMs{ 0.0 };
+
+    /** The game thread time spent constructing the widget. */
+    double ConstructMs{ 0.0 };
+
+    /** The remaining game thread time, spent initializing and activating the widget. */
+    double ActivateMs{ 0.0 };
+
+    /** The total game thread time of the operation. */
+    double TotalMs{ 0.0 };
+
+    uint64 FrameNumber{ 0 };
+
+    FString ToString() const;
+};
+
+/**
+ * Times a Blaze operation for the duration of its scope and records a hitch report if it exceeds the threshold.
+ *
+ * Timers may nest, in which case only the outermost timer reports and the nested timers contribute their
+ * construction time and widget class to it. Timers must only be used on the game thread.
+ */
+class FBlazeOperationTimer final
+{
+public:
+    FBlazeOperationTimer(const TCHAR* InOperation,
+                         const FGameplayTag& InLayerName,
+                         const UObject* InPlayer,
+                         const UClass* InWidgetClass = nullptr);
+
+    ~FBlazeOperationTimer();
+
+    UE_NONCOPYABLE(FBlazeOperationTimer);
+
+    void SetWidgetClass(const UClass* InWidgetClass) { WidgetClass = InWidgetClass; }
+
+    void SetLoadSeconds(const double InLoadSeconds) { LoadSeconds = InLoadSeconds; }
+
+    /** Record that the widget has been constructed, splitting construction from the remainder of the operation. */
+    void MarkConstructed();
+
+private:
+    const TCHAR* Operation;
+    FGameplayTag LayerName;
+    const UObject* Player;
+    const UClass* WidgetClass;
+    double StartTime;
+    double ConstructSeconds{ 0.0 };
+    double LoadSeconds{ 0.0 };
+    FBlazeOperationTimer* Outer;
+};
+
+/**
+ * Holds the most recent hitch reports in a bounded list.
+ * The reports can be dumped via the "Blaze.HitchDetector.Dump" console command and the most recent reports
+ * are included in the crash context as the "BlazeHitches" game data.
+ */
+class FBlazeHitchDetector final
+{
+public:
+    static void AddReport(FBlazeHitchReport&& Report);
+
+    static const TArray<FBlazeHitchReport>& GetReports();
+
+    static void Reset();
+
+    static void Dump(FOutputDevice& Ar);
+};
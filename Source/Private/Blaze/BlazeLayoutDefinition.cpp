@@ -0,0 +1,63 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeLayoutDefinition.h"
+#include "Widgets/CommonActivatableWidgetContainer.h"
+#if WITH_EDITOR
+    #include "Misc/DataValidation.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BlazeLayoutDefinition)
+
+#define LOCTEXT_NAMESPACE "BlazeLayoutDefinition"
+
+#if WITH_EDITOR
+EDataValidationResult UBlazeLayoutDefinition::IsDataValid(FDataValidationContext& Context) const
+{
+    auto Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+    TSet<FGameplayTag> LayerTags;
+    LayerTags.Reserve(Layers.Num());
+    for (int32 Index = 0; Index < Layers.Num(); Index++)
+    {
+        const auto& Layer = Layers[Index];
+        if (!Layer.LayerTag.IsValid())
+        {
+            Context.AddError(FText::Format(LOCTEXT("InvalidLayerTag", "Layers[{0}] has no LayerTag."), Index));
+            Result = EDataValidationResult::Invalid;
+        }
+        else if (LayerTags.Contains(Layer.LayerTag))
+        {
+            Context.AddError(FText::Format(LOCTEXT("DuplicateLayerTag", "Layers[{0}] duplicates the LayerTag {1}."),
+                                           Index,
+                                           FText::FromName(Layer.LayerTag.GetTagName())));
+            Result = EDataValidationResult::Invalid;
+        }
+        else
+        {
+            LayerTags.Add(Layer.LayerTag);
+        }
+
+        if (!Layer.ContainerClass || Layer.ContainerClass->HasAnyClassFlags(CLASS_Abstract))
+        {
+            Context.AddError(FText::Format(LOCTEXT("InvalidContainerClass",
+                                                   "Layers[{0}] has no ContainerClass or the class is abstract."),
+                                           Index));
+            Result = EDataValidationResult::Invalid;
+        }
+    }
+    return Result;
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,149 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeMemoryPressure.h"
+#include "Async/Async.h"
+#include "Blaze/BlazeDependencyClosure.h"
+#include "Blaze/BlazeGarbageCollection.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blaze/BlazePrimaryLayout.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectHash.h"
+
+static TAutoConsoleVariable<float>
+    CVarBlazeMemoryEscalationSeconds(TEXT("Blaze.Memory.EscalationSeconds"),
+                                     10.0f,
+                                     TEXT("A memory trim signalled within this many seconds of the previous one is "
+                                          "treated as High rather than Medium pressure."),
+                                     ECVF_Default);
+
+static TAutoConsoleVariable<int32>
+    CVarBlazeMemoryGCObjectThreshold(TEXT("Blaze.Memory.GCObjectThreshold"),
+                                     0,
+                                     TEXT("After High memory pressure, removing a widget that owns at least this many "
+                                          "objects from a layer requests a garbage collection. "
+                                          "A value of 0 never requests a garbage collection."),
+                                     ECVF_Default);
+
+static FAutoConsoleCommand
+    BlazeMemoryTrimCommand(TEXT("Blaze.Memory.Trim"),
+                           TEXT("Release Blaze resources as if the platform signalled memory pressure. Accepts the "
+                                "pressure as Low, Medium or High and defaults to Medium."),
+                           FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+                               auto Pressure{ EBlazeMemoryPressure::Medium };
+                               if (!Args.IsEmpty())
+                               {
+                                   const auto Value = StaticEnum<EBlazeMemoryPressure>()->GetValueByNameString(Args[0]);
+                                   if (INDEX_NONE != Value)
+                                   {
+                                       Pressure = static_cast<EBlazeMemoryPressure>(Value);
+                                   }
+                               }
+                               FBlazeMemoryPressure::Respond(Pressure);
+                           }));
+
+static FDelegateHandle MemoryTrimHandle;
+
+// The time at which the platform last signalled a memory trim
+static double LastMemoryTrimTime{ 0.0 };
+
+// Set when High pressure is signalled and cleared once a large widget removal requests a garbage collection
+static bool bCollectAfterLargeRemoval{ false };
+
+static void OnMemoryTrim()
+{
+    // The platform may signal from any thread, but layouts may only be modified on the game thread
+    AsyncTask(ENamedThreads::GameThread, [] {
+        const auto Now = FPlatformTime::Seconds();
+        const auto bEscalate = LastMemoryTrimTime > 0.0
+            && Now - LastMemoryTrimTime <= CVarBlazeMemoryEscalationSeconds.GetValueOnGameThread();
+        LastMemoryTrimTime = Now;
+        FBlazeMemoryPressure::Respond(bEscalate ? EBlazeMemoryPressure::High : EBlazeMemoryPressure::Medium);
+    });
+}
+
+void FBlazeMemoryPressure::Startup()
+{
+    MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddStatic(&OnMemoryTrim);
+}
+
+void FBlazeMemoryPressure::Shutdown()
+{
+    FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+    MemoryTrimHandle.Reset();
+}
+
+FBlazeMemoryReclaim FBlazeMemoryPressure::Respond(const EBlazeMemoryPressure Pressure)
+{
+    check(IsInGameThread());
+
+    // The closures are recomputed on demand so they are the cheapest thing to give back
+    FBlazeDependencyClosure::ResetCache();
+
+    auto NumLayouts{ 0 };
+    FBlazeMemoryReclaim Reclaim;
+    ForEachObjectOfClass(
+        UBlazePrimaryLayout::StaticClass(),
+        [Pressure, &Reclaim, &NumLayouts](UObject* Object) {
+            Reclaim += CastChecked<UBlazePrimaryLayout>(Object)->ReclaimMemory(Pressure);
+            NumLayouts++;
+        },
+        true,
+        RF_ClassDefaultObject | RF_ArchetypeObject);
+
+    if (EBlazeMemoryPressure::High == Pressure && CVarBlazeMemoryGCObjectThreshold.GetValueOnGameThread() > 0)
+    {
+        bCollectAfterLargeRemoval = true;
+    }
+
+    UE_LOGFMT(LogBlaze,
+              Log,
+              "Responded to {Pressure} memory pressure across {Layouts} layout(s). Released {Classes} widget "
+              "class(es), dehydrated {Dehydrated} widget(s) and released {FeedWidgets} feed entry widget(s).",
+              StaticEnum<EBlazeMemoryPressure>()->GetNameStringByValue(static_cast<int64>(Pressure)),
+              NumLayouts,
+              Reclaim.ReleasedWidgetClasses,
+              Reclaim.DehydratedWidgets,
+              Reclaim.ReleasedFeedWidgets);
+    return Reclaim;
+}
+
+void FBlazeMemoryPressure::NotifyWidgetRemoved(const UUserWidget& Widget)
+{
+    if (bCollectAfterLargeRemoval)
+    {
+        const auto Threshold = CVarBlazeMemoryGCObjectThreshold.GetValueOnGameThread();
+        const auto Objects = FBlazeGarbageCollection::CountObjects(Widget).Objects;
+        if (Threshold > 0 && Objects >= Threshold)
+        {
+            UE_LOGFMT(LogBlaze,
+                      Log,
+                      "Requesting a garbage collection as widget [{Widget}] owning {Objects} object(s) was removed "
+                      "while under memory pressure. World=[{WorldName}]",
+                      Widget.GetName(),
+                      Objects,
+                      GetNameSafe(Widget.GetWorld()));
+            bCollectAfterLargeRemoval = false;
+            // The collection runs on the next engine tick, after the widget has been released by its layer
+            GEngine->ForceGarbageCollection(true);
+        }
+    }
+}
+
+bool FBlazeMemoryPressure::IsCollectionPending()
+{
+    return bCollectAfterLargeRemoval;
+}
@@ -0,0 +1,50 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Blaze/BlazeMemoryReclaim.h"
+
+class UUserWidget;
+
+/**
+ * Responds to memory pressure signalled by the platform by releasing resources held by every Blaze primary layout.
+ *
+ * The memory trim delegate of the engine is treated as Medium pressure, escalating to High pressure when a trim is
+ * signalled within "Blaze.Memory.EscalationSeconds" of the previous one. The response can also be triggered via the
+ * "Blaze.Memory.Trim" console command. What was released is logged so that the response can be tuned.
+ */
+class FBlazeMemoryPressure final
+{
+public:
+    static void Startup();
+
+    static void Shutdown();
+
+    /**
+     * Release resources from every primary layout as appropriate for the pressure.
+     *
+     * @param Pressure The severity of the pressure.
+     * @return The resources that were released.
+     */
+    static FBlazeMemoryReclaim Respond(EBlazeMemoryPressure Pressure);
+
+    /**
+     * Invoked when a widget is removed from a layer. After High pressure has been signalled, removing a widget that
+     * owns at least "Blaze.Memory.GCObjectThreshold" objects requests a garbage collection.
+     */
+    static void NotifyWidgetRemoved(const UUserWidget& Widget);
+
+    /** Return true if removing a widget that owns enough objects will request a garbage collection. */
+    static bool IsCollectionPending();
+};
@@ -12,19 +12,170 @@
  * limitations under the License.
  */
 #include "Blaze/BlazePrimaryLayout.h"
+#include "Algo/AnyOf.h"
+#include "Blaze/BlazeActivatableWidgetStack.h"
+#include "Blaze/BlazeDependencyClosure.h"
+#include "Blaze/BlazeFeedView.h"
 #include "Blaze/BlazeFunctionLibrary.h"
+#include "Blaze/BlazeGarbageCollection.h"
+#include "Blaze/BlazeHitchDetector.h"
+#include "Blaze/BlazeLayoutDefinition.h"
 #include "Blaze/BlazeLogging.h"
+#include "Blaze/BlazeMemoryPressure.h"
+#include "Blaze/BlazePayloadReceiver.h"
+#include "Blaze/BlazeProfiling.h"
+#include "Blaze/BlazeStatefulWidget.h"
+#include "Blaze/BlazeTrace.h"
+#include "Blaze/BlazeTransitionBudget.h"
+#include "Blaze/BlazeViewModelStore.h"
+#include "Blueprint/WidgetTree.h"
 #include "CommonActivatableWidget.h"
+#include "Components/Overlay.h"
+#include "Components/OverlaySlot.h"
 #include "Engine/AssetManager.h"
 #include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BlazePrimaryLayout)
 
+static TAutoConsoleVariable<float>
+    CVarBlazeRestoreFrameBudgetMs(TEXT("Blaze.Restore.FrameBudgetMs"),
+                                  2.0f,
+                                  TEXT("The time in milliseconds that restoring a layout snapshot may spend "
+                                       "constructing widgets each frame. "
+                                       "At least one widget is constructed per frame."),
+                                  ECVF_Default);
+
+static void SaveWidgetState(UCommonActivatableWidget& Widget, TArray<uint8>& OutState)
+{
+    if (const auto StatefulWidget = Cast<IBlazeStatefulWidget>(&Widget))
+    {
+        FMemoryWriter Writer(OutState);
+        StatefulWidget->SerializeWidgetState(Writer);
+    }
+}
+
+static void RestoreWidgetState(UCommonActivatableWidget& Widget, const TArray<uint8>& State)
+{
+    if (!State.IsEmpty())
+    {
+        if (const auto StatefulWidget = Cast<IBlazeStatefulWidget>(&Widget))
+        {
+            FMemoryReader Reader(State);
+            StatefulWidget->SerializeWidgetState(Reader);
+        }
+    }
+}
+
+void FBlazeLayer::GetWidgets(TArray<UCommonActivatableWidget*>& OutWidgets) const
+{
+    if (Container)
+    {
+        OutWidgets.Append(Container->GetWidgetList());
+    }
+    else
+    {
+        OutWidgets.Append(HeadlessWidgets);
+    }
+}
+
+UCommonActivatableWidget* FBlazeLayer::GetActiveWidget() const
+{
+    if (Container)
+    {
+        return Container->GetActiveWidget();
+    }
+    else
+    {
+        return HeadlessWidgets.IsEmpty() ? nullptr : HeadlessWidgets.Last().Get();
+    }
+}
+
+int32 FBlazeLayer::GetNumWidgets() const
+{
+    return Container ? Container->GetNumWidgets() : HeadlessWidgets.Num();
+}
+
+bool FBlazeLayer::ContainsWidget(const UCommonActivatableWidget& Widget) const
+{
+    return Container ? Container->GetWidgetList().Contains(&Widget) : HeadlessWidgets.Contains(&Widget);
+}
+
+void FBlazeLayer::ApplyTransitionBudget() const
+{
+    if (Container && Config.TransitionDuration > 0.f)
+    {
+        Container->SetTransitionDuration(
+            FBlazeTransitionBudget::ApplyToTransition(Config.TransitionDuration, Config.bAdaptTransitionToFrameBudget));
+    }
+}
+
+void FBlazeLayer::RefreshTransitionBudget() const
+{
+    if (Container && Config.TransitionDuration > 0.f && Config.bAdaptTransitionToFrameBudget)
+    {
+        Container->SetTransitionDuration(
+            FBlazeTransitionBudget::GetTransitionDuration(Config.TransitionDuration, true));
+    }
+}
+
+void FBlazeLayer::AddWidgetInstance(UCommonActivatableWidget& Widget)
+{
+    if (Container)
+    {
+        ApplyTransitionBudget();
+        Container->AddWidgetInstance(Widget);
+    }
+    else
+    {
+        HeadlessWidgets.Add(&Widget);
+    }
+}
+
+void FBlazeLayer::RemoveWidget(UCommonActivatableWidget& Widget)
+{
+    if (Container)
+    {
+        // Only removing the displayed widget transitions to another widget
+        if (Container->GetActiveWidget() == &Widget)
+        {
+            ApplyTransitionBudget();
+        }
+        Container->RemoveWidget(Widget);
+        FBlazeMemoryPressure::NotifyWidgetRemoved(Widget);
+    }
+    else if (HeadlessWidgets.RemoveSingle(&Widget) > 0)
+    {
+        // A proxy has no Slate resources but code waiting for the widget to be popped listens for their release
+        Widget.OnSlateReleased().Broadcast();
+    }
+}
+
 UBlazePrimaryLayout::UBlazePrimaryLayout(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer) {}
 
+void UBlazePrimaryLayout::BeginDestroy()
+{
+    // A restore is canceled when the layout is destructed as its callback must not run during garbage collection
+    if (RestoreTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(RestoreTickerHandle);
+        RestoreTickerHandle.Reset();
+    }
+    if (QueueTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(QueueTickerHandle);
+        QueueTickerHandle.Reset();
+    }
+
+    Super::BeginDestroy();
+}
+
 void UBlazePrimaryLayout::BP_RegisterLayer(const FGameplayTag LayerTag,
-                                           UCommonActivatableWidgetContainerBase* LayerWidget)
+                                           UCommonActivatableWidgetContainerBase* LayerWidget,
+                                           const FBlazeLayerConfig& Config)
 {
     if (!LayerTag.IsValid())
     {
@@ -44,7 +195,7 @@ void UBlazePrimaryLayout::BP_RegisterLayer(const FGameplayTag LayerTag,
         UE_LOGFMT(LogBlaze, Error, "BP_RegisterLayer was supplied an invalid LayerWidget");
 #endif
     }
-    else if (Layers.Contains(LayerTag))
+    else if (HasLayer(LayerTag))
     {
 #if WITH_EDITOR
         FFrame::KismetExecutionMessage(TEXT("BP_RegisterLayer attempted to register a Layer with "
@@ -59,121 +210,404 @@ void UBlazePrimaryLayout::BP_RegisterLayer(const FGameplayTag LayerTag,
     }
     else
     {
-        RegisterLayer(LayerTag, LayerWidget);
+        RegisterLayer(LayerTag, LayerWidget, Config);
     }
 }
 
-void UBlazePrimaryLayout::RegisterLayer(const FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget)
+void UBlazePrimaryLayout::RegisterLayer(const FGameplayTag LayerTag,
+                                        UCommonActivatableWidgetContainerBase* LayerWidget,
+                                        const FBlazeLayerConfig& Config)
 {
     // Avoid attempting to add widgets during designer as it would make it
     // hard to design in the editor if layers were being added
     if (!IsDesignTime())
     {
-        if (ensureAlways(LayerWidget) && ensureAlways(LayerTag.IsValid()) && ensureAlways(!Layers.Contains(LayerTag)))
+        if (ensureAlways(LayerWidget) && ensureAlways(LayerTag.IsValid()) && ensureAlways(!HasLayer(LayerTag)))
         {
-            LayerWidget->SetTransitionDuration(0.0);
-            Layers.Add(LayerTag, LayerWidget);
+            LayerWidget->SetTransitionDuration(Config.TransitionDuration);
+            auto& Layer = Layers.Add(LayerTag);
+            Layer.Container = LayerWidget;
+            Layer.Config = Config;
+            Layer.CsvStatName = FName(FString::Printf(TEXT("Widgets_%s"), *LayerTag.ToString()));
+
+            if (Config.DehydrateDepth > 0 && !LayerWidget->IsA<UCommonActivatableWidgetStack>())
+            {
+                UE_LOGFMT(LogBlaze,
+                          Warning,
+                          "RegisterLayer(LayerTag=[{LayerTag}] LayerWidget=[{LayerWidget}]) on layout [{Layout}] "
+                          "ignored DehydrateDepth as dehydration is only supported on stack layers. "
+                          "World=[{WorldName}]",
+                          LayerTag.GetTagName(),
+                          GetNameSafe(LayerWidget),
+                          GetName(),
+                          GetNameSafe(GetWorld()));
+                Layer.Config.DehydrateDepth = 0;
+            }
+
+            const auto bAdaptsTransition = Config.TransitionDuration > 0.f && Config.bAdaptTransitionToFrameBudget;
+            if (Layer.Config.DehydrateDepth > 0 || bAdaptsTransition)
+            {
+                LayerWidget->OnDisplayedWidgetChanged().AddUObject(this,
+                                                                   &ThisClass::OnLayerDisplayedWidgetChanged,
+                                                                   LayerTag);
+            }
         }
     }
 }
 
-// ReSharper disable once CppMemberFunctionMayBeStatic
-void UBlazePrimaryLayout::OnCancel(
-    const TWeakObjectPtr<UBlazePrimaryLayout> Self,
-    const TWeakObjectPtr<APlayerController> WeakPlayer,
-    const TFunction<void(EBlazePushWidgetToLayerState, UCommonActivatableWidget*)>& CallbackFunc,
-    const FName SuspendInputToken)
+void UBlazePrimaryLayout::RegisterHeadlessLayer(const FGameplayTag LayerTag, const FBlazeLayerConfig& Config)
 {
-    if (const auto PlayerController = WeakPlayer.Get())
+    if (ensureAlways(LayerTag.IsValid()) && ensureAlways(!HasLayer(LayerTag)))
     {
-        UBlazeFunctionLibrary::ResumeInputForPlayer(PlayerController, SuspendInputToken);
+        auto& Layer = Layers.Add(LayerTag);
+        Layer.Config = Config;
+        // Dehydration exists to release Slate resources, which the proxies of a headless layer never have
+        Layer.Config.DehydrateDepth = 0;
+        Layer.CsvStatName = FName(FString::Printf(TEXT("Widgets_%s"), *LayerTag.ToString()));
     }
-    if (Self.IsValid())
+}
+
+void UBlazePrimaryLayout::NativeOnInitialized()
+{
+    // The layers are built before the OnInitialized event so that the event can use them
+    if (LayoutDefinition && !IsDesignTime())
     {
-        CallbackFunc(EBlazePushWidgetToLayerState::Canceled, nullptr);
+        BuildLayers(*LayoutDefinition);
     }
+    Super::NativeOnInitialized();
+}
+
+void UBlazePrimaryLayout::NativeDestruct()
+{
+    // Nobody will see the pushed or restored widgets once the layout leaves the screen, so resume the input
+    // suspended for them now, while it is still safe to invoke the delegates and the completion callback
+    CancelAllPushRequests();
+    CancelRestoreSnapshot();
+    Super::NativeDestruct();
 }
 
-TSharedPtr<FStreamableHandle> UBlazePrimaryLayout::PushWidgetToLayerStackAsync_Internal(
-    const FGameplayTag& LayerName,
-    const bool bSuspendInputUntilComplete,
-    const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass,
-    TFunction<void(EBlazePushWidgetToLayerState, UCommonActivatableWidget*)> CallbackFunc)
+void UBlazePrimaryLayout::BuildLayers(const UBlazeLayoutDefinition& Definition)
 {
-    static const auto NAME_PushWidgetToLayer("PushWidgetToLayer");
-    const TWeakObjectPtr WeakPlayer = GetOwningPlayer();
-    const auto SuspendInputToken = bSuspendInputUntilComplete
-        ? UBlazeFunctionLibrary::SuspendInputForPlayer(WeakPlayer.Get(), NAME_PushWidgetToLayer)
-        : NAME_None;
+    if (!LayerOverlay && WidgetTree && !WidgetTree->RootWidget)
+    {
+        LayerOverlay = WidgetTree->ConstructWidget<UOverlay>();
+        WidgetTree->RootWidget = LayerOverlay;
+    }
+
+    if (!LayerOverlay)
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "[{Layout}] could not build the layers of LayoutDefinition [{Definition}] as the widget tree has a "
+                  "root but does not bind LayerOverlay. World=[{WorldName}]",
+                  GetName(),
+                  Definition.GetName(),
+                  GetNameSafe(GetWorld()));
+    }
+    else
+    {
+        const auto& LayerDefinitions = Definition.GetLayers();
 
-    TWeakObjectPtr Self(this);
+        // Overlay children are drawn in order so containers are added from the lowest ZOrder to the highest
+        TArray<const FBlazeLayerDefinition*, TInlineAllocator<16>> SortedLayerDefinitions;
+        SortedLayerDefinitions.Reserve(LayerDefinitions.Num());
+        for (const auto& LayerDefinition : LayerDefinitions)
+        {
+            SortedLayerDefinitions.Add(&LayerDefinition);
+        }
+        SortedLayerDefinitions.StableSort(
+            [](const FBlazeLayerDefinition& A, const FBlazeLayerDefinition& B) { return A.ZOrder < B.ZOrder; });
 
-    auto Handle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
-        WidgetClass.ToSoftObjectPath(),
-        FStreamableDelegate::CreateLambda([Self, WeakPlayer, LayerName, WidgetClass, CallbackFunc, SuspendInputToken] {
-            if (const auto PlayerController = WeakPlayer.Get())
+        Layers.Reserve(Layers.Num() + LayerDefinitions.Num());
+        for (const auto LayerDefinition : SortedLayerDefinitions)
+        {
+            const auto& ContainerClass = LayerDefinition->ContainerClass;
+            if (!LayerDefinition->LayerTag.IsValid() || HasLayer(LayerDefinition->LayerTag) || !ContainerClass
+                || ContainerClass->HasAnyClassFlags(CLASS_Abstract))
             {
-                UBlazeFunctionLibrary::ResumeInputForPlayer(PlayerController, SuspendInputToken);
+                // The definition is validated on save so this only occurs if it was modified without validation
+                UE_LOGFMT(LogBlaze,
+                          Error,
+                          "[{Layout}] skipped Layer [{LayerTag}] of LayoutDefinition [{Definition}] as the tag is "
+                          "invalid or already registered, or the ContainerClass [{ContainerClass}] is invalid. "
+                          "World=[{WorldName}]",
+                          GetName(),
+                          LayerDefinition->LayerTag.GetTagName(),
+                          Definition.GetName(),
+                          GetNameSafe(ContainerClass),
+                          GetNameSafe(GetWorld()));
             }
-            if (Self.IsValid())
+            else
             {
-                if (const auto ResolvedClass = WidgetClass.Get())
-                {
-                    if (const auto Widget = Self->PushWidgetToLayer<UCommonActivatableWidget>(
-                            LayerName,
-                            ResolvedClass,
-                            [CallbackFunc](auto& WidgetToInit) {
-                                CallbackFunc(EBlazePushWidgetToLayerState::Initialize, &WidgetToInit);
-                            }))
-                    {
-                        CallbackFunc(EBlazePushWidgetToLayerState::AfterPush, Widget);
-                    }
-                    else
-                    {
-                        UE_LOGFMT(LogBlaze,
-                                  Warning,
-                                  "PushWidgetToLayerAsync"
-                                  "((Layout=[{Layout}] Layer=[{LayerName}] WidgetClass=[{WidgetClass}])) "
-                                  "failed because the layer was not available or widget creation failed. "
-                                  "World=[{WorldName}]",
-                                  Self->GetName(),
-                                  LayerName.GetTagName(),
-                                  GetNameSafe(ResolvedClass),
-                                  GetNameSafe(Self->GetWorld()));
-                        CallbackFunc(EBlazePushWidgetToLayerState::Canceled, nullptr);
-                    }
-                }
-                else
-                {
-                    CallbackFunc(EBlazePushWidgetToLayerState::Canceled, nullptr);
-                }
+                const auto Container =
+                    WidgetTree->ConstructWidget<UCommonActivatableWidgetContainerBase>(ContainerClass);
+                const auto OverlaySlot = LayerOverlay->AddChildToOverlay(Container);
+                OverlaySlot->SetHorizontalAlignment(HAlign_Fill);
+                OverlaySlot->SetVerticalAlignment(VAlign_Fill);
+                RegisterLayer(LayerDefinition->LayerTag, Container, LayerDefinition->Config);
             }
-        }));
+        }
+    }
+}
 
-    if (!Handle.IsValid())
+void UBlazePrimaryLayout::BP_RegisterFeedLayer(const FGameplayTag LayerTag, UBlazeFeedView* FeedWidget)
+{
+    if (!LayerTag.IsValid() || !IsValid(FeedWidget) || HasLayer(LayerTag))
     {
-        OnCancel(Self, WeakPlayer, CallbackFunc, SuspendInputToken);
-        return nullptr;
+#if WITH_EDITOR
+        FFrame::KismetExecutionMessage(TEXT("BP_RegisterFeedLayer was supplied an invalid LayerName or FeedWidget, "
+                                            "or a Layer with the name already exists"),
+                                       ELogVerbosity::Error);
+#else
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "BP_RegisterFeedLayer was supplied an invalid LayerName or FeedWidget, "
+                  "or a Layer with the name already exists");
+#endif
+    }
+    else
+    {
+        RegisterFeedLayer(LayerTag, FeedWidget);
+    }
+}
+
+void UBlazePrimaryLayout::RegisterFeedLayer(const FGameplayTag LayerTag, UBlazeFeedView* FeedWidget)
+{
+    if (!IsDesignTime())
+    {
+        if (ensureAlways(FeedWidget) && ensureAlways(LayerTag.IsValid()) && ensureAlways(!HasLayer(LayerTag)))
+        {
+            Feeds.Add(LayerTag, FeedWidget);
+        }
+    }
+}
+
+bool UBlazePrimaryLayout::PushEntryToFeed(const FGameplayTag& LayerName, FInstancedStruct&& Payload)
+{
+    if (const auto Feed = GetFeed(LayerName))
+    {
+        Feed->PushEntry(MoveTemp(Payload));
+        return true;
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze,
+                  Warning,
+                  "PushEntryToFeed(LayerName=[{LayerName}]) on layout [{Layout}] ignored as no such Feed. "
+                  "World=[{WorldName}]",
+                  LayerName.GetTagName(),
+                  GetName(),
+                  GetNameSafe(GetWorld()));
+        return false;
+    }
+}
+
+UBlazeFeedView* UBlazePrimaryLayout::GetFeed(const FGameplayTag LayerName) const
+{
+    const auto Feed = Feeds.Find(LayerName);
+    return Feed ? Feed->Get() : nullptr;
+}
+
+UBlazeViewModelStore* UBlazePrimaryLayout::GetViewModelStore()
+{
+    if (!ViewModelStore)
+    {
+        ViewModelStore = NewObject<UBlazeViewModelStore>(this, NAME_None, RF_Transient);
+    }
+    return ViewModelStore;
+}
+
+FBlazePushRequest
+UBlazePrimaryLayout::PushWidgetToLayerAsync(const FGameplayTag& LayerName,
+                                            const bool bSuspendInputUntilComplete,
+                                            const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass,
+                                            FBlazePushRequestDelegate Delegate,
+                                            const bool bRevealWhenResident)
+{
+    return PushWidgetToLayerAsyncWithPayload(LayerName,
+                                             bSuspendInputUntilComplete,
+                                             WidgetClass,
+                                             FInstancedStruct(),
+                                             MoveTemp(Delegate),
+                                             bRevealWhenResident);
+}
+
+FBlazePushRequest
+UBlazePrimaryLayout::PushWidgetToLayerAsyncWithPayload(const FGameplayTag& LayerName,
+                                                       const bool bSuspendInputUntilComplete,
+                                                       const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass,
+                                                       FInstancedStruct&& Payload,
+                                                       FBlazePushRequestDelegate Delegate,
+                                                       const bool bRevealWhenResident)
+{
+    if (!ApplyPushPolicy(LayerName, WidgetClass))
+    {
+        Delegate.ExecuteIfBound(EBlazePushWidgetToLayerState::Canceled, nullptr);
+        return FBlazePushRequest();
+    }
+
+    auto Request = FBlazePushRequest::Start(*this,
+                                            LayerName,
+                                            bSuspendInputUntilComplete,
+                                            WidgetClass,
+                                            MoveTemp(Payload),
+                                            MoveTemp(Delegate),
+                                            bRevealWhenResident);
+    // The request may have completed before Start returned
+    if (Request.IsPending())
+    {
+        PendingPushRequests.Add(Request);
+    }
+    return Request;
+}
+
+int32 UBlazePrimaryLayout::CancelPushRequests(const FGameplayTag LayerName)
+{
+    if (LayerName.IsValid())
+    {
+        return CancelPushRequests_Internal(LayerName);
     }
     else
     {
-        Handle->BindCancelDelegate(
-            FStreamableDelegate::CreateLambda([this, Self, WeakPlayer, CallbackFunc, SuspendInputToken] {
-                OnCancel(Self, WeakPlayer, CallbackFunc, SuspendInputToken);
-            }));
+        UE_LOGFMT(LogBlaze,
+                  Warning,
+                  "CancelPushRequests(LayerName=[{LayerName}]) ignored as LayerName is invalid. World=[{WorldName}]",
+                  LayerName.GetTagName(),
+                  GetNameSafe(GetWorld()));
+        return 0;
+    }
+}
+
+int32 UBlazePrimaryLayout::CancelAllPushRequests()
+{
+    return CancelPushRequests_Internal(FGameplayTag::EmptyTag);
+}
+
+int32 UBlazePrimaryLayout::CancelPushRequests_Internal(const FGameplayTag& LayerName)
+{
+    // Canceling a request removes it from PendingPushRequests so iterate over a copy
+    auto Requests = PendingPushRequests;
+    auto Count{ 0 };
+    for (auto& Request : Requests)
+    {
+        if ((!LayerName.IsValid() || LayerName == Request.GetLayerName()) && Request.IsPending())
+        {
+            Request.Cancel();
+            Count++;
+        }
+    }
+    if (Count > 0)
+    {
+        if (FBlazeTraceRecorder::IsRecording())
+        {
+            FBlazeTraceRecorder::RecordLayoutOp(EBlazeTraceOp::Cancel, *this, LayerName);
+        }
+        UE_LOGFMT(LogBlaze,
+                  Verbose,
+                  "[{Layout}] canceled {Count} pending push request(s) for layer [{LayerName}]. World=[{WorldName}]",
+                  GetName(),
+                  Count,
+                  LayerName.IsValid() ? LayerName.GetTagName() : FName(TEXT("*")),
+                  GetNameSafe(GetWorld()));
+    }
+    return Count;
+}
+
+bool UBlazePrimaryLayout::ApplyPushPolicy(const FGameplayTag& LayerName,
+                                          const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass)
+{
+    if (const auto Layer = Layers.Find(LayerName))
+    {
+        const auto Now = FPlatformTime::Seconds();
+        const auto WidgetClassPath = WidgetClass.ToSoftObjectPath();
+        const auto PushPolicy = Layer->Config.PushPolicy;
+        if (EBlazePushPolicy::DropDuplicateClass == PushPolicy)
+        {
+            const auto bRecent = WidgetClassPath == Layer->LastPushWidgetClass
+                && Now - Layer->LastPushTime <= Layer->Config.DuplicateWindow;
+            const auto bPending = PendingPushRequests.ContainsByPredicate([&](const auto& Request) {
+                return LayerName == Request.GetLayerName() && WidgetClassPath == Request.GetWidgetClassPath();
+            });
+            if (bRecent || bPending)
+            {
+                UE_LOGFMT(LogBlaze,
+                          Verbose,
+                          "PushWidgetToLayerAsync(Layout=[{Layout}] Layer=[{LayerName}] WidgetClass=[{WidgetClass}]) "
+                          "dropped as a duplicate of a recent request. World=[{WorldName}]",
+                          GetName(),
+                          LayerName.GetTagName(),
+                          WidgetClassPath.ToString(),
+                          GetNameSafe(GetWorld()));
+                return false;
+            }
+        }
+
+        Layer->LastPushWidgetClass = WidgetClassPath;
+        Layer->LastPushTime = Now;
+
+        if (EBlazePushPolicy::LatestWins == PushPolicy)
+        {
+            CancelPushRequests_Internal(LayerName);
+        }
     }
+    return true;
+}
 
-    return Handle;
+void UBlazePrimaryLayout::OnPushRequestFinished(const FBlazePushRequest& Request)
+{
+    PendingPushRequests.RemoveSingleSwap(Request);
 }
 
 void UBlazePrimaryLayout::RemoveWidgetFromLayer(const FGameplayTag LayerName,
-                                                UCommonActivatableWidget* ActivatableWidget) const
+                                                UCommonActivatableWidget* ActivatableWidget)
 {
     check(LayerName.IsValid());
     check(ActivatableWidget);
-    if (const auto Layer = GetLayer(LayerName))
+    const auto Layer = Layers.Find(LayerName);
+    // A widget pushed within the same transaction has not been added to the layer yet
+    const auto PendingPushIndex = Layer && IsInLayerTransaction()
+        ? PendingLayerMutations.IndexOfByPredicate([&LayerName, ActivatableWidget](const auto& Mutation) {
+              return !Mutation.bRemove && Mutation.LayerName == LayerName && Mutation.Widget == ActivatableWidget;
+          })
+        : INDEX_NONE;
+    if (Layer && (INDEX_NONE != PendingPushIndex || Layer->ContainsWidget(*ActivatableWidget)))
+    {
+        // The pop is only recorded once the widget is known to be on the layer, so that replays do not skip it
+        if (FBlazeTraceRecorder::IsRecording())
+        {
+            FBlazeTraceRecorder::RecordPop(*this, LayerName, *ActivatableWidget);
+        }
+        if (INDEX_NONE != PendingPushIndex)
+        {
+            // The push and the removal cancel out and the widget is never added
+            PendingLayerMutations.RemoveAt(PendingPushIndex);
+        }
+        else if (IsInLayerTransaction())
+        {
+            PendingLayerMutations.Emplace(LayerName, ActivatableWidget, true);
+        }
+        else
+        {
+            CSV_SCOPED_TIMING_STAT(Blaze, Pop);
+            FBlazeOperationTimer Timer(TEXT("Pop"), LayerName, GetOwningPlayer(), ActivatableWidget->GetClass());
+            Layer->RemoveWidget(*ActivatableWidget);
+            if (!Layer->DehydratedWidgets.IsEmpty())
+            {
+                // Removing a widget below the displayed widget does not change the displayed widget
+                RehydrateLayer(LayerName, *Layer);
+            }
+        }
+    }
+    else if (Layer)
     {
-        Layer->RemoveWidget(*ActivatableWidget);
+        UE_LOGFMT(LogBlaze,
+                  Verbose,
+                  "RemoveWidgetFromLayer((LayerName=[{LayerName}] ActivatableWidget=[{ActivatableWidget}]) "
+                  "ignored as the widget is not on the Layer. "
+                  "World=[{WorldName}]",
+                  LayerName.GetTagName(),
+                  GetNameSafe(ActivatableWidget),
+                  GetNameSafe(GetWorld()));
     }
     else
     {
@@ -188,8 +622,1049 @@ void UBlazePrimaryLayout::RemoveWidgetFromLayer(const FGameplayTag LayerName,
     }
 }
 
+UCommonActivatableWidget*
+UBlazePrimaryLayout::PushWidgetToLayer_Internal(const FGameplayTag& LayerName,
+                                                const UClass* WidgetClass,
+                                                const TFunctionRef<void(UCommonActivatableWidget&)> InitInstanceFunc)
+{
+    check(LayerName.IsValid());
+    const auto Layer = Layers.Find(LayerName);
+    if (ensureAlwaysMsgf(Layer,
+                         TEXT("PushWidgetToLayer called with unregistered layer [%s] on layout [%s]"),
+                         *LayerName.ToString(),
+                         *GetName())
+        && ensureAlwaysMsgf(WidgetClass,
+                            TEXT("PushWidgetToLayer called with null WidgetClass for layer [%s] on layout [%s]"),
+                            *LayerName.ToString(),
+                            *GetName()))
+    {
+        CSV_SCOPED_TIMING_STAT(Blaze, Push);
+        FBlazeOperationTimer Timer(TEXT("Push"), LayerName, GetOwningPlayer(), WidgetClass);
+        if (IsInLayerTransaction())
+        {
+            const TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass(const_cast<UClass*>(WidgetClass));
+            if (const auto Widget = CreateLayerWidget(*Layer, ActivatableWidgetClass))
+            {
+                Timer.MarkConstructed();
+                InitInstanceFunc(*Widget);
+                PendingLayerMutations.Emplace(LayerName, Widget, false);
+                if (FBlazeTraceRecorder::IsRecording())
+                {
+                    FBlazeTraceRecorder::RecordPush(*this, LayerName, *Widget);
+                }
+                return Widget;
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+        else if (Layer->IsHeadless())
+        {
+            const TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass(const_cast<UClass*>(WidgetClass));
+            if (const auto Widget = CreateLayerWidget(*Layer, ActivatableWidgetClass))
+            {
+                Timer.MarkConstructed();
+                InitInstanceFunc(*Widget);
+                Layer->AddWidgetInstance(*Widget);
+                if (FBlazeTraceRecorder::IsRecording())
+                {
+                    FBlazeTraceRecorder::RecordPush(*this, LayerName, *Widget);
+                }
+                return Widget;
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+        else
+        {
+            Layer->ApplyTransitionBudget();
+            // The container invokes the init function once the widget has been constructed and before it is added
+            const auto Widget = Layer->Container->AddWidget<UCommonActivatableWidget>(
+                const_cast<UClass*>(WidgetClass),
+                [&Timer, &InitInstanceFunc](auto& WidgetToInit) {
+                    Timer.MarkConstructed();
+                    InitInstanceFunc(WidgetToInit);
+                });
+            if (Widget && Layer->Config.bClusterWidgets)
+            {
+                FBlazeGarbageCollection::ClusterWidget(*Widget);
+            }
+            if (Widget && FBlazeTraceRecorder::IsRecording())
+            {
+                FBlazeTraceRecorder::RecordPush(*this, LayerName, *Widget);
+            }
+            if (Layer->Config.DehydrateDepth > 0)
+            {
+                DehydrateLayer(*Layer, Layer->Config.DehydrateDepth);
+            }
+            return Widget;
+        }
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+UCommonActivatableWidget*
+UBlazePrimaryLayout::PushWidgetToLayerWithPayload(const FGameplayTag& LayerName,
+                                                  const UClass* WidgetClass,
+                                                  FInstancedStruct&& Payload,
+                                                  const TFunctionRef<void(UCommonActivatableWidget&)> InitInstanceFunc)
+{
+    return PushWidgetToLayer_Internal(LayerName, WidgetClass, [&Payload, &InitInstanceFunc](auto& Widget) {
+        DeliverPayload(Widget, MoveTemp(Payload));
+        InitInstanceFunc(Widget);
+    });
+}
+
+void UBlazePrimaryLayout::DeliverPayload(UCommonActivatableWidget& Widget, FInstancedStruct&& Payload)
+{
+    if (const auto Receiver = Cast<IBlazePayloadReceiver>(&Widget))
+    {
+        Receiver->ReceivePayload(MoveTemp(Payload));
+    }
+    else if (Payload.IsValid())
+    {
+        UE_LOGFMT(LogBlaze,
+                  Warning,
+                  "Discarded payload [{PayloadType}] pushed with widget [{Widget}] as the widget does not "
+                  "implement IBlazePayloadReceiver. World=[{WorldName}]",
+                  GetNameSafe(Payload.GetScriptStruct()),
+                  Widget.GetName(),
+                  GetNameSafe(Widget.GetWorld()));
+        Payload.Reset();
+    }
+}
+
+bool UBlazePrimaryLayout::EnqueueWidgetToLayer(const FGameplayTag& LayerName,
+                                               const TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                               FInstancedStruct&& Payload,
+                                               const int32 Priority,
+                                               const FName MergeKey)
+{
+    const auto Layer = LayerName.IsValid() ? Layers.Find(LayerName) : nullptr;
+    if (!Layer || !WidgetClass)
+    {
+        UE_LOGFMT(LogBlaze,
+                  Warning,
+                  "EnqueueWidgetToLayer(LayerName=[{LayerName}] WidgetClass=[{WidgetClass}]) on layout [{Layout}] "
+                  "ignored as the Layer is not registered or the WidgetClass is null. World=[{WorldName}]",
+                  LayerName.GetTagName(),
+                  GetNameSafe(WidgetClass),
+                  GetName(),
+                  GetNameSafe(GetWorld()));
+        return false;
+    }
+    else
+    {
+        auto& Entries = Layer->QueuedEntries;
+        const auto MergeIndex = NAME_None == MergeKey
+            ? INDEX_NONE
+            : Entries.IndexOfByPredicate([&](const auto& Entry) {
+                  return MergeKey == Entry.MergeKey && WidgetClass == Entry.WidgetClass;
+              });
+        if (INDEX_NONE != MergeIndex)
+        {
+            auto& Entry = Entries[MergeIndex];
+            if (const auto Receiver = Cast<IBlazePayloadReceiver>(WidgetClass->GetDefaultObject()))
+            {
+                Receiver->MergePayload(Entry.Payload, MoveTemp(Payload));
+            }
+            else
+            {
+                Entry.Payload = MoveTemp(Payload);
+            }
+
+            if (Entry.Priority >= Priority)
+            {
+                // The merged entry keeps its place in the queue and is still waiting, so the ticker is running
+                return true;
+            }
+            else
+            {
+                // The merged entry is reinserted below at the raised priority
+                Payload = MoveTemp(Entry.Payload);
+                Entries.RemoveAt(MergeIndex);
+            }
+        }
+
+        // Entries are kept ordered by descending priority and then by the order in which they were enqueued
+        const auto InsertIndex =
+            Entries.IndexOfByPredicate([Priority](const auto& Entry) { return Entry.Priority < Priority; });
+        auto& Entry = Entries.InsertDefaulted_GetRef(INDEX_NONE == InsertIndex ? Entries.Num() : InsertIndex);
+        Entry.WidgetClass = WidgetClass;
+        Entry.Payload = MoveTemp(Payload);
+        Entry.Priority = Priority;
+        Entry.MergeKey = MergeKey;
+
+        if (Layer->Config.QueueMaxEntries > 0 && Entries.Num() > Layer->Config.QueueMaxEntries)
+        {
+            UE_LOGFMT(LogBlaze,
+                      Verbose,
+                      "EnqueueWidgetToLayer(LayerName=[{LayerName}]) on layout [{Layout}] discarded an entry "
+                      "for WidgetClass [{WidgetClass}] as the Layer holds more than {MaxEntries} entries. "
+                      "World=[{WorldName}]",
+                      LayerName.GetTagName(),
+                      GetName(),
+                      GetNameSafe(Entries.Last().WidgetClass),
+                      Layer->Config.QueueMaxEntries,
+                      GetNameSafe(GetWorld()));
+            Entries.Pop();
+        }
+
+        if (DisplayQueuedEntries(LayerName, *Layer) && !QueueTickerHandle.IsValid())
+        {
+            QueueTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+                FTickerDelegate::CreateWeakLambda(this, [this](const float DeltaTime) {
+                    return TickQueuedEntries(DeltaTime);
+                }));
+        }
+        return true;
+    }
+}
+
+int32 UBlazePrimaryLayout::GetNumQueuedEntries(const FGameplayTag& LayerName) const
+{
+    const auto Layer = Layers.Find(LayerName);
+    return Layer ? Layer->QueuedEntries.Num() : 0;
+}
+
+bool UBlazePrimaryLayout::DisplayQueuedEntries(const FGameplayTag& LayerName, FBlazeLayer& Layer)
+{
+    const auto MaxVisible = Layer.Config.QueueMaxVisible;
+    const auto DisplayRate = Layer.Config.QueueDisplayRate;
+    const double Now = FPlatformTime::Seconds();
+
+    while (!Layer.QueuedEntries.IsEmpty() && (DisplayRate <= 0.f || Now >= Layer.NextQueueDisplayTime))
+    {
+        if (MaxVisible > 0 && GetNumLayerWidgets(LayerName, Layer) >= MaxVisible)
+        {
+            break;
+        }
+
+        auto Entry = MoveTemp(Layer.QueuedEntries[0]);
+        Layer.QueuedEntries.RemoveAt(0);
+        if (DisplayRate > 0.f)
+        {
+            Layer.NextQueueDisplayTime = Now + 1.0 / DisplayRate;
+        }
+        PushWidgetToLayerWithPayload(LayerName, Entry.WidgetClass, MoveTemp(Entry.Payload));
+    }
+    return !Layer.QueuedEntries.IsEmpty();
+}
+
+int32 UBlazePrimaryLayout::GetNumLayerWidgets(const FGameplayTag& LayerName, const FBlazeLayer& Layer) const
+{
+    // Widgets pushed within an open layer transaction occupy the layer even though they are not yet added
+    auto NumWidgets = Layer.GetNumWidgets();
+    for (const auto& Mutation : PendingLayerMutations)
+    {
+        if (Mutation.LayerName == LayerName)
+        {
+            NumWidgets += Mutation.bRemove ? -1 : 1;
+        }
+    }
+    return FMath::Max(NumWidgets, 0);
+}
+
+bool UBlazePrimaryLayout::TickQueuedEntries(float DeltaTime)
+{
+    auto bWaiting{ false };
+    for (auto& Layer : Layers)
+    {
+        if (!Layer.Value.QueuedEntries.IsEmpty())
+        {
+            bWaiting |= DisplayQueuedEntries(Layer.Key, Layer.Value);
+        }
+    }
+    if (!bWaiting)
+    {
+        // The ticker is removed explicitly as this may also be invoked outside of the ticker
+        RemoveQueueTickerIfIdle();
+    }
+    return bWaiting;
+}
+
+void UBlazePrimaryLayout::RemoveQueueTickerIfIdle()
+{
+    if (QueueTickerHandle.IsValid()
+        && !Algo::AnyOf(Layers, [](const auto& Layer) { return !Layer.Value.QueuedEntries.IsEmpty(); }))
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(QueueTickerHandle);
+        QueueTickerHandle.Reset();
+    }
+}
+
+UCommonActivatableWidget* UBlazePrimaryLayout::CreateLayerWidget(const FBlazeLayer& Layer,
+                                                               const TSubclassOf<UCommonActivatableWidget> WidgetClass)
+{
+    if (!Layer.IsHeadless())
+    {
+        return CreateWidget<UCommonActivatableWidget>(this, WidgetClass);
+    }
+    else if (WidgetClass->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+    {
+        UE_LOGFMT(LogBlaze,
+                  Error,
+                  "[{Layout}] could not create a headless proxy for WidgetClass [{WidgetClass}] "
+                  "as the class is abstract, deprecated or replaced. World=[{WorldName}]",
+                  GetName(),
+                  WidgetClass->GetName(),
+                  GetNameSafe(GetWorld()));
+        return nullptr;
+    }
+    else
+    {
+        // The proxy is deliberately never initialized so that neither its widget tree nor its Slate widget is
+        // constructed. The player context is still supplied so that code can locate the owning player.
+        const auto Widget = NewObject<UCommonActivatableWidget>(this, WidgetClass, NAME_None, RF_Transient);
+        Widget->SetPlayerContext(GetPlayerContext());
+        return Widget;
+    }
+}
+
+void UBlazePrimaryLayout::GetLayerWidgets(const FGameplayTag& LayerName,
+                                          TArray<UCommonActivatableWidget*>& OutWidgets) const
+{
+    if (const auto Layer = Layers.Find(LayerName))
+    {
+        Layer->GetWidgets(OutWidgets);
+        for (const auto& Mutation : PendingLayerMutations)
+        {
+            if (Mutation.LayerName == LayerName)
+            {
+                if (Mutation.bRemove)
+                {
+                    OutWidgets.Remove(Mutation.Widget.Get());
+                }
+                else
+                {
+                    OutWidgets.Add(Mutation.Widget.Get());
+                }
+            }
+        }
+    }
+}
+
+int32 UBlazePrimaryLayout::ClearLayer(const FGameplayTag LayerName)
+{
+    if (const auto Layer = LayerName.IsValid() ? Layers.Find(LayerName) : nullptr)
+    {
+        TArray<UCommonActivatableWidget*> Widgets;
+        GetLayerWidgets(LayerName, Widgets);
+
+        const auto DehydratedCount = Layer->DehydratedWidgets.Num();
+        Layer->DehydratedWidgets.Reset();
+        Layer->QueuedEntries.Reset();
+        RemoveQueueTickerIfIdle();
+
+        CancelPushRequests_Internal(LayerName);
+
+        FBlazeScopedLayerTransaction Transaction(this);
+        for (const auto Widget : Widgets)
+        {
+            RemoveWidgetFromLayer(LayerName, Widget);
+        }
+        return Widgets.Num() + DehydratedCount;
+    }
+    else if (const auto Feed = LayerName.IsValid() ? GetFeed(LayerName) : nullptr)
+    {
+        // The entries of a feed are held as data rather than as widgets
+        const auto EntryCount = Feed->GetNumEntries();
+        Feed->ClearEntries();
+        return EntryCount;
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze,
+                  Warning,
+                  "ClearLayer(LayerName=[{LayerName}]) ignored as no such Layer. World=[{WorldName}]",
+                  LayerName.GetTagName(),
+                  GetNameSafe(GetWorld()));
+        return 0;
+    }
+}
+
+int32 UBlazePrimaryLayout::PopUntil(const FGameplayTag LayerName, UCommonActivatableWidget* ActivatableWidget)
+{
+    if (LayerName.IsValid() && Layers.Contains(LayerName) && ActivatableWidget)
+    {
+        TArray<UCommonActivatableWidget*> Widgets;
+        GetLayerWidgets(LayerName, Widgets);
+
+        const auto Index = Widgets.Find(ActivatableWidget);
+        if (INDEX_NONE != Index)
+        {
+            FBlazeScopedLayerTransaction Transaction(this);
+            // Remove from the top down, although the order is irrelevant within a transaction
+            for (auto i = Widgets.Num() - 1; i > Index; --i)
+            {
+                RemoveWidgetFromLayer(LayerName, Widgets[i]);
+            }
+            return Widgets.Num() - 1 - Index;
+        }
+        else
+        {
+            UE_LOGFMT(LogBlaze,
+                      Warning,
+                      "PopUntil(LayerName=[{LayerName}] ActivatableWidget=[{ActivatableWidget}]) "
+                      "ignored as widget is not present on the Layer. World=[{WorldName}]",
+                      LayerName.GetTagName(),
+                      GetNameSafe(ActivatableWidget),
+                      GetNameSafe(GetWorld()));
+            return 0;
+        }
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze,
+                  Warning,
+                  "PopUntil(LayerName=[{LayerName}] ActivatableWidget=[{ActivatableWidget}]) "
+                  "ignored due to invalid parameters. World=[{WorldName}]",
+                  LayerName.GetTagName(),
+                  GetNameSafe(ActivatableWidget),
+                  GetNameSafe(GetWorld()));
+        return 0;
+    }
+}
+
+int32 UBlazePrimaryLayout::PopAll(const FBlazeWidgetQuery& Query)
+{
+    return PopAll([&Query](const auto& LayerName, const auto& Widget) { return Query.Matches(LayerName, Widget); });
+}
+
+int32 UBlazePrimaryLayout::PopAll(const TFunctionRef<bool(const FGameplayTag&, UCommonActivatableWidget&)> Predicate)
+{
+    auto Count{ 0 };
+    FBlazeScopedLayerTransaction Transaction(this);
+    TArray<UCommonActivatableWidget*> Widgets;
+    for (const auto& Layer : Layers)
+    {
+        Widgets.Reset();
+        GetLayerWidgets(Layer.Key, Widgets);
+        for (const auto Widget : Widgets)
+        {
+            if (Widget && Predicate(Layer.Key, *Widget))
+            {
+                RemoveWidgetFromLayer(Layer.Key, Widget);
+                Count++;
+            }
+        }
+    }
+    return Count;
+}
+
+FBlazeLayoutSnapshot UBlazePrimaryLayout::CaptureSnapshot() const
+{
+    FBlazeLayoutSnapshot Snapshot;
+    TArray<UCommonActivatableWidget*> Widgets;
+    for (const auto& Layer : Layers)
+    {
+        Widgets.Reset();
+        GetLayerWidgets(Layer.Key, Widgets);
+        if (!Widgets.IsEmpty() || !Layer.Value.DehydratedWidgets.IsEmpty())
+        {
+            auto& LayerSnapshot = Snapshot.Layers.AddDefaulted_GetRef();
+            LayerSnapshot.LayerName = Layer.Key;
+            LayerSnapshot.Widgets.Reserve(Layer.Value.DehydratedWidgets.Num() + Widgets.Num());
+            // Dehydrated widgets sit below every live widget on the layer
+            for (const auto& Record : Layer.Value.DehydratedWidgets)
+            {
+                auto& WidgetSnapshot = LayerSnapshot.Widgets.AddDefaulted_GetRef();
+                WidgetSnapshot.WidgetClass = TSoftClassPtr<UCommonActivatableWidget>(Record.WidgetClass.Get());
+                WidgetSnapshot.State = Record.State;
+            }
+            for (const auto Widget : Widgets)
+            {
+                auto& WidgetSnapshot = LayerSnapshot.Widgets.AddDefaulted_GetRef();
+                WidgetSnapshot.WidgetClass = TSoftClassPtr<UCommonActivatableWidget>(Widget->GetClass());
+                SaveWidgetState(*Widget, WidgetSnapshot.State);
+            }
+        }
+    }
+    return Snapshot;
+}
+
+void UBlazePrimaryLayout::BP_RestoreSnapshot(const FBlazeLayoutSnapshot& Snapshot)
+{
+    RestoreSnapshot(Snapshot);
+}
+
+void UBlazePrimaryLayout::RestoreSnapshot(const FBlazeLayoutSnapshot& Snapshot, TFunction<void(bool)> OnComplete)
+{
+    CancelRestoreSnapshot();
+
+    UE_LOGFMT(LogBlaze,
+              Verbose,
+              "[{Layout}] restoring snapshot containing {LayerCount} layer(s) and {WidgetCount} widget(s). "
+              "World=[{WorldName}]",
+              GetName(),
+              Snapshot.Layers.Num(),
+              Snapshot.NumWidgets(),
+              GetNameSafe(GetWorld()));
+
+    TArray<FSoftObjectPath> ClassPaths;
+    for (const auto& LayerSnapshot : Snapshot.Layers)
+    {
+        if (!LayerSnapshot.LayerName.IsValid() || !Layers.Contains(LayerSnapshot.LayerName))
+        {
+            UE_LOGFMT(LogBlaze,
+                      Warning,
+                      "RestoreSnapshot on layout [{Layout}] will skip Layer [{LayerName}] as no such Layer. "
+                      "World=[{WorldName}]",
+                      GetName(),
+                      LayerSnapshot.LayerName.GetTagName(),
+                      GetNameSafe(GetWorld()));
+        }
+        else
+        {
+            for (const auto& WidgetSnapshot : LayerSnapshot.Widgets)
+            {
+                if (!WidgetSnapshot.WidgetClass.IsNull())
+                {
+                    ClassPaths.AddUnique(WidgetSnapshot.WidgetClass.ToSoftObjectPath());
+                }
+            }
+        }
+    }
+
+    bRestoringSnapshot = true;
+    RestoringSnapshot = Snapshot;
+    RestoreLayerIndex = 0;
+    RestoreWidgetIndex = 0;
+    OnRestoreComplete = MoveTemp(OnComplete);
+
+    if (const auto PlayerController = GetOwningPlayer())
+    {
+        static const FName NAME_RestoreSnapshot("RestoreSnapshot");
+        RestoreSuspendedPlayer = PlayerController;
+        RestoreSuspendInputToken = UBlazeFunctionLibrary::SuspendInputForPlayer(PlayerController, NAME_RestoreSnapshot);
+    }
+
+    if (ClassPaths.IsEmpty())
+    {
+        OnRestoreSnapshotLoaded();
+    }
+    else
+    {
+        // The closures are usually cached, in which case the load begins before the last Request returns
+        RestoreSerial++;
+        RestorePendingClosures = ClassPaths.Num();
+        for (const auto& ClassPath : ClassPaths)
+        {
+            TWeakObjectPtr Self(this);
+            FBlazeDependencyClosure::Request(
+                ClassPath,
+                [Self, Serial = RestoreSerial](const TArray<FSoftObjectPath>& Paths) {
+                    // The restore may have been canceled or replaced while the dependency closure was computed
+                    if (Self.IsValid() && Self->bRestoringSnapshot && Serial == Self->RestoreSerial)
+                    {
+                        Self->RestoreLoadPaths.Append(Paths);
+                        if (0 == --Self->RestorePendingClosures)
+                        {
+                            Self->BeginRestoreSnapshotLoad();
+                        }
+                    }
+                });
+        }
+    }
+}
+
+void UBlazePrimaryLayout::BeginRestoreSnapshotLoad()
+{
+    // All classes and their dependencies are loaded in a single request rather than one request per widget
+    auto Paths = RestoreLoadPaths.Array();
+    RestoreLoadPaths.Reset();
+    auto Handle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
+        MoveTemp(Paths),
+        FStreamableDelegate::CreateWeakLambda(this, [this] { OnRestoreSnapshotLoaded(); }),
+        FStreamableManager::AsyncLoadHighPriority);
+    if (!Handle.IsValid())
+    {
+        UE_LOGFMT(LogBlaze,
+                  Warning,
+                  "RestoreSnapshot on layout [{Layout}] failed as the widget classes could not be loaded. "
+                  "World=[{WorldName}]",
+                  GetName(),
+                  GetNameSafe(GetWorld()));
+        FinishRestoreSnapshot(false);
+    }
+    else if (bRestoringSnapshot)
+    {
+        // Retain the handle until the restore finishes so that the classes stay loaded while the widgets
+        // are constructed over several frames
+        RestoreHandle = MoveTemp(Handle);
+    }
+}
+
+void UBlazePrimaryLayout::OnRestoreSnapshotLoaded()
+{
+    if (bRestoringSnapshot && !RestoreTickerHandle.IsValid())
+    {
+        // Construct the first batch of widgets immediately and spread the remainder over subsequent frames
+        if (TickRestoreSnapshot(0.f))
+        {
+            RestoreTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+                FTickerDelegate::CreateWeakLambda(this, [this](const float DeltaTime) {
+                    return TickRestoreSnapshot(DeltaTime);
+                }));
+        }
+    }
+}
+
+bool UBlazePrimaryLayout::TickRestoreSnapshot(float DeltaTime)
+{
+    const double BudgetSeconds = FMath::Max(0.f, CVarBlazeRestoreFrameBudgetMs.GetValueOnGameThread()) / 1000.0;
+    const double StartTime = FPlatformTime::Seconds();
+    while (RestoreLayerIndex < RestoringSnapshot.Layers.Num())
+    {
+        const auto& LayerSnapshot = RestoringSnapshot.Layers[RestoreLayerIndex];
+        const auto Layer = Layers.Find(LayerSnapshot.LayerName);
+        if (RestoreWidgetIndex < LayerSnapshot.Widgets.Num() && Layer)
+        {
+            const auto& WidgetSnapshot = LayerSnapshot.Widgets[RestoreWidgetIndex];
+            RestoreWidgetIndex++;
+
+            const TSubclassOf<UCommonActivatableWidget> WidgetClass = WidgetSnapshot.WidgetClass.Get();
+            if (const auto Widget = WidgetClass ? CreateLayerWidget(*Layer, WidgetClass) : nullptr)
+            {
+                RestoreWidgetState(*Widget, WidgetSnapshot.State);
+                RestoredWidgets.Emplace(LayerSnapshot.LayerName, Widget, false);
+            }
+            else
+            {
+                UE_LOGFMT(LogBlaze,
+                          Warning,
+                          "RestoreSnapshot on layout [{Layout}] skipped WidgetClass [{WidgetClass}] "
+                          "on Layer [{LayerName}] as it failed to load or construct. World=[{WorldName}]",
+                          GetName(),
+                          WidgetSnapshot.WidgetClass.ToSoftObjectPath(),
+                          LayerSnapshot.LayerName.GetTagName(),
+                          GetNameSafe(GetWorld()));
+            }
+
+            if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+            {
+                // Continue next frame
+                return true;
+            }
+        }
+        else
+        {
+            RestoreLayerIndex++;
+            RestoreWidgetIndex = 0;
+        }
+    }
+
+    {
+        // Every layer in the snapshot is replaced in a single pass
+        FBlazeScopedLayerTransaction Transaction(this);
+        for (const auto& LayerSnapshot : RestoringSnapshot.Layers)
+        {
+            if (LayerSnapshot.LayerName.IsValid() && Layers.Contains(LayerSnapshot.LayerName))
+            {
+                ClearLayer(LayerSnapshot.LayerName);
+            }
+        }
+        if (FBlazeTraceRecorder::IsRecording())
+        {
+            for (const auto& Mutation : RestoredWidgets)
+            {
+                FBlazeTraceRecorder::RecordPush(*this, Mutation.LayerName, *Mutation.Widget);
+            }
+        }
+        PendingLayerMutations.Append(RestoredWidgets);
+        RestoredWidgets.Reset();
+    }
+
+    FinishRestoreSnapshot(true);
+    return false;
+}
+
+void UBlazePrimaryLayout::CancelRestoreSnapshot()
+{
+    if (bRestoringSnapshot)
+    {
+        if (RestoreHandle.IsValid())
+        {
+            RestoreHandle->CancelHandle();
+        }
+        FinishRestoreSnapshot(false);
+    }
+}
+
+void UBlazePrimaryLayout::FinishRestoreSnapshot(const bool bSuccess)
+{
+    if (RestoreTickerHandle.IsValid())
+    {
+        // The ticker may be the caller, which is safe as the ticker supports removal from within its delegate
+        FTSTicker::GetCoreTicker().RemoveTicker(RestoreTickerHandle);
+        RestoreTickerHandle.Reset();
+    }
+    if (NAME_None != RestoreSuspendInputToken)
+    {
+        if (const auto PlayerController = RestoreSuspendedPlayer.Get())
+        {
+            UBlazeFunctionLibrary::ResumeInputForPlayer(PlayerController, RestoreSuspendInputToken);
+        }
+    }
+    RestoreSuspendedPlayer.Reset();
+    RestoreSuspendInputToken = NAME_None;
+    RestoreHandle.Reset();
+    RestoreLoadPaths.Reset();
+    RestorePendingClosures = 0;
+    RestoredWidgets.Reset();
+    RestoringSnapshot.Layers.Reset();
+    bRestoringSnapshot = false;
+
+    if (const auto Callback = MoveTemp(OnRestoreComplete))
+    {
+        OnRestoreComplete = nullptr;
+        Callback(bSuccess);
+    }
+}
+
+void UBlazePrimaryLayout::BeginLayerTransaction()
+{
+    if (FBlazeTraceRecorder::IsRecording())
+    {
+        FBlazeTraceRecorder::RecordLayoutOp(EBlazeTraceOp::BeginTransaction, *this);
+    }
+    LayerTransactionDepth++;
+}
+
+void UBlazePrimaryLayout::CommitLayerTransaction()
+{
+    if (ensureAlwaysMsgf(LayerTransactionDepth > 0,
+                         TEXT("CommitLayerTransaction called on layout [%s] without a matching "
+                              "BeginLayerTransaction"),
+                         *GetName()))
+    {
+        if (FBlazeTraceRecorder::IsRecording())
+        {
+            FBlazeTraceRecorder::RecordLayoutOp(EBlazeTraceOp::CommitTransaction, *this);
+        }
+        LayerTransactionDepth--;
+        if (0 == LayerTransactionDepth)
+        {
+            ApplyPendingLayerMutations();
+        }
+    }
+}
+
+void UBlazePrimaryLayout::ApplyPendingLayerMutations()
+{
+    if (PendingLayerMutations.IsEmpty())
+    {
+        return;
+    }
+
+    UE_LOGFMT(LogBlaze,
+              Verbose,
+              "[{Layout}] applying {Count} layer mutation(s) from committed layer transaction. World=[{WorldName}]",
+              GetName(),
+              PendingLayerMutations.Num(),
+              GetNameSafe(GetWorld()));
+
+    CSV_SCOPED_TIMING_STAT(Blaze, CommitTransaction);
+    FBlazeOperationTimer Timer(TEXT("CommitTransaction"), FGameplayTag::EmptyTag, GetOwningPlayer());
+
+    // Take ownership of the mutations so that any push or pop triggered from activation
+    // callbacks while applying them is processed directly rather than lost.
+    const auto Mutations = MoveTemp(PendingLayerMutations);
+    PendingLayerMutations.Reset();
+
+    // Layers are only rehydrated once all the mutations have been applied, as a layer that
+    // becomes empty part way through may receive new widgets later in the same pass
+    TGuardValue ApplyingGuard(bApplyingLayerMutations, true);
+
+    // Record the widgets that are displayed before anything is applied. Removing a displayed widget
+    // activates the widget below it, so these are removed last (and after any pushes onto the same layer)
+    // which ensures that intermediate widgets are never activated on the way down.
+    TArray<UCommonActivatableWidget*, TInlineAllocator<4>> DisplayedRemovals;
+    for (const auto& Mutation : Mutations)
+    {
+        if (Mutation.bRemove && Mutation.Widget)
+        {
+            if (const auto Layer = Layers.Find(Mutation.LayerName))
+            {
+                if (Layer->GetActiveWidget() == Mutation.Widget)
+                {
+                    DisplayedRemovals.Add(Mutation.Widget.Get());
+                }
+                else
+                {
+                    Layer->RemoveWidget(*Mutation.Widget);
+                }
+            }
+        }
+    }
+    // Only the last push onto each layer is displayed, so a UBlazeActivatableWidgetStack receives the earlier pushes
+    // without activating them. A plain stack activates every widget added to it, so each earlier push is activated
+    // and then immediately covered by the next push onto the same layer.
+    TMap<FGameplayTag, int32, TInlineSetAllocator<4>> LastPushIndices;
+    for (auto Index = 0; Index < Mutations.Num(); Index++)
+    {
+        if (!Mutations[Index].bRemove && Mutations[Index].Widget && Layers.Contains(Mutations[Index].LayerName))
+        {
+            LastPushIndices.Add(Mutations[Index].LayerName, Index);
+        }
+    }
+    for (auto Index = 0; Index < Mutations.Num(); Index++)
+    {
+        const auto& Mutation = Mutations[Index];
+        if (!Mutation.bRemove && Mutation.Widget)
+        {
+            if (const auto Layer = Layers.Find(Mutation.LayerName))
+            {
+                const auto Stack = Cast<UBlazeActivatableWidgetStack>(Layer->Container);
+                if (Stack && LastPushIndices.FindChecked(Mutation.LayerName) != Index)
+                {
+                    Stack->InsertWidgetInstance(*Mutation.Widget, Stack->GetNumWidgets());
+                }
+                else
+                {
+                    Layer->AddWidgetInstance(*Mutation.Widget);
+                }
+                if (Layer->Config.bClusterWidgets)
+                {
+                    FBlazeGarbageCollection::ClusterWidget(*Mutation.Widget);
+                }
+            }
+        }
+    }
+    for (const auto& Mutation : Mutations)
+    {
+        if (Mutation.bRemove && Mutation.Widget && DisplayedRemovals.Contains(Mutation.Widget.Get()))
+        {
+            if (const auto Layer = Layers.Find(Mutation.LayerName))
+            {
+                Layer->RemoveWidget(*Mutation.Widget);
+            }
+        }
+    }
+
+    for (auto& Layer : Layers)
+    {
+        if (Layer.Value.Config.DehydrateDepth > 0
+            && Mutations.ContainsByPredicate(
+                [&Layer](const auto& Mutation) { return Mutation.LayerName == Layer.Key; }))
+        {
+            DehydrateLayer(Layer.Value, Layer.Value.Config.DehydrateDepth);
+            RehydrateLayer(Layer.Key, Layer.Value);
+        }
+    }
+}
+
+int32 UBlazePrimaryLayout::DehydrateLayer(FBlazeLayer& Layer, const int32 Depth)
+{
+    auto Count{ 0 };
+    const auto Container = Layer.Container.Get();
+    // Copy the list as removing widgets from the container modifies it
+    const TArray<UCommonActivatableWidget*> Widgets(Container->GetWidgetList());
+
+    // Widgets are dehydrated from the bottom up so that DehydratedWidgets remains ordered from bottom to top
+    for (auto i = 0; i < Widgets.Num() - 1 - Depth; ++i)
+    {
+        const auto Widget = Widgets[i];
+        if (Widget && Container->GetActiveWidget() != Widget)
+        {
+            FBlazeDehydratedWidget Record;
+            Record.WidgetClass = Widget->GetClass();
+            Record.WidgetClassPath = Record.WidgetClass.Get();
+            SaveWidgetState(*Widget, Record.State);
+
+            // A widget that is not displayed is released without activating any other widget
+            Container->RemoveWidget(*Widget);
+            if (Container->GetWidgetList().Contains(Widget))
+            {
+                // The container could not release the widget (i.e. it has not constructed its Slate
+                // widget yet) so leave the remaining widgets alone
+                break;
+            }
+            else
+            {
+                Layer.DehydratedWidgets.Add(MoveTemp(Record));
+                Count++;
+            }
+        }
+    }
+
+    if (Count > 0)
+    {
+        UE_LOGFMT(LogBlaze,
+                  Verbose,
+                  "[{Layout}] dehydrated {Count} widget(s) on layer container [{Container}]. "
+                  "{DehydratedCount} widget(s) are dehydrated. World=[{WorldName}]",
+                  GetName(),
+                  Count,
+                  GetNameSafe(Container),
+                  Layer.DehydratedWidgets.Num(),
+                  GetNameSafe(GetWorld()));
+    }
+    return Count;
+}
+
+void UBlazePrimaryLayout::RehydrateLayer(const FGameplayTag& LayerName, FBlazeLayer& Layer)
+{
+    const auto Container = Layer.Container.Get();
+    // The layer keeps the displayed widget and DehydrateDepth widgets below it alive
+    const auto NumLive = Layer.Config.DehydrateDepth + 1;
+    if (const auto Stack = Cast<UBlazeActivatableWidgetStack>(Container))
+    {
+        // Each widget is inserted below the live widgets, so recreating the top-most dehydrated widget first keeps
+        // the order even when the first widget is displayed and this re-enters via OnDisplayedWidgetChanged
+        while (!Layer.DehydratedWidgets.IsEmpty() && !IsInLayerTransaction() && Stack->GetNumWidgets() < NumLive)
+        {
+            const auto Record = Layer.DehydratedWidgets.Pop();
+            RehydrateWidget(LayerName, Layer, Record);
+        }
+    }
+    else if (!Layer.DehydratedWidgets.IsEmpty() && !IsInLayerTransaction() && 0 == Container->GetNumWidgets())
+    {
+        // Other stacks only add widgets to the top, so the widgets are recreated from the bottom up once the layer
+        // is empty. Take the records first as adding a widget re-enters via OnDisplayedWidgetChanged.
+        const auto NumRecords = FMath::Min(NumLive, Layer.DehydratedWidgets.Num());
+        const auto FirstRecord = Layer.DehydratedWidgets.Num() - NumRecords;
+        const TArray<FBlazeDehydratedWidget> Records(Layer.DehydratedWidgets.GetData() + FirstRecord, NumRecords);
+        Layer.DehydratedWidgets.SetNum(FirstRecord);
+        for (const auto& Record : Records)
+        {
+            RehydrateWidget(LayerName, Layer, Record);
+        }
+    }
+}
+
+void UBlazePrimaryLayout::RehydrateWidget(const FGameplayTag& LayerName,
+                                          FBlazeLayer& Layer,
+                                          const FBlazeDehydratedWidget& Record)
+{
+    const auto Container = Layer.Container.Get();
+    // The class is only released under memory pressure, when a load is preferable to running out of memory
+    const auto WidgetClass = Record.WidgetClass ? Record.WidgetClass.Get() : Record.WidgetClassPath.LoadSynchronous();
+    if (WidgetClass)
+    {
+        UE_LOGFMT(LogBlaze,
+                  Verbose,
+                  "[{Layout}] rehydrating widget of class [{WidgetClass}] on layer container [{Container}]. "
+                  "World=[{WorldName}]",
+                  GetName(),
+                  GetNameSafe(WidgetClass),
+                  GetNameSafe(Container),
+                  GetNameSafe(GetWorld()));
+        const auto InitFunc = [&Record](UCommonActivatableWidget& Widget) { RestoreWidgetState(Widget, Record.State); };
+        const auto Stack = Cast<UBlazeActivatableWidgetStack>(Container);
+        const auto RehydratedWidget = Stack ? Stack->InsertWidget(WidgetClass, 0, InitFunc)
+                                            : Container->AddWidget<UCommonActivatableWidget>(WidgetClass, InitFunc);
+        if (RehydratedWidget && Layer.Config.bClusterWidgets)
+        {
+            FBlazeGarbageCollection::ClusterWidget(*RehydratedWidget);
+        }
+        if (RehydratedWidget && FBlazeTraceRecorder::IsRecording())
+        {
+            FBlazeTraceRecorder::RecordRehydrate(*this, LayerName, *RehydratedWidget);
+        }
+    }
+}
+
+void UBlazePrimaryLayout::OnLayerDisplayedWidgetChanged(UCommonActivatableWidget* Widget, const FGameplayTag LayerName)
+{
+    if (const auto Layer = Layers.Find(LayerName))
+    {
+        // The next change may be made by CommonUI, such as by the back handler, rather than by the layout
+        Layer->RefreshTransitionBudget();
+
+        // Navigation may have consumed the live widgets below the displayed widget so bring back dehydrated widgets
+        if (!bApplyingLayerMutations)
+        {
+            RehydrateLayer(LayerName, *Layer);
+        }
+    }
+}
+
+FBlazeMemoryReclaim UBlazePrimaryLayout::ReclaimMemory(const EBlazeMemoryPressure Pressure)
+{
+    FBlazeMemoryReclaim Reclaim;
+    for (auto& [LayerName, Layer] : Layers)
+    {
+        const auto Container = Layer.Container.Get();
+        if (EBlazeMemoryPressure::Medium <= Pressure && Container && Container->IsA<UCommonActivatableWidgetStack>()
+            && !IsInLayerTransaction())
+        {
+            if (!Container->OnDisplayedWidgetChanged().IsBoundToObject(this))
+            {
+                // A layer without a DehydrateDepth must still bring back the widgets dehydrated here
+                Container->OnDisplayedWidgetChanged().AddUObject(this,
+                                                                 &ThisClass::OnLayerDisplayedWidgetChanged,
+                                                                 LayerName);
+            }
+            Reclaim.DehydratedWidgets += DehydrateLayer(Layer, 0);
+        }
+        // Stacks pool the widgets they remove, which retains their classes and widget trees, and only the Blaze
+        // stack can discard that pool. The classes of the dehydrated widgets of other stacks are left untouched.
+        if (const auto Stack = Cast<UBlazeActivatableWidgetStack>(Container))
+        {
+            if (!Layer.Config.bPinWidgetClasses)
+            {
+                for (auto& Record : Layer.DehydratedWidgets)
+                {
+                    if (Record.WidgetClass)
+                    {
+                        Record.WidgetClass = nullptr;
+                        Reclaim.ReleasedWidgetClasses++;
+                    }
+                }
+            }
+            if (EBlazeMemoryPressure::Medium <= Pressure || !Layer.Config.bPinWidgetClasses)
+            {
+                Stack->ReleasePooledWidgets();
+            }
+        }
+    }
+    if (EBlazeMemoryPressure::High <= Pressure)
+    {
+        for (const auto& Feed : Feeds)
+        {
+            Reclaim.ReleasedFeedWidgets += Feed.Value->ReleaseUnusedEntryWidgets();
+        }
+    }
+
+    if (!Reclaim.IsEmpty())
+    {
+        UE_LOGFMT(LogBlaze,
+                  Verbose,
+                  "[{Layout}] released {Classes} widget class(es), dehydrated {Dehydrated} widget(s) and released "
+                  "{FeedWidgets} feed entry widget(s) in response to memory pressure. World=[{WorldName}]",
+                  GetName(),
+                  Reclaim.ReleasedWidgetClasses,
+                  Reclaim.DehydratedWidgets,
+                  Reclaim.ReleasedFeedWidgets,
+                  GetNameSafe(GetWorld()));
+    }
+    return Reclaim;
+}
+
+void UBlazePrimaryLayout::RecordCsvStats() const
+{
+#if CSV_PROFILER
+    for (const auto& Layer : Layers)
+    {
+        // Layouts for different players record into the same stat for a layer
+        FCsvProfiler::RecordCustomStat(Layer.Value.CsvStatName,
+                                       CSV_CATEGORY_INDEX(Blaze),
+                                       Layer.Value.GetNumWidgets(),
+                                       ECsvCustomStatOp::Accumulate);
+    }
+#endif
+}
+
 UCommonActivatableWidgetContainerBase* UBlazePrimaryLayout::GetLayer(const FGameplayTag LayerName) const
 {
     check(LayerName.IsValid());
-    return Layers.FindRef(LayerName);
+    const auto Layer = Layers.Find(LayerName);
+    return Layer ? Layer->Container.Get() : nullptr;
 }
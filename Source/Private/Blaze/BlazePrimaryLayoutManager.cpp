@@ -12,25 +12,92 @@
  * limitations under the License.
  */
 #include "Blaze/BlazePrimaryLayoutManager.h"
+#include "Blaze/BlazeFunctionLibrary.h"
+#include "Blaze/BlazeHeadlessPrimaryLayout.h"
+#include "Blaze/BlazeHitchDetector.h"
 #include "Blaze/BlazeLogging.h"
 #include "Blaze/BlazePrimaryLayout.h"
+#include "Blaze/BlazeProfiling.h"
 #include "Blaze/BlazeSubsystem.h"
+#include "Blaze/BlazeTrace.h"
+#include "Blaze/BlazeWidgetQuery.h"
+#include "CommonActivatableWidget.h"
 #include "Engine/GameInstance.h"
+#include "Engine/GameViewportClient.h"
 #include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BlazePrimaryLayoutManager)
 
+static TAutoConsoleVariable<float>
+    CVarBlazeJoinFrameBudgetMs(TEXT("Blaze.Join.FrameBudgetMs"),
+                               4.0f,
+                               TEXT("The time in milliseconds that a batched player join may spend "
+                                    "creating primary layouts each frame. "
+                                    "At least one layout is created per frame."),
+                               ECVF_Default);
+
 UWorld* UBlazePrimaryLayoutManager::GetWorld() const
 {
     return GetOuterUBlazeSubsystem()->GetGameInstance()->GetWorld();
 }
 
+void UBlazePrimaryLayoutManager::BeginDestroy()
+{
+    if (PendingPlayerJoinsHandle.IsValid())
+    {
+        FCoreDelegates::OnEndFrame.Remove(PendingPlayerJoinsHandle);
+        PendingPlayerJoinsHandle.Reset();
+    }
+    Super::BeginDestroy();
+}
+
 UBlazePrimaryLayout* UBlazePrimaryLayoutManager::GetPrimaryLayout(const ULocalPlayer* LocalPlayer) const
 {
     const auto Entry = nullptr != LocalPlayer ? PrimaryLayouts.FindByKey(LocalPlayer) : nullptr;
     return Entry ? Entry->PrimaryLayout : nullptr;
 }
 
+UBlazePrimaryLayout* UBlazePrimaryLayoutManager::GetLayoutForLayer(const ULocalPlayer* LocalPlayer,
+                                                                   const FGameplayTag LayerName) const
+{
+    const auto Layout = GetPrimaryLayout(LocalPlayer);
+    return Layout && SharedLayout && SharedLayout->HasLayer(LayerName) ? SharedLayout.Get() : Layout;
+}
+
+void UBlazePrimaryLayoutManager::AssignSharedWidgetOwner(UCommonActivatableWidget& Widget,
+                                                         const ULocalPlayer* PushingPlayer) const
+{
+    if (SharedLayout && Widget.IsIn(SharedLayout))
+    {
+        // The widget is not yet activated so it registers with the input router of the assigned player. The context
+        // is always assigned as the stack may reuse a pooled widget that still refers to a destroyed player.
+        const auto bPushingPlayerOwns = EBlazeSharedInputOwner::PushingPlayer == SharedInputOwner && PushingPlayer;
+        const auto Owner = bPushingPlayerOwns ? PushingPlayer : SharedLayoutOwner.Get();
+        if (Owner)
+        {
+            Widget.SetPlayerContext(FLocalPlayerContext(Owner));
+        }
+    }
+}
+
+int32 UBlazePrimaryLayoutManager::PopAllSharedWidgets(const ULocalPlayer* LocalPlayer,
+                                                      const FBlazeWidgetQuery& Query) const
+{
+    if (SharedLayout)
+    {
+        const auto bOwnedOnly = EBlazeSharedInputOwner::PushingPlayer == SharedInputOwner;
+        return SharedLayout->PopAll([&Query, LocalPlayer, bOwnedOnly](const auto& LayerName, const auto& Widget) {
+            return (!bOwnedOnly || Widget.GetOwningLocalPlayer() == LocalPlayer) && Query.Matches(LayerName, Widget);
+        });
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 UBlazePrimaryLayout* UBlazePrimaryLayoutManager::CreatePrimaryLayout(APlayerController* const PlayerController)
 {
     checkf(false,
@@ -39,6 +106,101 @@ UBlazePrimaryLayout* UBlazePrimaryLayoutManager::CreatePrimaryLayout(APlayerCont
     return nullptr;
 }
 
+UBlazePrimaryLayout* UBlazePrimaryLayoutManager::CreateSharedLayout(APlayerController* PlayerController)
+{
+    return nullptr;
+}
+
+void UBlazePrimaryLayoutManager::PrepareToCreatePrimaryLayouts(int32 NumPlayers) {}
+
+void UBlazePrimaryLayoutManager::TryCreateSharedLayout(ULocalPlayer* LocalPlayer,
+                                                       APlayerController* PlayerController)
+{
+    if (const auto NewSharedLayout = CreateSharedLayout(PlayerController))
+    {
+        UE_LOGFMT(LogBlaze,
+                  Log,
+                  "[{LayoutManager}]: Adding the shared layout [{SharedLayout}] to the viewport "
+                  "owned by player [{LocalPlayer}](ControllerId={ControllerId}). World=[{WorldName}]",
+                  GetName(),
+                  NewSharedLayout->GetName(),
+                  GetNameSafe(LocalPlayer),
+                  LocalPlayer->GetControllerId(),
+                  GetNameSafe(GetWorld()));
+
+        SharedLayout = NewSharedLayout;
+        SharedLayoutOwner = LocalPlayer;
+        SharedLayout->SetPlayerContext(FLocalPlayerContext(LocalPlayer));
+        // The shared layout spans the whole viewport rather than the screen region of its owning player
+        if (LocalPlayer->ViewportClient && !SharedLayout->IsA<UBlazeHeadlessPrimaryLayout>())
+        {
+            SharedLayout->AddToViewport(SharedLayoutZOrder);
+        }
+    }
+}
+
+void UBlazePrimaryLayoutManager::ReleaseSharedWidgets(const ULocalPlayer* LocalPlayer)
+{
+    if (SharedLayout)
+    {
+        if (EBlazeSharedInputOwner::PushingPlayer == SharedInputOwner)
+        {
+            SharedLayout->PopAll([LocalPlayer](const auto&, const auto& Widget) {
+                return Widget.GetOwningLocalPlayer() == LocalPlayer;
+            });
+        }
+
+        if (SharedLayoutOwner == LocalPlayer)
+        {
+            if (PrimaryLayouts.IsEmpty())
+            {
+                UE_LOGFMT(LogBlaze,
+                          Log,
+                          "[{LayoutManager}]: Releasing the shared layout [{SharedLayout}] "
+                          "as the last player has been destroyed. World=[{WorldName}]",
+                          GetName(),
+                          SharedLayout->GetName(),
+                          GetNameSafe(GetWorld()));
+                SharedLayout->CancelAllPushRequests();
+                SharedLayout->CancelRestoreSnapshot();
+                SharedLayout->RemoveFromParent();
+                SharedLayout = nullptr;
+                SharedLayoutOwner = nullptr;
+            }
+            else
+            {
+                // Transfer the layout and the widgets that it owned on behalf of the destroyed player
+                const auto NewOwner = PrimaryLayouts[0].LocalPlayer;
+                const FLocalPlayerContext PlayerContext(NewOwner);
+                SharedLayout->SetPlayerContext(PlayerContext);
+                for (const auto& Layer : SharedLayout->Layers)
+                {
+                    TArray<UCommonActivatableWidget*> Widgets;
+                    SharedLayout->GetLayerWidgets(Layer.Key, Widgets);
+                    for (const auto Widget : Widgets)
+                    {
+                        if (Widget->GetOwningLocalPlayer() == LocalPlayer)
+                        {
+                            Widget->SetPlayerContext(PlayerContext);
+                        }
+                    }
+                }
+                SharedLayoutOwner = NewOwner;
+
+                UE_LOGFMT(LogBlaze,
+                          Log,
+                          "[{LayoutManager}]: Transferred the shared layout [{SharedLayout}] to player "
+                          "[{LocalPlayer}](ControllerId={ControllerId}). World=[{WorldName}]",
+                          GetName(),
+                          SharedLayout->GetName(),
+                          GetNameSafe(NewOwner),
+                          NewOwner ? NewOwner->GetControllerId() : -1,
+                          GetNameSafe(GetWorld()));
+            }
+        }
+    }
+}
+
 void UBlazePrimaryLayoutManager::TryCreateAndAddPrimaryLayoutToViewport(ULocalPlayer* LocalPlayer)
 {
     if (const auto Entry = PrimaryLayouts.FindByKey(LocalPlayer))
@@ -62,12 +224,30 @@ void UBlazePrimaryLayoutManager::TryCreateAndAddPrimaryLayoutToViewport(ULocalPl
                       GetNameSafe(GetWorld()));
         }
     }
-    else if (const auto PlayerController = LocalPlayer->GetPlayerController(GetWorld()))
+    else if (const auto NewPrimaryLayout = CreatePrimaryLayoutForPlayer(LocalPlayer))
     {
+        PrimaryLayouts.FindByKey(LocalPlayer)->bAddedToViewport = true;
+        AddPrimaryLayoutToViewport(LocalPlayer, NewPrimaryLayout);
+        if (!SharedLayout)
+        {
+            TryCreateSharedLayout(LocalPlayer, LocalPlayer->GetPlayerController(GetWorld()));
+        }
+    }
+}
+
+UBlazePrimaryLayout* UBlazePrimaryLayoutManager::CreatePrimaryLayoutForPlayer(ULocalPlayer* LocalPlayer)
+{
+    if (const auto PlayerController = LocalPlayer->GetPlayerController(GetWorld()))
+    {
+        // Adding the layout to the viewport is timed separately as AddLayout, so creation has its own operation
+        CSV_SCOPED_TIMING_STAT(Blaze, CreateLayout);
+        FBlazeOperationTimer Timer(TEXT("CreateLayout"), FGameplayTag::EmptyTag, PlayerController);
         if (const auto NewPrimaryLayout = CreatePrimaryLayout(PlayerController))
         {
-            PrimaryLayouts.Emplace(LocalPlayer, NewPrimaryLayout, true);
-            AddPrimaryLayoutToViewport(LocalPlayer, NewPrimaryLayout);
+            Timer.SetWidgetClass(NewPrimaryLayout->GetClass());
+            Timer.MarkConstructed();
+            PrimaryLayouts.Emplace(LocalPlayer, NewPrimaryLayout, false);
+            return NewPrimaryLayout;
         }
         else
         {
@@ -77,17 +257,114 @@ void UBlazePrimaryLayoutManager::TryCreateAndAddPrimaryLayoutToViewport(ULocalPl
                       "(ControllerId={ControllerId}) in World=[{WorldName}]",
                       GetName(),
                       GetNameSafe(LocalPlayer),
-                      LocalPlayer ? LocalPlayer->GetControllerId() : -1,
+                      LocalPlayer->GetControllerId(),
                       GetNameSafe(GetWorld()));
+            return nullptr;
+        }
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void UBlazePrimaryLayoutManager::FlushPendingPlayerJoins()
+{
+    ProcessPendingPlayerJoins(TNumericLimits<double>::Max());
+}
+
+void UBlazePrimaryLayoutManager::ProcessPendingPlayerJoins(const double BudgetSeconds)
+{
+    // Players may have been destroyed or garbage collected since they were added
+    PendingPlayerJoins.RemoveAll([](const auto& LocalPlayer) { return nullptr == LocalPlayer; });
+    if (!PendingPlayerJoins.IsEmpty())
+    {
+        UE_LOGFMT(LogBlaze,
+                  Verbose,
+                  "[{LayoutManager}]: Processing {NumPlayers} pending player joins. World=[{WorldName}]",
+                  GetName(),
+                  PendingPlayerJoins.Num(),
+                  GetNameSafe(GetWorld()));
+
+        PrepareToCreatePrimaryLayouts(PendingPlayerJoins.Num());
+
+        // Create every layout that fits within the budget before any is added so that the viewport is laid out
+        // once for the step rather than once per player
+        TArray<TPair<ULocalPlayer*, UBlazePrimaryLayout*>> CreatedLayouts;
+        const double StartTime = FPlatformTime::Seconds();
+        auto Index{ 0 };
+        while (Index < PendingPlayerJoins.Num())
+        {
+            const auto LocalPlayer = PendingPlayerJoins[Index].Get();
+            if (!LocalPlayer->GetPlayerController(GetWorld()))
+            {
+                // The player controller has not been spawned yet so the join remains pending for a later frame
+                Index++;
+            }
+            else
+            {
+                PendingPlayerJoins.RemoveAt(Index);
+                if (const auto NewPrimaryLayout = CreatePrimaryLayoutForPlayer(LocalPlayer))
+                {
+                    CreatedLayouts.Emplace(LocalPlayer, NewPrimaryLayout);
+                }
+                if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (CreatedLayouts.Num() > 1)
+        {
+            // Apply the split-screen layout for every joined player before the layouts are sized to their regions
+            if (const auto ViewportClient = CreatedLayouts[0].Key->ViewportClient)
+            {
+                ViewportClient->LayoutPlayers();
+            }
+        }
+        for (const auto& [LocalPlayer, Layout] : CreatedLayouts)
+        {
+            PrimaryLayouts.FindByKey(LocalPlayer)->bAddedToViewport = true;
+            AddPrimaryLayoutToViewport(LocalPlayer, Layout);
+        }
+        if (!SharedLayout && !CreatedLayouts.IsEmpty())
+        {
+            const auto LocalPlayer = CreatedLayouts[0].Key;
+            TryCreateSharedLayout(LocalPlayer, LocalPlayer->GetPlayerController(GetWorld()));
         }
     }
+
+    if (PendingPlayerJoins.IsEmpty() && PendingPlayerJoinsHandle.IsValid())
+    {
+        FCoreDelegates::OnEndFrame.Remove(PendingPlayerJoinsHandle);
+        PendingPlayerJoinsHandle.Reset();
+    }
 }
 
 void UBlazePrimaryLayoutManager::NotifyPlayerAdded(ULocalPlayer* LocalPlayer)
 {
     if (ensureAlways(LocalPlayer))
     {
-        TryCreateAndAddPrimaryLayoutToViewport(LocalPlayer);
+        if (FBlazeTraceRecorder::IsRecording())
+        {
+            FBlazeTraceRecorder::RecordPlayerOp(EBlazeTraceOp::PlayerAdded, LocalPlayer);
+        }
+        if (bBatchPlayerJoins && !PrimaryLayouts.FindByKey(LocalPlayer))
+        {
+            PendingPlayerJoins.AddUnique(LocalPlayer);
+            if (!PendingPlayerJoinsHandle.IsValid())
+            {
+                PendingPlayerJoinsHandle = FCoreDelegates::OnEndFrame.AddWeakLambda(this, [this] {
+                    const auto BudgetMs = FMath::Max(0.f, CVarBlazeJoinFrameBudgetMs.GetValueOnGameThread());
+                    ProcessPendingPlayerJoins(BudgetMs / 1000.0);
+                });
+            }
+        }
+        else
+        {
+            TryCreateAndAddPrimaryLayoutToViewport(LocalPlayer);
+        }
     }
 }
 
@@ -95,8 +372,17 @@ void UBlazePrimaryLayoutManager::NotifyPlayerRemoved(ULocalPlayer* LocalPlayer)
 {
     if (ensureAlways(LocalPlayer))
     {
+        if (FBlazeTraceRecorder::IsRecording())
+        {
+            FBlazeTraceRecorder::RecordPlayerOp(EBlazeTraceOp::PlayerRemoved, LocalPlayer);
+        }
+        PendingPlayerJoins.Remove(LocalPlayer);
         if (const auto Layout = PrimaryLayouts.FindByKey(LocalPlayer))
         {
+            // Nobody will see the widgets for a removed player, so stop loading them and release the
+            // input suspended on behalf of the player straight away
+            Layout->PrimaryLayout->CancelAllPushRequests();
+            Layout->PrimaryLayout->CancelRestoreSnapshot();
             RemovePrimaryLayoutFromViewport(LocalPlayer, Layout->PrimaryLayout);
             Layout->bAddedToViewport = false;
         }
@@ -108,6 +394,10 @@ void UBlazePrimaryLayoutManager::NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer
     if (ensureAlways(LocalPlayer))
     {
         NotifyPlayerRemoved(LocalPlayer);
+        if (FBlazeTraceRecorder::IsRecording())
+        {
+            FBlazeTraceRecorder::RecordPlayerOp(EBlazeTraceOp::PlayerDestroyed, LocalPlayer);
+        }
         const auto EntryIndex = PrimaryLayouts.IndexOfByKey(LocalPlayer);
         if (INDEX_NONE != EntryIndex)
         {
@@ -118,6 +408,7 @@ void UBlazePrimaryLayoutManager::NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer
             RemovePrimaryLayoutFromViewport(LocalPlayer, Entry);
             OnPrimaryLayoutReleased(LocalPlayer, Entry);
         }
+        ReleaseSharedWidgets(LocalPlayer);
     }
 }
 
@@ -128,6 +419,9 @@ int UBlazePrimaryLayoutManager::GetAddLayoutToPlayerScreenZOrder(ULocalPlayer* L
 
 void UBlazePrimaryLayoutManager::AddPrimaryLayoutToViewport(ULocalPlayer* LocalPlayer, UBlazePrimaryLayout* Layout)
 {
+    CSV_SCOPED_TIMING_STAT(Blaze, AddLayout);
+    FBlazeOperationTimer Timer(TEXT("AddLayout"), FGameplayTag::EmptyTag, LocalPlayer, Layout->GetClass());
+
     UE_LOGFMT(LogBlaze,
               Log,
               "[{LayoutManager}]: Adding the primary layout [{PrimaryLayout}] "
@@ -140,15 +434,20 @@ void UBlazePrimaryLayoutManager::AddPrimaryLayoutToViewport(ULocalPlayer* LocalP
               GetNameSafe(GetWorld()));
 
     Layout->SetPlayerContext(FLocalPlayerContext(LocalPlayer));
-    Layout->AddToPlayerScreen(GetAddLayoutToPlayerScreenZOrder(LocalPlayer));
+    // A player without a viewport, such as one created by an automation test, has no screen to add the layout to
+    // and a headless layout is never displayed
+    if (LocalPlayer->ViewportClient && !Layout->IsA<UBlazeHeadlessPrimaryLayout>())
+    {
+        Layout->AddToPlayerScreen(GetAddLayoutToPlayerScreenZOrder(LocalPlayer));
 
 #if WITH_EDITOR
-    if (GIsEditor && LocalPlayer->IsPrimaryPlayer())
-    {
-        // So our controller will work in PIE without needing to click in the viewport
-        FSlateApplication::Get().SetUserFocusToGameViewport(0);
-    }
+        if (GIsEditor && LocalPlayer->IsPrimaryPlayer())
+        {
+            // So our controller will work in PIE without needing to click in the viewport
+            FSlateApplication::Get().SetUserFocusToGameViewport(0);
+        }
 #endif
+    }
 
     OnPrimaryLayoutAddedToViewport(LocalPlayer, Layout);
 }
@@ -159,6 +458,8 @@ void UBlazePrimaryLayoutManager::RemovePrimaryLayoutFromViewport(ULocalPlayer* L
     const TWeakPtr<SWidget> WeakWidget = Layout->GetCachedWidget();
     if (WeakWidget.IsValid())
     {
+        CSV_SCOPED_TIMING_STAT(Blaze, RemoveLayout);
+        FBlazeOperationTimer Timer(TEXT("RemoveLayout"), FGameplayTag::EmptyTag, LocalPlayer, Layout->GetClass());
         UE_LOGFMT(LogBlaze,
                   Log,
                   "[{LayoutManager}]: Removing the primary layout [{PrimaryLayout}] "
@@ -199,3 +500,35 @@ void UBlazePrimaryLayoutManager::OnPrimaryLayoutRemovedFromViewport(ULocalPlayer
 }
 
 void UBlazePrimaryLayoutManager::OnPrimaryLayoutReleased(ULocalPlayer* LocalPlayer, UBlazePrimaryLayout* Layout) {}
+
+int32 UBlazePrimaryLayoutManager::GetNumInputSuspendedPlayers() const
+{
+    // Input type filters set by other systems are not counted as only the suspensions Blaze created are tracked
+    auto NumInputSuspendedPlayers{ 0 };
+    for (const auto& Entry : PrimaryLayouts)
+    {
+        if (UBlazeFunctionLibrary::IsInputSuspendedForPlayer(Entry.LocalPlayer))
+        {
+            NumInputSuspendedPlayers++;
+        }
+    }
+    return NumInputSuspendedPlayers;
+}
+
+void UBlazePrimaryLayoutManager::RecordCsvStats() const
+{
+#if CSV_PROFILER
+    for (const auto& Entry : PrimaryLayouts)
+    {
+        if (Entry.PrimaryLayout)
+        {
+            Entry.PrimaryLayout->RecordCsvStats();
+        }
+    }
+    if (SharedLayout)
+    {
+        SharedLayout->RecordCsvStats();
+    }
+    CSV_CUSTOM_STAT(Blaze, InputSuspendedPlayers, GetNumInputSuspendedPlayers(), ECsvCustomStatOp::Accumulate);
+#endif
+}
@@ -0,0 +1,444 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazePushRequest.h"
+#include "Blaze/BlazeDependencyClosure.h"
+#include "Blaze/BlazeFunctionLibrary.h"
+#include "Blaze/BlazeHitchDetector.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blaze/BlazePayloadReceiver.h"
+#include "Blaze/BlazePrimaryLayout.h"
+#include "Blaze/BlazeProfiling.h"
+#include "Blaze/BlazeResidencyGate.h"
+#include "CommonActivatableWidget.h"
+#include "Containers/ChunkedArray.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/GCObject.h"
+
+/** The state of a single push request. */
+struct FBlazePushRequestSlot
+{
+    /** The serial of the request occupying the slot. Incremented each time the slot is recycled. */
+    uint32 Serial{ 0 };
+
+    /** The number of FBlazePushRequest handles that reference the slot. */
+    int32 RefCount{ 0 };
+
+    EBlazePushRequestStatus Status{ EBlazePushRequestStatus::Invalid };
+
+    /** True once the widget class has loaded, after which the request can no longer be canceled. */
+    bool bLoaded{ false };
+
+    /** True if the pushed widget remains collapsed until the textures it references are resident. */
+    bool bRevealWhenResident{ false };
+
+    TWeakObjectPtr<UBlazePrimaryLayout> Layout{ nullptr };
+
+    TWeakObjectPtr<APlayerController> PlayerController{ nullptr };
+
+    FGameplayTag LayerName{ FGameplayTag::EmptyTag };
+
+    TSoftClassPtr<UCommonActivatableWidget> WidgetClass{ nullptr };
+
+    FName SuspendInputToken{ NAME_None };
+
+    /** The time at which the request was started, used to report the load time of slow requests. */
+    double StartTime{ 0.0 };
+
+    TSharedPtr<FStreamableHandle> Handle;
+
+    FBlazePushRequestDelegate Delegate;
+
+    /** The payload delivered to the widget once it has been created. */
+    FInstancedStruct Payload;
+
+    TWeakObjectPtr<UCommonActivatableWidget> Widget{ nullptr };
+};
+
+// The pool is only accessed from the game thread so it is not synchronised.
+// Chunked storage keeps slots at a stable address while the pool grows, so a slot can be safely
+// referenced while a delegate that issues further requests is executing.
+static TChunkedArray<FBlazePushRequestSlot> Slots;
+static TArray<uint32> FreeSlots;
+static int32 NumLiveRequests{ 0 };
+static int32 NumPendingRequests{ 0 };
+
+/** Reports the objects referenced by the payloads of pending requests, as the pool is not a UObject. */
+class FBlazePushRequestPayloadReferences final : public FGCObject
+{
+public:
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+    {
+        for (auto i = 0; i < Slots.Num(); ++i)
+        {
+            if (Slots[i].Payload.IsValid())
+            {
+                Slots[i].Payload.AddStructReferencedObjects(Collector);
+            }
+        }
+    }
+
+    virtual FString GetReferencerName() const override { return TEXT("FBlazePushRequestPayloadReferences"); }
+};
+
+static FBlazePushRequestSlot* FindSlot(const uint32 Index, const uint32 Serial)
+{
+    check(IsInGameThread());
+    if (0 != Serial && Index < static_cast<uint32>(Slots.Num()) && Serial == Slots[Index].Serial)
+    {
+        return &Slots[Index];
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+static uint32 AllocateSlot()
+{
+    check(IsInGameThread());
+    NumLiveRequests++;
+    if (FreeSlots.IsEmpty())
+    {
+        const auto Index = static_cast<uint32>(Slots.Add(1));
+        Slots[Index].Serial = 1;
+        return Index;
+    }
+    else
+    {
+        return FreeSlots.Pop();
+    }
+}
+
+static void ResumeInput(FBlazePushRequestSlot& Slot)
+{
+    if (NAME_None != Slot.SuspendInputToken)
+    {
+        if (const auto PlayerController = Slot.PlayerController.Get())
+        {
+            UBlazeFunctionLibrary::ResumeInputForPlayer(PlayerController, Slot.SuspendInputToken);
+        }
+        Slot.SuspendInputToken = NAME_None;
+    }
+}
+
+static void FreeSlot(const uint32 Index)
+{
+    auto& Slot = Slots[Index];
+    const auto NextSerial = Slot.Serial + 1;
+    Slot = FBlazePushRequestSlot();
+    // Serial 0 is reserved for empty handles
+    Slot.Serial = 0 == NextSerial ? 1 : NextSerial;
+    FreeSlots.Push(Index);
+    NumLiveRequests--;
+}
+
+FBlazePushRequest::FBlazePushRequest(const uint32 InIndex, const uint32 InSerial) : Index(InIndex), Serial(InSerial)
+{
+    AddRef();
+}
+
+FBlazePushRequest::FBlazePushRequest(const FBlazePushRequest& Other) : Index(Other.Index), Serial(Other.Serial)
+{
+    AddRef();
+}
+
+FBlazePushRequest::FBlazePushRequest(FBlazePushRequest&& Other) : Index(Other.Index), Serial(Other.Serial)
+{
+    Other.Index = 0;
+    Other.Serial = 0;
+}
+
+FBlazePushRequest& FBlazePushRequest::operator=(const FBlazePushRequest& Other)
+{
+    if (this != &Other)
+    {
+        Other.AddRef();
+        Release();
+        Index = Other.Index;
+        Serial = Other.Serial;
+    }
+    return *this;
+}
+
+FBlazePushRequest& FBlazePushRequest::operator=(FBlazePushRequest&& Other)
+{
+    if (this != &Other)
+    {
+        Release();
+        Index = Other.Index;
+        Serial = Other.Serial;
+        Other.Index = 0;
+        Other.Serial = 0;
+    }
+    return *this;
+}
+
+FBlazePushRequest::~FBlazePushRequest()
+{
+    Release();
+}
+
+EBlazePushRequestStatus FBlazePushRequest::GetStatus() const
+{
+    const auto Slot = FindSlot(Index, Serial);
+    return Slot ? Slot->Status : EBlazePushRequestStatus::Invalid;
+}
+
+FGameplayTag FBlazePushRequest::GetLayerName() const
+{
+    const auto Slot = FindSlot(Index, Serial);
+    return Slot ? Slot->LayerName : FGameplayTag::EmptyTag;
+}
+
+FSoftObjectPath FBlazePushRequest::GetWidgetClassPath() const
+{
+    const auto Slot = FindSlot(Index, Serial);
+    return Slot ? Slot->WidgetClass.ToSoftObjectPath() : FSoftObjectPath();
+}
+
+UCommonActivatableWidget* FBlazePushRequest::GetWidget() const
+{
+    const auto Slot = FindSlot(Index, Serial);
+    return Slot ? Slot->Widget.Get() : nullptr;
+}
+
+void FBlazePushRequest::Cancel()
+{
+    const auto Slot = FindSlot(Index, Serial);
+    if (Slot && EBlazePushRequestStatus::Pending == Slot->Status && !Slot->bLoaded)
+    {
+        // Canceling the handle invokes the cancel delegate which finishes the request,
+        // so take a copy of the handle as the slot releases its reference when finished
+        const auto Handle = Slot->Handle;
+        if (Handle.IsValid())
+        {
+            Handle->CancelHandle();
+        }
+        // Finish the request in case the handle had already completed and so did not invoke the cancel delegate
+        Finish(Index, Serial, EBlazePushWidgetToLayerState::Canceled, nullptr);
+    }
+}
+
+void FBlazePushRequest::Reset()
+{
+    Release();
+}
+
+int32 FBlazePushRequest::GetNumLiveRequests()
+{
+    return NumLiveRequests;
+}
+
+int32 FBlazePushRequest::GetNumPendingRequests()
+{
+    return NumPendingRequests;
+}
+
+void FBlazePushRequest::AddRef() const
+{
+    if (IsValid())
+    {
+        const auto Slot = FindSlot(Index, Serial);
+        check(Slot);
+        Slot->RefCount++;
+    }
+}
+
+void FBlazePushRequest::Release()
+{
+    if (IsValid())
+    {
+        if (const auto Slot = FindSlot(Index, Serial))
+        {
+            check(Slot->RefCount > 0);
+            // A pending request retains its slot until it finishes, even if every handle has been released
+            if (0 == --Slot->RefCount && EBlazePushRequestStatus::Pending != Slot->Status)
+            {
+                FreeSlot(Index);
+            }
+        }
+        Index = 0;
+        Serial = 0;
+    }
+}
+
+FBlazePushRequest FBlazePushRequest::Start(UBlazePrimaryLayout& Layout,
+                                           const FGameplayTag& LayerName,
+                                           const bool bSuspendInputUntilComplete,
+                                           const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass,
+                                           FInstancedStruct&& Payload,
+                                           FBlazePushRequestDelegate&& Delegate,
+                                           const bool bRevealWhenResident)
+{
+    static const auto NAME_PushWidgetToLayer("PushWidgetToLayer");
+
+    const auto SlotIndex = AllocateSlot();
+    auto& Slot = Slots[SlotIndex];
+    FBlazePushRequest Request(SlotIndex, Slot.Serial);
+
+    const auto PlayerController = Layout.GetOwningPlayer();
+    Slot.Status = EBlazePushRequestStatus::Pending;
+    NumPendingRequests++;
+    Slot.Layout = &Layout;
+    Slot.PlayerController = PlayerController;
+    Slot.LayerName = LayerName;
+    Slot.WidgetClass = WidgetClass;
+    Slot.Delegate = MoveTemp(Delegate);
+    if (Payload.IsValid())
+    {
+        // Created on first use, once the garbage collector is available
+        static FBlazePushRequestPayloadReferences PayloadReferences;
+        Slot.Payload = MoveTemp(Payload);
+    }
+    Slot.bRevealWhenResident = bRevealWhenResident;
+    Slot.StartTime = FPlatformTime::Seconds();
+    Slot.SuspendInputToken = bSuspendInputUntilComplete
+        ? UBlazeFunctionLibrary::SuspendInputForPlayer(PlayerController, NAME_PushWidgetToLayer)
+        : NAME_None;
+
+    // The closure is usually cached, in which case the load begins before Request returns
+    const auto RequestIndex = Request.Index;
+    const auto RequestSerial = Request.Serial;
+    FBlazeDependencyClosure::Request(WidgetClass.ToSoftObjectPath(),
+                                     [RequestIndex, RequestSerial](const TArray<FSoftObjectPath>& Paths) {
+                                         BeginLoad(RequestIndex, RequestSerial, Paths);
+                                     });
+
+    // A request that could not begin loading is reported as an empty handle
+    return EBlazePushRequestStatus::Canceled == Slot.Status ? FBlazePushRequest() : MoveTemp(Request);
+}
+
+void FBlazePushRequest::BeginLoad(const uint32 InIndex, const uint32 InSerial, const TArray<FSoftObjectPath>& Paths)
+{
+    // The request may have been canceled while the dependency closure was computed
+    const auto Slot = FindSlot(InIndex, InSerial);
+    if (Slot && EBlazePushRequestStatus::Pending == Slot->Status)
+    {
+        const auto Handle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
+            Paths,
+            FStreamableDelegate::CreateLambda([InIndex, InSerial] { OnLoaded(InIndex, InSerial); }));
+
+        if (!Handle.IsValid())
+        {
+            Finish(InIndex, InSerial, EBlazePushWidgetToLayerState::Canceled, nullptr);
+        }
+        // The load may have completed before RequestAsyncLoad returned
+        else if (EBlazePushRequestStatus::Pending == Slot->Status && !Slot->bLoaded)
+        {
+            Slot->Handle = Handle;
+            Handle->BindCancelDelegate(FStreamableDelegate::CreateLambda([InIndex, InSerial] {
+                Finish(InIndex, InSerial, EBlazePushWidgetToLayerState::Canceled, nullptr);
+            }));
+        }
+    }
+}
+
+void FBlazePushRequest::OnLoaded(const uint32 InIndex, const uint32 InSerial)
+{
+    const auto Slot = FindSlot(InIndex, InSerial);
+    if (Slot && EBlazePushRequestStatus::Pending == Slot->Status)
+    {
+        Slot->bLoaded = true;
+        Slot->Handle.Reset();
+
+        CSV_SCOPED_TIMING_STAT(Blaze, AsyncPush);
+        FBlazeOperationTimer Timer(TEXT("AsyncPush"), Slot->LayerName, Slot->PlayerController.Get());
+        Timer.SetLoadSeconds(FPlatformTime::Seconds() - Slot->StartTime);
+
+        // Resume input before the widget is pushed so that the widget can establish its own input configuration
+        ResumeInput(*Slot);
+
+        const auto Layout = Slot->Layout.Get();
+        const auto ResolvedClass = Slot->WidgetClass.Get();
+        if (Layout && ResolvedClass)
+        {
+            const auto LayerName = Slot->LayerName;
+            const auto InitFunc = [InIndex, InSerial](auto& WidgetToInit) {
+                if (const auto InitSlot = FindSlot(InIndex, InSerial))
+                {
+                    if (InitSlot->bRevealWhenResident)
+                    {
+                        // Hold the widget before it is added to the layer so that it is never painted unresolved
+                        FBlazeResidencyGate::Hold(WidgetToInit);
+                    }
+                    if (InitSlot->Payload.IsValid())
+                    {
+                        UBlazePrimaryLayout::DeliverPayload(WidgetToInit, MoveTemp(InitSlot->Payload));
+                    }
+                    InitSlot->Delegate.ExecuteIfBound(EBlazePushWidgetToLayerState::Initialize, &WidgetToInit);
+                }
+            };
+            if (const auto Widget =
+                    Layout->PushWidgetToLayer<UCommonActivatableWidget>(LayerName, ResolvedClass, InitFunc))
+            {
+                Finish(InIndex, InSerial, EBlazePushWidgetToLayerState::AfterPush, Widget);
+            }
+            else
+            {
+                UE_LOGFMT(LogBlaze,
+                          Warning,
+                          "PushWidgetToLayerAsync"
+                          "((Layout=[{Layout}] Layer=[{LayerName}] WidgetClass=[{WidgetClass}])) "
+                          "failed because the layer was not available or widget creation failed. "
+                          "World=[{WorldName}]",
+                          Layout->GetName(),
+                          LayerName.GetTagName(),
+                          GetNameSafe(ResolvedClass),
+                          GetNameSafe(Layout->GetWorld()));
+                Finish(InIndex, InSerial, EBlazePushWidgetToLayerState::Canceled, nullptr);
+            }
+        }
+        else
+        {
+            Finish(InIndex, InSerial, EBlazePushWidgetToLayerState::Canceled, nullptr);
+        }
+    }
+}
+
+void FBlazePushRequest::Finish(const uint32 InIndex,
+                               const uint32 InSerial,
+                               const EBlazePushWidgetToLayerState State,
+                               UCommonActivatableWidget* Widget)
+{
+    const auto Slot = FindSlot(InIndex, InSerial);
+    if (Slot && EBlazePushRequestStatus::Pending == Slot->Status)
+    {
+        // Hold a reference so that the slot is not recycled while the delegate executes
+        const FBlazePushRequest Request(InIndex, InSerial);
+
+        ResumeInput(*Slot);
+
+        NumPendingRequests--;
+        Slot->Status = EBlazePushWidgetToLayerState::AfterPush == State ? EBlazePushRequestStatus::Completed
+                                                                         : EBlazePushRequestStatus::Canceled;
+        Slot->Widget = Widget;
+        const auto Layout = Slot->Layout.Get();
+        Slot->Layout.Reset();
+        Slot->PlayerController.Reset();
+        Slot->WidgetClass.Reset();
+        Slot->Handle.Reset();
+        Slot->Payload.Reset();
+
+        const auto Delegate = MoveTemp(Slot->Delegate);
+        Slot->Delegate.Unbind();
+
+        if (Layout)
+        {
+            Layout->OnPushRequestFinished(Request);
+        }
+        Delegate.ExecuteIfBound(State, Widget);
+    }
+}
@@ -0,0 +1,309 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeResidencyGate.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "CommonActivatableWidget.h"
+#include "Containers/Ticker.h"
+#include "Engine/Font.h"
+#include "Engine/Texture.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInterface.h"
+#include "Rendering/SlateRenderer.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+static TAutoConsoleVariable<float>
+    CVarBlazeRevealResidencyTimeoutMs(TEXT("Blaze.Reveal.ResidencyTimeoutMs"),
+                                      250.0f,
+                                      TEXT("The maximum time in milliseconds that a widget pushed with "
+                                           "bRevealWhenResident remains collapsed while waiting for the "
+                                           "textures it references to stream in."),
+                                      ECVF_Default);
+
+/** A widget that is collapsed until the textures it references are resident. */
+struct FBlazeGatedWidget
+{
+    TWeakObjectPtr<UUserWidget> Widget{ nullptr };
+    ESlateVisibility Visibility{ ESlateVisibility::Visible };
+    TArray<TWeakObjectPtr<UTexture>> Textures;
+    double StartTime{ 0.0 };
+    double Deadline{ 0.0 };
+};
+
+/** A chain of struct properties that ends with an object property that may reference a resource. */
+using FBlazeResourcePropertyPath = TArray<const FProperty*, TInlineAllocator<4>>;
+
+/** The resource property paths of a class, and the property layout that they were computed from. */
+struct FBlazeResourceProperties
+{
+    const FField* ChildProperties{ nullptr };
+    int32 PropertiesSize{ 0 };
+    TArray<FBlazeResourcePropertyPath> Paths;
+};
+
+// The gate is only accessed from the game thread
+static TArray<FBlazeGatedWidget> GatedWidgets;
+static FTSTicker::FDelegateHandle GateTickerHandle;
+static TMap<TObjectKey<UClass>, FBlazeResourceProperties> ResourcePropertiesByClass;
+
+static bool MayReferenceResource(const UClass* PropertyClass)
+{
+    for (const auto ResourceClass :
+         { UTexture::StaticClass(), UMaterialInterface::StaticClass(), UFont::StaticClass() })
+    {
+        // Generic object properties such as FSlateBrush::ResourceObject may also hold a resource
+        if (PropertyClass->IsChildOf(ResourceClass) || ResourceClass->IsChildOf(PropertyClass))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void CollectResourcePropertyPaths(const UStruct& Struct,
+                                         FBlazeResourcePropertyPath& Path,
+                                         TArray<FBlazeResourcePropertyPath>& OutPaths)
+{
+    // Brushes and font infos are nested in structs so follow properties into structs but not into other objects
+    for (TFieldIterator<FProperty> It(&Struct); It; ++It)
+    {
+        if (const auto ObjectProperty = CastField<FObjectPropertyBase>(*It))
+        {
+            if (ObjectProperty->PropertyClass && MayReferenceResource(ObjectProperty->PropertyClass))
+            {
+                OutPaths.Add_GetRef(Path).Add(ObjectProperty);
+            }
+        }
+        else if (const auto StructProperty = CastField<FStructProperty>(*It))
+        {
+            Path.Add(StructProperty);
+            CollectResourcePropertyPaths(*StructProperty->Struct, Path, OutPaths);
+            Path.Pop();
+        }
+    }
+}
+
+static const TArray<FBlazeResourcePropertyPath>& GetResourcePropertyPaths(UClass& Class)
+{
+    // The layout is compared as a blueprint class that is recompiled in the editor keeps its identity
+    auto& Properties = ResourcePropertiesByClass.FindOrAdd(&Class);
+    if (Properties.ChildProperties != Class.ChildProperties || Properties.PropertiesSize != Class.GetPropertiesSize())
+    {
+        Properties.ChildProperties = Class.ChildProperties;
+        Properties.PropertiesSize = Class.GetPropertiesSize();
+        Properties.Paths.Reset();
+        FBlazeResourcePropertyPath Path;
+        CollectResourcePropertyPaths(Class, Path, Properties.Paths);
+    }
+    return Properties.Paths;
+}
+
+static void CollectObjectResources(const UObject* Object, TSet<UTexture*>& OutTextures, TSet<const UFont*>& OutFonts)
+{
+    if (const auto Texture = Cast<UTexture>(Object))
+    {
+        OutTextures.Add(const_cast<UTexture*>(Texture));
+    }
+    else if (const auto Material = Cast<UMaterialInterface>(Object))
+    {
+        TArray<UTexture*> MaterialTextures;
+        Material->GetUsedTextures(MaterialTextures, EMaterialQualityLevel::Num, true, ERHIFeatureLevel::Num, true);
+        OutTextures.Append(MaterialTextures);
+    }
+    else if (const auto Font = Cast<UFont>(Object))
+    {
+        OutFonts.Add(Font);
+    }
+}
+
+static void CollectWidgetResources(UUserWidget& UserWidget, TSet<UTexture*>& OutTextures, TSet<const UFont*>& OutFonts)
+{
+    const auto CollectFromWidget = [&OutTextures, &OutFonts](UWidget& Widget) {
+        for (const auto& Path : GetResourcePropertyPaths(*Widget.GetClass()))
+        {
+            const void* Container = &Widget;
+            for (auto i = 0; i < Path.Num() - 1; ++i)
+            {
+                Container = Path[i]->ContainerPtrToValuePtr<void>(Container);
+            }
+            const auto ObjectProperty = CastFieldChecked<const FObjectPropertyBase>(Path.Last());
+            for (auto Index = 0; Index < ObjectProperty->ArrayDim; ++Index)
+            {
+                if (const auto Object = ObjectProperty->GetObjectPropertyValue_InContainer(Container, Index))
+                {
+                    CollectObjectResources(Object, OutTextures, OutFonts);
+                }
+            }
+        }
+    };
+
+    CollectFromWidget(UserWidget);
+    if (UserWidget.WidgetTree)
+    {
+        UserWidget.WidgetTree->ForEachWidget([&](UWidget* Widget) {
+            if (Widget)
+            {
+                if (const auto NestedUserWidget = Cast<UUserWidget>(Widget))
+                {
+                    CollectWidgetResources(*NestedUserWidget, OutTextures, OutFonts);
+                }
+                else
+                {
+                    CollectFromWidget(*Widget);
+                }
+            }
+        });
+    }
+}
+
+static bool IsResident(const FBlazeGatedWidget& GatedWidget)
+{
+    for (const auto& WeakTexture : GatedWidget.Textures)
+    {
+        if (const auto Texture = WeakTexture.Get(); Texture && !Texture->IsFullyStreamedIn())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void Reveal(UUserWidget& Widget, const ESlateVisibility Visibility)
+{
+    // A widget that is no longer collapsed had its visibility changed while held, which is kept
+    if (ESlateVisibility::Collapsed == Widget.GetVisibility())
+    {
+        Widget.SetVisibility(Visibility);
+    }
+
+    // A widget activated while collapsed could not receive focus so focus the desired target once it is revealed
+    if (const auto ActivatableWidget = Cast<UCommonActivatableWidget>(&Widget);
+        ActivatableWidget && ActivatableWidget->IsActivated())
+    {
+        if (const auto FocusTarget = ActivatableWidget->GetDesiredFocusTarget())
+        {
+            FocusTarget->SetFocus();
+        }
+    }
+}
+
+bool FBlazeResidencyGate::Tick(float)
+{
+    check(IsInGameThread());
+
+    const auto Now = FPlatformTime::Seconds();
+    for (auto i = GatedWidgets.Num() - 1; i >= 0; --i)
+    {
+        const auto& GatedWidget = GatedWidgets[i];
+        if (const auto Widget = GatedWidget.Widget.Get())
+        {
+            const auto bResident = IsResident(GatedWidget);
+            if (bResident || Now >= GatedWidget.Deadline)
+            {
+                UE_LOGFMT(LogBlaze,
+                          Verbose,
+                          "Revealing widget [{Widget}] after {Duration}ms as {Reason}. World=[{WorldName}]",
+                          Widget->GetName(),
+                          (Now - GatedWidget.StartTime) * 1000.0,
+                          bResident ? TEXT("the textures it references are resident") : TEXT("the timeout elapsed"),
+                          GetNameSafe(Widget->GetWorld()));
+                const auto Visibility = GatedWidget.Visibility;
+                GatedWidgets.RemoveAtSwap(i);
+                Reveal(*Widget, Visibility);
+            }
+        }
+        else
+        {
+            GatedWidgets.RemoveAtSwap(i);
+        }
+    }
+
+    if (GatedWidgets.IsEmpty())
+    {
+        // The gate may also be ticked directly so remove the ticker rather than relying upon the return value
+        FTSTicker::GetCoreTicker().RemoveTicker(GateTickerHandle);
+        GateTickerHandle.Reset();
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+void FBlazeResidencyGate::Hold(UUserWidget& Widget)
+{
+    check(IsInGameThread());
+
+    if (IsHeld(Widget))
+    {
+        return;
+    }
+
+    TSet<UTexture*> Textures;
+    TSet<const UFont*> Fonts;
+    CollectWidgetResources(Widget, Textures, Fonts);
+
+    const auto TimeoutSeconds = FMath::Max(0.0f, CVarBlazeRevealResidencyTimeoutMs.GetValueOnGameThread()) / 1000.0f;
+    const auto Now = FPlatformTime::Seconds();
+
+    auto& GatedWidget = GatedWidgets.AddDefaulted_GetRef();
+    GatedWidget.Widget = &Widget;
+    GatedWidget.Visibility = Widget.GetVisibility();
+    GatedWidget.StartTime = Now;
+    GatedWidget.Deadline = Now + TimeoutSeconds;
+    for (const auto Texture : Textures)
+    {
+        // Ask the streaming system to prioritise every mip of the texture while the widget is collapsed,
+        // as a collapsed widget is not painted and so does not otherwise request them
+        Texture->SetForceMipLevelsToBeResident(TimeoutSeconds);
+        GatedWidget.Textures.Add(Texture);
+    }
+
+    if (FSlateApplication::IsInitialized() && !Fonts.IsEmpty())
+    {
+        // Font faces that are lazily loaded are loaded when a glyph is first measured
+        const auto FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+        for (const auto Font : Fonts)
+        {
+            FontMeasure->Measure(TEXT("0"), FSlateFontInfo(Font, 12));
+        }
+    }
+
+    Widget.SetVisibility(ESlateVisibility::Collapsed);
+
+    UE_LOGFMT(LogBlaze,
+              Verbose,
+              "Collapsed widget [{Widget}] until {TextureCount} texture(s) are resident. World=[{WorldName}]",
+              Widget.GetName(),
+              Textures.Num(),
+              GetNameSafe(Widget.GetWorld()));
+
+    if (!GateTickerHandle.IsValid())
+    {
+        GateTickerHandle =
+            FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FBlazeResidencyGate::Tick));
+    }
+}
+
+bool FBlazeResidencyGate::IsHeld(const UUserWidget& Widget)
+{
+    check(IsInGameThread());
+    return GatedWidgets.ContainsByPredicate(
+        [&Widget](const FBlazeGatedWidget& GatedWidget) { return GatedWidget.Widget.Get() == &Widget; });
+}
@@ -0,0 +1,41 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+class UUserWidget;
+
+/**
+ * Keeps a widget collapsed until the textures it references are fully streamed in, so that a pushed widget
+ * does not appear with low resolution mips that sharpen a few frames later.
+ *
+ * The textures referenced by the widget tree, either directly or via materials, are forced to be fully resident
+ * and the widget is revealed once they are, or once the "Blaze.Reveal.ResidencyTimeoutMs" timeout has elapsed.
+ * Fonts referenced by the widget tree are warmed by measuring a glyph, which loads lazily loaded font faces before
+ * the widget is revealed rather than on first paint.
+ *
+ * A widget should be held before it is added to a layer so that it is never painted before it is revealed. If the
+ * visibility of the widget is changed while it is held then that visibility is kept when the widget is revealed.
+ */
+class FBlazeResidencyGate final
+{
+public:
+    /** Collapse the widget and reveal it once the resources it references are resident. */
+    static void Hold(UUserWidget& Widget);
+
+    /** Return true if the widget is held by the gate. */
+    static bool IsHeld(const UUserWidget& Widget);
+
+    /** Reveal the held widgets whose resources are resident, as the ticker does on each frame. */
+    static bool Tick(float DeltaTime);
+};
@@ -12,15 +12,22 @@
  * limitations under the License.
  */
 #include "Blaze/BlazeSubsystem.h"
+#include "Blaze/BlazeHeadlessPrimaryLayoutManager.h"
 #include "Blaze/BlazeLogging.h"
 #include "Blaze/BlazePrimaryLayoutManager.h"
+#include "Blaze/BlazeProfiling.h"
+#include "Blaze/BlazePushRequest.h"
 #include "Engine/GameInstance.h"
+#include "Misc/CoreDelegates.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BlazeSubsystem)
 
 void UBlazeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
+#if CSV_PROFILER
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UBlazeSubsystem::RecordCsvStats);
+#endif
     if (PrimaryLayoutManager)
     {
         UE_LOGFMT(LogBlaze,
@@ -32,6 +39,16 @@ void UBlazeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
                   GetNameSafe(PrimaryLayoutManager),
                   GetNameSafe(GetWorld()));
     }
+    else if (bHeadless)
+    {
+        UE_LOGFMT(LogBlaze,
+                  Log,
+                  "[{Name}] is initializing headless with {LayerCount} layer(s). World=[{WorldName}]",
+                  GetName(),
+                  HeadlessLayers.Num(),
+                  GetNameSafe(GetWorld()));
+        SwitchToPrimaryLayoutManager(NewObject<UBlazeHeadlessPrimaryLayoutManager>(this));
+    }
     else if (PrimaryLayoutManagerClass.IsNull())
     {
         UE_LOGFMT(LogBlaze,
@@ -93,6 +110,9 @@ void UBlazeSubsystem::Deinitialize()
 {
     Super::Deinitialize();
 
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    EndFrameHandle.Reset();
+
     SwitchToPrimaryLayoutManager(nullptr);
 }
 
@@ -166,6 +186,21 @@ void UBlazeSubsystem::NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer)
     }
 }
 
+void UBlazeSubsystem::RecordCsvStats() const
+{
+#if CSV_PROFILER
+    if (FCsvProfiler::Get()->IsCapturing())
+    {
+        // The request pool is shared by every game instance so the count is set rather than accumulated
+        CSV_CUSTOM_STAT(Blaze, PendingPushRequests, FBlazePushRequest::GetNumPendingRequests(), ECsvCustomStatOp::Set);
+        if (PrimaryLayoutManager)
+        {
+            PrimaryLayoutManager->RecordCsvStats();
+        }
+    }
+#endif
+}
+
 void UBlazeSubsystem::SwitchToPrimaryLayoutManager(UBlazePrimaryLayoutManager* InPrimaryLayoutManager)
 {
     if (PrimaryLayoutManager != InPrimaryLayoutManager)
@@ -0,0 +1,545 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeTrace.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blaze/BlazePrimaryLayout.h"
+#include "CommonActivatableWidget.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectKey.h"
+
+// "BLZT" in little endian order
+static constexpr uint32 TraceMagic{ 0x545A4C42 };
+// Version 2 added the Rehydrate operation, so version 1 traces remain readable
+static constexpr uint32 TraceVersion{ 2 };
+
+static FAutoConsoleCommand BlazeTraceStartCommand(TEXT("Blaze.Trace.Start"),
+                                                  TEXT("Start recording Blaze operations into a trace."),
+                                                  FConsoleCommandDelegate::CreateStatic(&FBlazeTraceRecorder::Start));
+
+static FAutoConsoleCommand
+    BlazeTraceStopCommand(TEXT("Blaze.Trace.Stop"),
+                          TEXT("Stop recording Blaze operations and save the trace. Accepts an optional filename, "
+                               "otherwise the trace is saved into the Saved/Blaze/Traces directory."),
+                          FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+                              FBlazeTraceRecorder::Stop(Args.IsEmpty() ? FString() : Args[0]);
+                          }));
+
+bool FBlazeTraceRecorder::bRecording{ false };
+
+/** The identifier assigned to a recorded widget and the binding that forgets the widget once it is released. */
+struct FBlazeRecordedWidget
+{
+    uint32 WidgetId{ 0 };
+    TWeakObjectPtr<const UCommonActivatableWidget> Widget{ nullptr };
+    FDelegateHandle ReleasedHandle;
+};
+
+// The recorder is only accessed from the game thread
+static FBlazeTrace RecordingTrace;
+static uint64 RecordingStartFrame{ 0 };
+static double RecordingStartTime{ 0.0 };
+static TMap<FObjectKey, FBlazeRecordedWidget> RecordedWidgets;
+static uint32 NextWidgetId{ 1 };
+
+const TCHAR* LexToString(const EBlazeTraceOp Op)
+{
+    switch (Op)
+    {
+        case EBlazeTraceOp::Push:
+            return TEXT("Push");
+        case EBlazeTraceOp::Pop:
+            return TEXT("Pop");
+        case EBlazeTraceOp::Cancel:
+            return TEXT("Cancel");
+        case EBlazeTraceOp::BeginTransaction:
+            return TEXT("BeginTransaction");
+        case EBlazeTraceOp::CommitTransaction:
+            return TEXT("CommitTransaction");
+        case EBlazeTraceOp::PlayerAdded:
+            return TEXT("PlayerAdded");
+        case EBlazeTraceOp::PlayerRemoved:
+            return TEXT("PlayerRemoved");
+        case EBlazeTraceOp::PlayerDestroyed:
+            return TEXT("PlayerDestroyed");
+        case EBlazeTraceOp::Rehydrate:
+            return TEXT("Rehydrate");
+        default:
+            return TEXT("Unknown");
+    }
+}
+
+int32 FBlazeTrace::AddString(const FString& String)
+{
+    return Strings.AddUnique(String);
+}
+
+const FString& FBlazeTrace::GetString(const int32 Index) const
+{
+    static const FString Empty;
+    return Strings.IsValidIndex(Index) ? Strings[Index] : Empty;
+}
+
+bool FBlazeTrace::SaveToFile(const FString& Filename) const
+{
+    TArray<uint8> Data;
+    FMemoryWriter Writer(Data);
+    // Serialize only reads from the trace when saving
+    return const_cast<FBlazeTrace*>(this)->Serialize(Writer) && FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool FBlazeTrace::LoadFromFile(const FString& Filename)
+{
+    TArray<uint8> Data;
+    if (FFileHelper::LoadFileToArray(Data, *Filename))
+    {
+        FMemoryReader Reader(Data);
+        return Serialize(Reader);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool FBlazeTrace::Serialize(FArchive& Ar)
+{
+    auto Magic{ TraceMagic };
+    auto Version{ TraceVersion };
+    Ar << Magic;
+    Ar << Version;
+    if (Ar.IsLoading() && (TraceMagic != Magic || Version < 1 || Version > TraceVersion))
+    {
+        return false;
+    }
+
+    Ar << Strings;
+
+    auto NumEvents = Events.Num();
+    Ar << NumEvents;
+    if (Ar.IsLoading())
+    {
+        // Every event occupies several bytes so a count larger than the data indicates a corrupt trace
+        if (Ar.IsError() || NumEvents < 0 || NumEvents > Ar.TotalSize())
+        {
+            return false;
+        }
+        Events.SetNum(NumEvents);
+    }
+
+    uint32 PreviousFrame{ 0 };
+    uint32 PreviousTimeMs{ 0 };
+    for (auto& Event : Events)
+    {
+        auto Op = static_cast<uint8>(Event.Op);
+        Ar << Op;
+        Ar << Event.Player;
+
+        // Events are recorded in order so the frame and time are stored as small deltas
+        auto FrameDelta = Event.Frame - PreviousFrame;
+        auto TimeDeltaMs = Event.TimeMs - PreviousTimeMs;
+        Ar.SerializeIntPacked(FrameDelta);
+        Ar.SerializeIntPacked(TimeDeltaMs);
+
+        // String indices are offset by one so that INDEX_NONE is stored as 0
+        auto LayerName = static_cast<uint32>(Event.LayerName + 1);
+        auto WidgetClass = static_cast<uint32>(Event.WidgetClass + 1);
+        Ar.SerializeIntPacked(LayerName);
+        Ar.SerializeIntPacked(WidgetClass);
+        Ar.SerializeIntPacked(Event.WidgetId);
+
+        if (Ar.IsLoading())
+        {
+            if (Op >= static_cast<uint8>(EBlazeTraceOp::Num))
+            {
+                return false;
+            }
+            Event.Op = static_cast<EBlazeTraceOp>(Op);
+            Event.Frame = PreviousFrame + FrameDelta;
+            Event.TimeMs = PreviousTimeMs + TimeDeltaMs;
+            Event.LayerName = static_cast<int32>(LayerName) - 1;
+            Event.WidgetClass = static_cast<int32>(WidgetClass) - 1;
+        }
+        PreviousFrame = Event.Frame;
+        PreviousTimeMs = Event.TimeMs;
+    }
+    return !Ar.IsError();
+}
+
+static uint8 GetPlayerIndex(const ULocalPlayer* LocalPlayer)
+{
+    const auto GameInstance = LocalPlayer ? LocalPlayer->GetGameInstance() : nullptr;
+    const auto Index = GameInstance ? GameInstance->GetLocalPlayers().IndexOfByKey(LocalPlayer) : INDEX_NONE;
+    return static_cast<uint8>(FMath::Clamp(Index, 0, static_cast<int32>(MAX_uint8)));
+}
+
+static FBlazeTraceEvent& AddEvent(const EBlazeTraceOp Op, const ULocalPlayer* LocalPlayer)
+{
+    auto& Event = RecordingTrace.Events.AddDefaulted_GetRef();
+    Event.Op = Op;
+    Event.Player = GetPlayerIndex(LocalPlayer);
+    Event.Frame = static_cast<uint32>(GFrameCounter - RecordingStartFrame);
+    Event.TimeMs = static_cast<uint32>((FPlatformTime::Seconds() - RecordingStartTime) * 1000.0);
+    return Event;
+}
+
+static void ForgetRecordedWidget(const FObjectKey Key)
+{
+    if (FBlazeRecordedWidget RecordedWidget; RecordedWidgets.RemoveAndCopyValue(Key, RecordedWidget))
+    {
+        if (const auto Widget = RecordedWidget.Widget.Get())
+        {
+            Widget->OnSlateReleased().Remove(RecordedWidget.ReleasedHandle);
+        }
+    }
+}
+
+static void ForgetRecordedWidgets()
+{
+    for (const auto& [Key, RecordedWidget] : RecordedWidgets)
+    {
+        if (const auto Widget = RecordedWidget.Widget.Get())
+        {
+            Widget->OnSlateReleased().Remove(RecordedWidget.ReleasedHandle);
+        }
+    }
+    RecordedWidgets.Reset();
+}
+
+static uint32 AssignWidgetId(const UCommonActivatableWidget& Widget)
+{
+    const FObjectKey Key(&Widget);
+    auto& RecordedWidget = RecordedWidgets.FindOrAdd(Key);
+    RecordedWidget.WidgetId = NextWidgetId++;
+    if (!RecordedWidget.ReleasedHandle.IsValid())
+    {
+        // A released widget can no longer be popped, so forget it rather than retaining it until recording stops
+        RecordedWidget.Widget = &Widget;
+        RecordedWidget.ReleasedHandle = Widget.OnSlateReleased().AddStatic(&ForgetRecordedWidget, Key);
+    }
+    return RecordedWidget.WidgetId;
+}
+
+void FBlazeTraceRecorder::Start()
+{
+    check(IsInGameThread());
+    if (bRecording)
+    {
+        UE_LOGFMT(LogBlaze, Warning, "Blaze.Trace.Start ignored as a trace is already being recorded");
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze, Log, "Started recording Blaze trace");
+        bRecording = true;
+        RecordingTrace = FBlazeTrace();
+        RecordingStartFrame = GFrameCounter;
+        RecordingStartTime = FPlatformTime::Seconds();
+        ForgetRecordedWidgets();
+        NextWidgetId = 1;
+    }
+}
+
+FBlazeTrace FBlazeTraceRecorder::Stop(const FString& Filename)
+{
+    check(IsInGameThread());
+    if (bRecording)
+    {
+        auto Trace = MoveTemp(RecordingTrace);
+        Discard();
+
+        const auto Path = !Filename.IsEmpty()
+            ? Filename
+            : FPaths::ProjectSavedDir() / TEXT("Blaze/Traces")
+                / FString::Printf(TEXT("%s.blztrace"), *FDateTime::Now().ToString());
+        if (Trace.SaveToFile(Path))
+        {
+            UE_LOGFMT(LogBlaze,
+                      Log,
+                      "Saved Blaze trace containing {Count} event(s) to [{Path}]",
+                      Trace.Events.Num(),
+                      Path);
+        }
+        else
+        {
+            UE_LOGFMT(LogBlaze, Error, "Failed to save Blaze trace to [{Path}]", Path);
+        }
+        return Trace;
+    }
+    else
+    {
+        UE_LOGFMT(LogBlaze, Warning, "Blaze.Trace.Stop ignored as no trace is being recorded");
+        return FBlazeTrace();
+    }
+}
+
+void FBlazeTraceRecorder::Discard()
+{
+    check(IsInGameThread());
+    bRecording = false;
+    RecordingTrace = FBlazeTrace();
+    ForgetRecordedWidgets();
+}
+
+void FBlazeTraceRecorder::RecordPush(const UBlazePrimaryLayout& Layout,
+                                     const FGameplayTag& LayerName,
+                                     const UCommonActivatableWidget& Widget)
+{
+    check(IsInGameThread());
+    auto& Event = AddEvent(EBlazeTraceOp::Push, Layout.GetOwningLocalPlayer());
+    Event.LayerName = RecordingTrace.AddString(LayerName.ToString());
+    Event.WidgetClass = RecordingTrace.AddString(Widget.GetClass()->GetPathName());
+    Event.WidgetId = AssignWidgetId(Widget);
+}
+
+void FBlazeTraceRecorder::RecordPop(const UBlazePrimaryLayout& Layout,
+                                    const FGameplayTag& LayerName,
+                                    const UCommonActivatableWidget& Widget)
+{
+    check(IsInGameThread());
+    auto& Event = AddEvent(EBlazeTraceOp::Pop, Layout.GetOwningLocalPlayer());
+    Event.LayerName = RecordingTrace.AddString(LayerName.ToString());
+    Event.WidgetClass = RecordingTrace.AddString(Widget.GetClass()->GetPathName());
+    const FObjectKey Key(&Widget);
+    if (const auto RecordedWidget = RecordedWidgets.Find(Key))
+    {
+        Event.WidgetId = RecordedWidget->WidgetId;
+        ForgetRecordedWidget(Key);
+    }
+}
+
+void FBlazeTraceRecorder::RecordRehydrate(const UBlazePrimaryLayout& Layout,
+                                          const FGameplayTag& LayerName,
+                                          const UCommonActivatableWidget& Widget)
+{
+    check(IsInGameThread());
+    auto& Event = AddEvent(EBlazeTraceOp::Rehydrate, Layout.GetOwningLocalPlayer());
+    Event.LayerName = RecordingTrace.AddString(LayerName.ToString());
+    Event.WidgetClass = RecordingTrace.AddString(Widget.GetClass()->GetPathName());
+    Event.WidgetId = AssignWidgetId(Widget);
+}
+
+void FBlazeTraceRecorder::RecordLayoutOp(const EBlazeTraceOp Op,
+                                         const UBlazePrimaryLayout& Layout,
+                                         const FGameplayTag& LayerName)
+{
+    check(IsInGameThread());
+    auto& Event = AddEvent(Op, Layout.GetOwningLocalPlayer());
+    if (LayerName.IsValid())
+    {
+        Event.LayerName = RecordingTrace.AddString(LayerName.ToString());
+    }
+}
+
+void FBlazeTraceRecorder::RecordPlayerOp(const EBlazeTraceOp Op, const ULocalPlayer* LocalPlayer)
+{
+    check(IsInGameThread());
+    AddEvent(Op, LocalPlayer);
+}
+
+void FBlazeTraceReplayReport::Dump(FOutputDevice& Ar) const
+{
+    auto NumEvents{ 0 };
+    for (const auto& Timing : Timings)
+    {
+        NumEvents += Timing.Count;
+    }
+    Ar.Logf(TEXT("Replayed %d Blaze trace event(s) and skipped %d:"), NumEvents, SkippedEvents);
+    for (auto i = 0; i < static_cast<int32>(EBlazeTraceOp::Num); ++i)
+    {
+        if (const auto& Timing = Timings[i]; Timing.Count > 0)
+        {
+            Ar.Logf(TEXT("  %s: Count=%d Total=%.2fms Mean=%.3fms Max=%.3fms"),
+                    LexToString(static_cast<EBlazeTraceOp>(i)),
+                    Timing.Count,
+                    Timing.TotalMs,
+                    Timing.TotalMs / Timing.Count,
+                    Timing.MaxMs);
+        }
+    }
+}
+
+FBlazeTraceReplayReport FBlazeTraceReplayer::Replay(const FBlazeTrace& Trace,
+                                                    const TFunctionRef<UBlazePrimaryLayout*(uint8 Player)> GetLayout)
+{
+    check(IsInGameThread());
+
+    // Resolve the layers and load the widget classes up front so that only the operations are timed
+    TMap<int32, FGameplayTag> LayerNames;
+    TMap<int32, TSubclassOf<UCommonActivatableWidget>> WidgetClasses;
+    for (const auto& Event : Trace.Events)
+    {
+        if (INDEX_NONE != Event.LayerName && !LayerNames.Contains(Event.LayerName))
+        {
+            const FName TagName(*Trace.GetString(Event.LayerName));
+            LayerNames.Add(Event.LayerName, FGameplayTag::RequestGameplayTag(TagName, false));
+        }
+        if ((EBlazeTraceOp::Push == Event.Op || EBlazeTraceOp::Rehydrate == Event.Op)
+            && INDEX_NONE != Event.WidgetClass
+            && !WidgetClasses.Contains(Event.WidgetClass))
+        {
+            const TSoftClassPtr<UCommonActivatableWidget> WidgetClass{ FSoftObjectPath(
+                Trace.GetString(Event.WidgetClass)) };
+            WidgetClasses.Add(Event.WidgetClass, WidgetClass.LoadSynchronous());
+        }
+    }
+
+    FBlazeTraceReplayReport Report;
+    TMap<uint32, TWeakObjectPtr<UCommonActivatableWidget>> Widgets;
+    TSet<TWeakObjectPtr<UBlazePrimaryLayout>> Layouts;
+    for (const auto& Event : Trace.Events)
+    {
+        // Creating the layout is only timed when the trace adds the player
+        const auto Layout = EBlazeTraceOp::PlayerAdded != Event.Op ? GetLayout(Event.Player) : nullptr;
+        const auto LayerName = LayerNames.FindRef(Event.LayerName);
+        const auto bHasLayer = Layout && LayerName.IsValid() && Layout->HasLayer(LayerName);
+
+        auto bReplayed{ false };
+        const auto StartTime = FPlatformTime::Seconds();
+        switch (Event.Op)
+        {
+            case EBlazeTraceOp::Push:
+                if (const auto WidgetClass = WidgetClasses.FindRef(Event.WidgetClass); WidgetClass && bHasLayer)
+                {
+                    if (const auto Widget = Layout->PushWidgetToLayer(LayerName, WidgetClass))
+                    {
+                        Widgets.Add(Event.WidgetId, Widget);
+                        bReplayed = true;
+                    }
+                }
+                break;
+            case EBlazeTraceOp::Pop:
+                if (const auto Widget = Widgets.FindRef(Event.WidgetId).Get(); Widget && bHasLayer)
+                {
+                    Layout->RemoveWidgetFromLayer(LayerName, Widget);
+                    bReplayed = true;
+                }
+                break;
+            case EBlazeTraceOp::Rehydrate:
+                // The replayed layout dehydrates and rehydrates its own widgets, so the recorded widget is mapped to
+                // the bottom-most widget of the class on the layer, preferring one that no event refers to yet
+                if (const auto WidgetClass = WidgetClasses.FindRef(Event.WidgetClass); WidgetClass && bHasLayer)
+                {
+                    TArray<UCommonActivatableWidget*> LayerWidgets;
+                    Layout->GetLayerWidgets(LayerName, LayerWidgets);
+                    UCommonActivatableWidget* Match{ nullptr };
+                    for (const auto Widget : LayerWidgets)
+                    {
+                        if (Widget && Widget->GetClass() == WidgetClass)
+                        {
+                            const auto bMapped = Widgets.FindKey(Widget) != nullptr;
+                            if (!bMapped)
+                            {
+                                Match = Widget;
+                                break;
+                            }
+                            else if (!Match)
+                            {
+                                Match = Widget;
+                            }
+                        }
+                    }
+                    if (Match)
+                    {
+                        Widgets.Add(Event.WidgetId, Match);
+                        bReplayed = true;
+                    }
+                }
+                break;
+            case EBlazeTraceOp::Cancel:
+                if (bHasLayer)
+                {
+                    Layout->CancelPushRequests(LayerName);
+                    bReplayed = true;
+                }
+                else if (Layout && INDEX_NONE == Event.LayerName)
+                {
+                    Layout->CancelAllPushRequests();
+                    bReplayed = true;
+                }
+                break;
+            case EBlazeTraceOp::BeginTransaction:
+                if (Layout)
+                {
+                    Layout->BeginLayerTransaction();
+                    bReplayed = true;
+                }
+                break;
+            case EBlazeTraceOp::CommitTransaction:
+                // The trace may have started recording inside a transaction
+                if (Layout && Layout->IsInLayerTransaction())
+                {
+                    Layout->CommitLayerTransaction();
+                    bReplayed = true;
+                }
+                break;
+            case EBlazeTraceOp::PlayerAdded:
+                bReplayed = nullptr != GetLayout(Event.Player);
+                break;
+            case EBlazeTraceOp::PlayerRemoved:
+                if (Layout)
+                {
+                    Layout->CancelAllPushRequests();
+                    Layout->CancelRestoreSnapshot();
+                    bReplayed = true;
+                }
+                break;
+            case EBlazeTraceOp::PlayerDestroyed:
+                if (Layout)
+                {
+                    Layout->PopAll([](const auto&, const auto&) { return true; });
+                    bReplayed = true;
+                }
+                break;
+            default:
+                break;
+        }
+        const auto ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        if (bReplayed)
+        {
+            auto& Timing = Report.Timings[static_cast<int32>(Event.Op)];
+            Timing.Count++;
+            Timing.TotalMs += ElapsedMs;
+            Timing.MaxMs = FMath::Max(Timing.MaxMs, ElapsedMs);
+        }
+        else
+        {
+            Report.SkippedEvents++;
+        }
+        if (Layout)
+        {
+            Layouts.Add(Layout);
+        }
+    }
+
+    // Close any transaction that was still open when the recording stopped
+    for (const auto& WeakLayout : Layouts)
+    {
+        if (const auto Layout = WeakLayout.Get())
+        {
+            while (Layout->IsInLayerTransaction())
+            {
+                Layout->CommitLayerTransaction();
+            }
+        }
+    }
+    return Report;
+}
@@ -0,0 +1,180 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+class FArchive;
+class FOutputDevice;
+class UBlazePrimaryLayout;
+class UCommonActivatableWidget;
+class ULocalPlayer;
+
+/** The operations recorded in a Blaze trace. */
+enum class EBlazeTraceOp : uint8
+{
+    // A widget was pushed onto a layer
+    Push,
+    // A widget was removed from a layer
+    Pop,
+    // Pending async pushes onto a layer, or onto every layer, were canceled
+    Cancel,
+    BeginTransaction,
+    CommitTransaction,
+    PlayerAdded,
+    PlayerRemoved,
+    PlayerDestroyed,
+    // A dehydrated widget was recreated on a layer
+    Rehydrate,
+    Num
+};
+
+/** Return the name of the operation, as used in replay reports. */
+const TCHAR* LexToString(EBlazeTraceOp Op);
+
+/** A single recorded operation. Layer and widget class names are indices into the string table of the trace. */
+struct FBlazeTraceEvent
+{
+    EBlazeTraceOp Op{ EBlazeTraceOp::Push };
+
+    /** The index of the player in the local players of the game instance. */
+    uint8 Player{ 0 };
+
+    /** The frame on which the operation occurred, relative to the start of the trace. */
+    uint32 Frame{ 0 };
+
+    /** The time in milliseconds at which the operation occurred, relative to the start of the trace. */
+    uint32 TimeMs{ 0 };
+
+    int32 LayerName{ INDEX_NONE };
+
+    int32 WidgetClass{ INDEX_NONE };
+
+    /** The identifier assigned to the widget when it was pushed, or 0 if the widget was not pushed while recording. */
+    uint32 WidgetId{ 0 };
+};
+
+/**
+ * A recorded sequence of Blaze operations.
+ *
+ * Traces are saved in a compact binary format. Layer names and widget class paths are stored once in a string table
+ * and the frame and time of each event are stored as packed deltas from the previous event.
+ */
+struct FBlazeTrace
+{
+    TArray<FString> Strings;
+
+    TArray<FBlazeTraceEvent> Events;
+
+    /** Return the index of the string in the string table, adding it if required. */
+    int32 AddString(const FString& String);
+
+    /** Return the string at the index, or an empty string if the index is not valid. */
+    const FString& GetString(int32 Index) const;
+
+    bool SaveToFile(const FString& Filename) const;
+
+    bool LoadFromFile(const FString& Filename);
+
+    /** Serialize the trace, returning false if the data loaded is not a valid trace. */
+    bool Serialize(FArchive& Ar);
+};
+
+/**
+ * Records the public Blaze operations of a play session into a trace.
+ *
+ * Recording is started and stopped via the "Blaze.Trace.Start" and "Blaze.Trace.Stop" console commands. Async pushes
+ * are recorded as a push when the widget is pushed onto the layer, so that replaying the trace does not depend on
+ * load times. The widgets of a restored snapshot are recorded as pushes within the transaction that applies them.
+ * The recorder must only be used on the game thread.
+ */
+class FBlazeTraceRecorder final
+{
+public:
+    FORCEINLINE static bool IsRecording() { return bRecording; }
+
+    static void Start();
+
+    /**
+     * Stop recording and save the trace.
+     *
+     * @param Filename The file to save the trace to. A timestamped file in the Saved/Blaze/Traces directory of the
+     * project is used if empty.
+     * @return The recorded trace.
+     */
+    static FBlazeTrace Stop(const FString& Filename = FString());
+
+    /** Stop recording and discard the trace. */
+    static void Discard();
+
+    static void RecordPush(const UBlazePrimaryLayout& Layout,
+                           const FGameplayTag& LayerName,
+                           const UCommonActivatableWidget& Widget);
+
+    static void RecordPop(const UBlazePrimaryLayout& Layout,
+                          const FGameplayTag& LayerName,
+                          const UCommonActivatableWidget& Widget);
+
+    /** Record that the layout recreated a dehydrated widget, so that a later pop of the widget can be replayed. */
+    static void RecordRehydrate(const UBlazePrimaryLayout& Layout,
+                                const FGameplayTag& LayerName,
+                                const UCommonActivatableWidget& Widget);
+
+    /** Record an operation on the layout, or on the layer if LayerName is valid. */
+    static void
+    RecordLayoutOp(EBlazeTraceOp Op, const UBlazePrimaryLayout& Layout, const FGameplayTag& LayerName = FGameplayTag());
+
+    static void RecordPlayerOp(EBlazeTraceOp Op, const ULocalPlayer* LocalPlayer);
+
+private:
+    static bool bRecording;
+};
+
+/** The timing of one kind of operation while replaying a trace. */
+struct FBlazeTraceOpTiming
+{
+    int32 Count{ 0 };
+
+    double TotalMs{ 0.0 };
+
+    double MaxMs{ 0.0 };
+};
+
+/** The outcome of replaying a trace. */
+struct FBlazeTraceReplayReport
+{
+    FBlazeTraceOpTiming Timings[static_cast<int32>(EBlazeTraceOp::Num)];
+
+    /** The number of events that could not be replayed, such as pops of widgets pushed before recording started. */
+    int32 SkippedEvents{ 0 };
+
+    void Dump(FOutputDevice& Ar) const;
+};
+
+/** Replays a trace against layouts, timing each operation. */
+class FBlazeTraceReplayer final
+{
+public:
+    /**
+     * Replay the trace. The widget classes referenced by the trace are loaded before replaying so that only the
+     * operations themselves are timed.
+     *
+     * @param Trace The trace to replay.
+     * @param GetLayout The function that returns the layout for a player, creating it if necessary. The layout is
+     * expected to have registered the layers referenced by the trace.
+     * @return The timing of the replayed operations.
+     */
+    static FBlazeTraceReplayReport Replay(const FBlazeTrace& Trace,
+                                          TFunctionRef<UBlazePrimaryLayout*(uint8 Player)> GetLayout);
+};
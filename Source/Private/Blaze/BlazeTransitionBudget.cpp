@@ -0,0 +1,205 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeTransitionBudget.h"
+#include "Blaze/BlazeLogging.h"
+#include "Blaze/BlazeProfiling.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/OutputDevice.h"
+
+static TAutoConsoleVariable<float>
+    CVarBlazeTransitionFrameBudgetMs(TEXT("Blaze.Transition.FrameBudgetMs"),
+                                     20.0f,
+                                     TEXT("The game thread time in milliseconds per frame above which layer "
+                                          "transitions are shortened. A value of 0 never adapts transitions."),
+                                     ECVF_Default);
+
+static TAutoConsoleVariable<float>
+    CVarBlazeTransitionSkipRatio(TEXT("Blaze.Transition.SkipRatio"),
+                                 1.5f,
+                                 TEXT("The multiple of Blaze.Transition.FrameBudgetMs above which layer transitions "
+                                      "are skipped rather than shortened."),
+                                 ECVF_Default);
+
+static TAutoConsoleVariable<float>
+    CVarBlazeTransitionShortenedScale(TEXT("Blaze.Transition.ShortenedScale"),
+                                      0.5f,
+                                      TEXT("The fraction of its configured duration that a shortened layer "
+                                           "transition plays for."),
+                                      ECVF_Default);
+
+static FAutoConsoleCommandWithOutputDevice
+    BlazeTransitionStatsCommand(TEXT("Blaze.Transition.Stats"),
+                                TEXT("Print the number of layer transitions played in full, shortened and skipped."),
+                                FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FBlazeTransitionBudget::Dump));
+
+static FAutoConsoleCommand
+    BlazeTransitionResetStatsCommand(TEXT("Blaze.Transition.ResetStats"),
+                                     TEXT("Discard the layer transition statistics."),
+                                     FConsoleCommandDelegate::CreateStatic(&FBlazeTransitionBudget::Reset));
+
+// The weight of the latest frame in the smoothed frame time, which spans roughly the last ten frames
+static constexpr double FrameTimeSmoothing{ 0.1 };
+
+// The fraction of a threshold that the smoothed frame time must drop below before the level it raised is relaxed
+static constexpr double HeadroomRatio{ 0.9 };
+
+static FDelegateHandle EndFrameHandle;
+
+// The smoothed game thread time per frame in milliseconds, or a negative value if no frame has been recorded
+static double SmoothedFrameMs{ -1.0 };
+
+static EBlazeTransitionLevel Level{ EBlazeTransitionLevel::Full };
+
+static FBlazeTransitionStats Stats;
+
+static void OnEndFrame()
+{
+    // Time spent waiting for the frame rate limit is headroom rather than load
+    FBlazeTransitionBudget::RecordFrameTime(FMath::Max(0.0, FApp::GetDeltaTime() - FApp::GetIdleTime()));
+}
+
+void FBlazeTransitionBudget::Startup()
+{
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&OnEndFrame);
+}
+
+void FBlazeTransitionBudget::Shutdown()
+{
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    EndFrameHandle.Reset();
+}
+
+float FBlazeTransitionBudget::GetTransitionDuration(const float Duration, const bool bAdaptToFrameBudget)
+{
+    const auto AppliedLevel = bAdaptToFrameBudget ? Level : EBlazeTransitionLevel::Full;
+    if (EBlazeTransitionLevel::Skipped == AppliedLevel)
+    {
+        return 0.f;
+    }
+    else if (EBlazeTransitionLevel::Shortened == AppliedLevel)
+    {
+        return Duration * FMath::Clamp(CVarBlazeTransitionShortenedScale.GetValueOnGameThread(), 0.f, 1.f);
+    }
+    else
+    {
+        return Duration;
+    }
+}
+
+float FBlazeTransitionBudget::ApplyToTransition(const float Duration, const bool bAdaptToFrameBudget)
+{
+    check(IsInGameThread());
+    // Transitions that never adapt would dilute the share of adaptive transitions that were shortened or skipped
+    if (bAdaptToFrameBudget)
+    {
+        if (EBlazeTransitionLevel::Skipped == Level)
+        {
+            Stats.Skipped++;
+            CSV_CUSTOM_STAT(Blaze, TransitionsSkipped, 1, ECsvCustomStatOp::Accumulate);
+        }
+        else if (EBlazeTransitionLevel::Shortened == Level)
+        {
+            Stats.Shortened++;
+            CSV_CUSTOM_STAT(Blaze, TransitionsShortened, 1, ECsvCustomStatOp::Accumulate);
+        }
+        else
+        {
+            Stats.Full++;
+        }
+    }
+    return GetTransitionDuration(Duration, bAdaptToFrameBudget);
+}
+
+void FBlazeTransitionBudget::RecordFrameTime(const double Seconds)
+{
+    const auto FrameMs = Seconds * 1000.0;
+    SmoothedFrameMs = SmoothedFrameMs < 0.0 ? FrameMs : FMath::Lerp(SmoothedFrameMs, FrameMs, FrameTimeSmoothing);
+
+    const auto BudgetMs = CVarBlazeTransitionFrameBudgetMs.GetValueOnGameThread();
+    const auto PreviousLevel = Level;
+    if (BudgetMs <= 0.f)
+    {
+        Level = EBlazeTransitionLevel::Full;
+    }
+    else
+    {
+        const auto SkipMs = BudgetMs * FMath::Max(1.f, CVarBlazeTransitionSkipRatio.GetValueOnGameThread());
+        const auto TargetLevel = SmoothedFrameMs > SkipMs ? EBlazeTransitionLevel::Skipped
+            : SmoothedFrameMs > BudgetMs                  ? EBlazeTransitionLevel::Shortened
+                                                          : EBlazeTransitionLevel::Full;
+        if (TargetLevel > Level)
+        {
+            Level = TargetLevel;
+        }
+        else if (TargetLevel < Level)
+        {
+            // Relax one level at a time, and only once the frame time is clearly below the threshold that raised it
+            const auto ThresholdMs = EBlazeTransitionLevel::Skipped == Level ? SkipMs : BudgetMs;
+            if (SmoothedFrameMs < ThresholdMs * HeadroomRatio)
+            {
+                Level = static_cast<EBlazeTransitionLevel>(static_cast<uint8>(Level) - 1);
+            }
+        }
+    }
+
+    if (PreviousLevel != Level)
+    {
+        UE_LOGFMT(LogBlaze,
+                  Verbose,
+                  "Layer transitions are {Action} as the smoothed frame time is {FrameMs}ms against a budget of "
+                  "{BudgetMs}ms",
+                  EBlazeTransitionLevel::Skipped == Level         ? TEXT("skipped")
+                      : EBlazeTransitionLevel::Shortened == Level ? TEXT("shortened")
+                                                                  : TEXT("restored"),
+                  SmoothedFrameMs,
+                  BudgetMs);
+    }
+}
+
+EBlazeTransitionLevel FBlazeTransitionBudget::GetLevel()
+{
+    return Level;
+}
+
+const FBlazeTransitionStats& FBlazeTransitionBudget::GetStats()
+{
+    return Stats;
+}
+
+void FBlazeTransitionBudget::Dump(FOutputDevice& Ar)
+{
+    check(IsInGameThread());
+    const auto Total = Stats.Full + Stats.Shortened + Stats.Skipped;
+    const auto Percent = [Total](const int32 Count) { return Total > 0 ? 100.0 * Count / Total : 0.0; };
+    Ar.Logf(TEXT("Blaze played %d layer transition(s): Full=%d (%.1f%%) Shortened=%d (%.1f%%) Skipped=%d (%.1f%%)"),
+            Total,
+            Stats.Full,
+            Percent(Stats.Full),
+            Stats.Shortened,
+            Percent(Stats.Shortened),
+            Stats.Skipped,
+            Percent(Stats.Skipped));
+    Ar.Logf(TEXT("The smoothed frame time is %.2fms against a budget of %.2fms."),
+            FMath::Max(0.0, SmoothedFrameMs),
+            CVarBlazeTransitionFrameBudgetMs.GetValueOnGameThread());
+}
+
+void FBlazeTransitionBudget::Reset()
+{
+    Stats = FBlazeTransitionStats();
+    SmoothedFrameMs = -1.0;
+    Level = EBlazeTransitionLevel::Full;
+}
@@ -0,0 +1,89 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOutputDevice;
+
+/** How the transitions of layers are played given the recent frame times. */
+enum class EBlazeTransitionLevel : uint8
+{
+    // Transitions play for their configured duration.
+    Full,
+    // Transitions play for a fraction of their configured duration.
+    Shortened,
+    // Transitions are skipped.
+    Skipped
+};
+
+/** The number of adaptive layer transitions played at each level since the statistics were last reset. */
+struct FBlazeTransitionStats
+{
+    int32 Full{ 0 };
+
+    int32 Shortened{ 0 };
+
+    int32 Skipped{ 0 };
+};
+
+/**
+ * Shortens or skips the transitions of layers when recent frames exceed the "Blaze.Transition.FrameBudgetMs"
+ * budget, and restores them once there is headroom again.
+ *
+ * The game thread cost of each frame, excluding time spent idle waiting for the frame rate limit, is smoothed over
+ * roughly the last ten frames. Transitions are shortened when the smoothed time exceeds the budget and skipped when
+ * it exceeds the budget by "Blaze.Transition.SkipRatio". A level is only relaxed once the smoothed time is clearly
+ * below the threshold that raised it, so transitions do not flicker between levels. The number of adaptive
+ * transitions played at each level is recorded into the CSV profiler and printed by the "Blaze.Transition.Stats"
+ * command.
+ */
+class FBlazeTransitionBudget final
+{
+public:
+    static void Startup();
+
+    static void Shutdown();
+
+    /**
+     * Return the duration that a transition configured with the specified duration plays for at the current level.
+     *
+     * @param Duration The configured duration in seconds.
+     * @param bAdaptToFrameBudget Whether the duration is shortened or skipped when frames exceed the budget.
+     * @return The duration in seconds.
+     */
+    static float GetTransitionDuration(float Duration, bool bAdaptToFrameBudget);
+
+    /**
+     * Return the duration that a transition configured with the specified duration plays for, and record it in the
+     * statistics if the transition adapts to the frame budget.
+     *
+     * @param Duration The configured duration in seconds.
+     * @param bAdaptToFrameBudget Whether the duration is shortened or skipped when frames exceed the budget.
+     * @return The duration in seconds.
+     */
+    static float ApplyToTransition(float Duration, bool bAdaptToFrameBudget);
+
+    /** Record the game thread cost of a frame and update the transition level. */
+    static void RecordFrameTime(double Seconds);
+
+    static EBlazeTransitionLevel GetLevel();
+
+    static const FBlazeTransitionStats& GetStats();
+
+    static void Dump(FOutputDevice& Ar);
+
+    /** Discard the statistics and the recorded frame times. */
+    static void Reset();
+};
@@ -0,0 +1,184 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Blaze/BlazeViewModelStore.h"
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BlazeViewModelStore)
+
+void UBlazeViewModelStore::BeginDestroy()
+{
+    if (PostActorTickHandle.IsValid())
+    {
+        FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+        PostActorTickHandle.Reset();
+    }
+    Super::BeginDestroy();
+}
+
+bool UBlazeViewModelStore::SetField(const FGameplayTag& Field, FInstancedStruct&& Value)
+{
+    if (ensureAlways(Field.IsValid()))
+    {
+        auto& StoredField = Fields.FindOrAdd(Field);
+        if (StoredField.Version > 0 && StoredField.Value == Value)
+        {
+            // Writing an unchanged value must not cause a refresh
+            return false;
+        }
+        else
+        {
+            StoredField.Value = MoveTemp(Value);
+            StoredField.Version++;
+            if (!StoredField.bDirty)
+            {
+                StoredField.bDirty = true;
+                DirtyFields.Add(Field);
+            }
+            if (!PostActorTickHandle.IsValid())
+            {
+                PostActorTickHandle =
+                    FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnWorldPostActorTick);
+            }
+            return true;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+const FInstancedStruct* UBlazeViewModelStore::GetField(const FGameplayTag& Field) const
+{
+    const auto StoredField = Fields.Find(Field);
+    return StoredField ? &StoredField->Value : nullptr;
+}
+
+int32 UBlazeViewModelStore::GetFieldVersion(const FGameplayTag Field) const
+{
+    const auto StoredField = Fields.Find(Field);
+    return StoredField ? static_cast<int32>(StoredField->Version) : 0;
+}
+
+FDelegateHandle UBlazeViewModelStore::BindFields(const FGameplayTagContainer& InFields,
+                                                 FBlazeViewModelFieldsChanged&& Delegate)
+{
+    const auto Handle = Delegate.GetHandle();
+    (bDispatching ? PendingBindings : Bindings).Add({ InFields, MoveTemp(Delegate) });
+    return Handle;
+}
+
+void UBlazeViewModelStore::UnbindFields(const FDelegateHandle Handle)
+{
+    RemoveBindings([&Handle](const auto& Binding) { return Handle == Binding.Delegate.GetHandle(); });
+}
+
+void UBlazeViewModelStore::UnbindAllFields(const UObject* Object)
+{
+    RemoveBindings([Object](const auto& Binding) { return Binding.Delegate.IsBoundToObject(Object); });
+}
+
+void UBlazeViewModelStore::RemoveBindings(const TFunctionRef<bool(const FBinding&)> Predicate)
+{
+    if (bDispatching)
+    {
+        // The bindings being notified are only flagged, as a delegate may unbind itself while it executes
+        for (auto& Binding : Bindings)
+        {
+            Binding.bRemoved = Binding.bRemoved || Predicate(Binding);
+        }
+        PendingBindings.RemoveAll(Predicate);
+    }
+    else
+    {
+        Bindings.RemoveAll(Predicate);
+    }
+}
+
+bool UBlazeViewModelStore::BP_SetField(const FGameplayTag Field, const FInstancedStruct& Value)
+{
+    // Blueprint supplies the value by reference so a copy is moved into the store
+    return SetField(Field, FInstancedStruct(Value));
+}
+
+FInstancedStruct UBlazeViewModelStore::BP_GetField(const FGameplayTag Field) const
+{
+    const auto Value = GetField(Field);
+    return Value ? *Value : FInstancedStruct();
+}
+
+void UBlazeViewModelStore::BP_BindFields(const FGameplayTagContainer& InFields,
+                                         FBlazeViewModelFieldsChangedDynamic Delegate)
+{
+    if (const auto Object = Delegate.GetUObject())
+    {
+        BindFields(InFields,
+                   FBlazeViewModelFieldsChanged::CreateWeakLambda(Object, [Delegate](const auto& ChangedFields) {
+                       Delegate.ExecuteIfBound(ChangedFields);
+                   }));
+    }
+}
+
+void UBlazeViewModelStore::DispatchDirtyFields()
+{
+    // A binding that dispatches while it is notified has its fields dispatched by the next frame instead
+    if (!bDispatching)
+    {
+        if (!DirtyFields.IsEmpty())
+        {
+            // Fields set by a binding while it is notified are queued for the next dispatch
+            FGameplayTagContainer ChangedFields;
+            for (const auto& Field : DirtyFields)
+            {
+                Fields.FindChecked(Field).bDirty = false;
+                ChangedFields.AddTagFast(Field);
+            }
+            DirtyFields.Reset();
+
+            // Bindings whose object has been destroyed are discarded rather than notified
+            Bindings.RemoveAll([](const auto& Binding) { return !Binding.Delegate.IsBound(); });
+
+            {
+                // Bindings are not added to or removed from the array while it is iterated, so it is not copied
+                TGuardValue DispatchingGuard(bDispatching, true);
+                for (const auto& Binding : Bindings)
+                {
+                    const auto BoundChangedFields =
+                        Binding.bRemoved ? FGameplayTagContainer() : Binding.Fields.FilterExact(ChangedFields);
+                    if (!BoundChangedFields.IsEmpty())
+                    {
+                        Binding.Delegate.ExecuteIfBound(BoundChangedFields);
+                    }
+                }
+            }
+            Bindings.RemoveAll([](const auto& Binding) { return Binding.bRemoved; });
+            Bindings.Append(MoveTemp(PendingBindings));
+            PendingBindings.Reset();
+        }
+        if (DirtyFields.IsEmpty() && PostActorTickHandle.IsValid())
+        {
+            // The next write to a field binds the delegate again
+            FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+            PostActorTickHandle.Reset();
+        }
+    }
+}
+
+void UBlazeViewModelStore::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World == GetWorld())
+    {
+        DispatchDirtyFields();
+    }
+}
@@ -1,13 +1,21 @@
 #if WITH_DEV_AUTOMATION_TESTS
 
+    #include "AssetRegistry/IAssetRegistry.h"
     #include "Blaze/Actions/AsyncAction_CreateWidgetAsync.h"
+    #include "Blaze/BlazeCoroutines.h"
+    #include "Blaze/BlazeDependencyClosure.h"
+    #include "Blaze/BlazeResidencyGate.h"
     #include "CommonActivatableWidget.h"
     #include "Engine/Engine.h"
+    #include "Engine/Texture2D.h"
     #include "Engine/World.h"
     #include "GameFramework/PlayerController.h"
+    #include "HAL/IConsoleManager.h"
     #include "Misc/AutomationTest.h"
     #include "NativeGameplayTags.h"
     #include "Tests/Blaze/BlazeAutomationTestTypes.h"
+    #include "Tests/Blaze/BlazeTestWorld.h"
+    #include "Tickable.h"
 
 namespace BlazeAsyncLoadTests
 {
@@ -16,72 +24,24 @@ namespace BlazeAsyncLoadTests
 
     UE_DEFINE_GAMEPLAY_TAG_STATIC(TestLayerTag, "Blaze.Test.Layer");
 
-    class FTestWorld
-    {
-    public:
-        FTestWorld()
-        {
-            if (GEngine)
-            {
-                World = UWorld::CreateWorld(EWorldType::Game,
-                                            false,
-                                            MakeUniqueObjectName(GetTransientPackage(),
-                                                                 UWorld::StaticClass(),
-                                                                 FName(TEXT("BlazeAutomationTestWorld"))),
-                                            GetTransientPackage(),
-                                            true);
-                if (World)
-                {
-                    World->SetShouldTick(false);
-                    World->AddToRoot();
-
-                    auto& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
-                    WorldContext.SetCurrentWorld(World);
-                }
-            }
-        }
-
-        ~FTestWorld()
-        {
-            if (World)
-            {
-                World->RemoveFromRoot();
-                if (GEngine)
-                {
-                    GEngine->DestroyWorldContext(World);
-                }
-                World->DestroyWorld(false);
-            }
-        }
-
-        bool IsValid() const { return nullptr != World; }
-
-        template <typename TActor>
-        TActor* SpawnActor() const
-        {
-            if (World)
-            {
-                FActorSpawnParameters SpawnParameters;
-                SpawnParameters.ObjectFlags |= RF_Transient;
-                SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-                return World->SpawnActor<TActor>(TActor::StaticClass(),
-                                                 FVector::ZeroVector,
-                                                 FRotator::ZeroRotator,
-                                                 SpawnParameters);
-            }
-            else
-            {
-                return nullptr;
-            }
-        }
-
-        UWorld* Get() const { return World; }
+    void ForceLinkAsyncLoadTests() {}
 
-    private:
-        UWorld* World{ nullptr };
-    };
+    #if BLAZE_WITH_COROUTINES
+    FBlazeCoroutine PushThenWaitUntilPopped(UBlazePrimaryLayout* Layout,
+                                            bool& bOutFinished,
+                                            UCommonActivatableWidget*& OutWidget)
+    {
+        OutWidget = co_await FBlazePushWidgetAwaitable(Layout, TestLayerTag, TSoftClassPtr<UCommonActivatableWidget>());
+        co_await FBlazeWidgetPoppedAwaitable(OutWidget);
+        bOutFinished = true;
+    }
 
-    void ForceLinkAsyncLoadTests() {}
+    FBlazeCoroutine WaitUntilPopped(UCommonActivatableWidget* Widget, bool& bOutPopped)
+    {
+        co_await FBlazeWidgetPoppedAwaitable(Widget);
+        bOutPopped = true;
+    }
+    #endif
 } // namespace BlazeAsyncLoadTests
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazeCreateWidgetAsyncCancelsWhenLoadHandleInvalidTest,
@@ -89,7 +49,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazeCreateWidgetAsyncCancelsWhenLoadHandleInv
                                  BlazeAsyncLoadTests::AutomationTestFlags)
 bool FBlazeCreateWidgetAsyncCancelsWhenLoadHandleInvalidTest::RunTest(const FString&)
 {
-    const auto World = MakeUnique<BlazeAsyncLoadTests::FTestWorld>();
+    const auto World = MakeUnique<FBlazeTestWorld>();
     if (TestNotNull(TEXT("Automation test world should be created"), World.Get())
         && TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
     {
@@ -155,6 +115,7 @@ bool FBlazePrimaryLayoutCancelsWhenLoadHandleInvalidTest::RunTest(const FString&
         auto bWasCalled{ false };
         auto CallbackState{ EBlazePushWidgetToLayerState::AfterPush };
         UCommonActivatableWidget* CallbackWidget = reinterpret_cast<UCommonActivatableWidget*>(0x1);
+        const auto NumLiveRequests = FBlazePushRequest::GetNumLiveRequests();
 
         const auto Handle = Layout->PushWidgetToLayerAsync<UCommonActivatableWidget>(
             BlazeAsyncLoadTests::TestLayerTag,
@@ -175,12 +136,229 @@ bool FBlazePrimaryLayoutCancelsWhenLoadHandleInvalidTest::RunTest(const FString&
                                               EBlazePushWidgetToLayerState::Canceled);
         const auto bNullWidget =
             TestNull(TEXT("Invalid async widget loads should not provide a widget"), CallbackWidget);
-        return bInvalidHandle && bCancelled && bCanceledState && bNullWidget;
+        const auto bReleased = TestEqual(TEXT("Invalid async widget loads should return the request to the pool"),
+                                         FBlazePushRequest::GetNumLiveRequests(),
+                                         NumLiveRequests);
+        return bInvalidHandle && bCancelled && bCanceledState && bNullWidget && bReleased;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazeDependencyClosureFollowsDisplayedAssetsTest,
+                                 "Blaze.DependencyClosure.FollowsDisplayedAssets",
+                                 BlazeAsyncLoadTests::AutomationTestFlags)
+bool FBlazeDependencyClosureFollowsDisplayedAssetsTest::RunTest(const FString&)
+{
+    const FSoftObjectPath WidgetPath(TEXT("/Game/UI/W_Menu.W_Menu_C"));
+    const FSoftObjectPath TexturePath(TEXT("/Game/UI/T_Icon.T_Icon"));
+    const FSoftObjectPath LevelPath(TEXT("/Game/Maps/L_Arena.L_Arena"));
+
+    // The widget softly references the texture that it displays and the level that it travels to
+    const auto GetDependencies = [&](const FName PackageName, TArray<FAssetDependency>& OutDependencies) {
+        if (WidgetPath.GetLongPackageFName() == PackageName)
+        {
+            for (const auto& Path : { TexturePath, LevelPath })
+            {
+                FAssetDependency Dependency;
+                Dependency.AssetId = FAssetIdentifier(Path.GetLongPackageFName());
+                Dependency.Category = UE::AssetRegistry::EDependencyCategory::Package;
+                Dependency.Properties = UE::AssetRegistry::EDependencyProperty::None;
+                OutDependencies.Add(Dependency);
+            }
+        }
+    };
+    const auto GetAssets = [&](const FName PackageName, TArray<FAssetData>& OutAssets) {
+        if (TexturePath.GetLongPackageFName() == PackageName)
+        {
+            OutAssets.Emplace(PackageName,
+                              FName(TEXT("/Game/UI")),
+                              TexturePath.GetAssetFName(),
+                              UTexture2D::StaticClass()->GetClassPathName());
+        }
+        else if (LevelPath.GetLongPackageFName() == PackageName)
+        {
+            OutAssets.Emplace(PackageName,
+                              FName(TEXT("/Game/Maps")),
+                              LevelPath.GetAssetFName(),
+                              UWorld::StaticClass()->GetClassPathName());
+        }
+    };
+
+    const auto Paths = FBlazeDependencyClosure::ComputeClosure(WidgetPath,
+                                                               1,
+                                                               FBlazeDependencyClosure::GetPreloadClasses(),
+                                                               GetDependencies,
+                                                               GetAssets);
+    const auto bWidget =
+        TestTrue(TEXT("Closure should start with the widget class"), Paths.Num() > 0 && Paths[0] == WidgetPath);
+    const auto bTexture = TestTrue(TEXT("Closure should include the texture"), Paths.Contains(TexturePath));
+    const auto bLevel = TestFalse(TEXT("Closure should exclude the level"), Paths.Contains(LevelPath));
+    return bWidget && bTexture && bLevel;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutRevealsWhenResidentTest,
+                                 "Blaze.PrimaryLayout.RevealsWhenResident",
+                                 BlazeAsyncLoadTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutRevealsWhenResidentTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    const auto Depth = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.Preload.SoftReferenceDepth"));
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestNotNull(TEXT("Preload depth console variable should exist"), Depth))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            // Load the class directly rather than waiting on a dependency closure computed on a worker thread
+            const auto PreviousDepth = Depth->GetInt();
+            Depth->Set(0, ECVF_SetByCode);
+
+            // The stack only activates the displayed widget once it has constructed its Slate widget
+            Layout->AddTestLayer(BlazeAsyncLoadTests::TestLayerTag)->TakeWidget();
+            auto bHeldOnInitialize{ false };
+            auto bCollapsedOnInitialize{ false };
+            UCommonActivatableWidget* Widget{ nullptr };
+            Layout->PushWidgetToLayerAsync<UCommonActivatableWidget>(
+                BlazeAsyncLoadTests::TestLayerTag,
+                false,
+                TSoftClassPtr<UCommonActivatableWidget>(UBlazeAutomationTestActivatableWidget::StaticClass()),
+                [&](const auto State, auto* InWidget) {
+                    if (EBlazePushWidgetToLayerState::Initialize == State)
+                    {
+                        bHeldOnInitialize = FBlazeResidencyGate::IsHeld(*InWidget);
+                        bCollapsedOnInitialize = ESlateVisibility::Collapsed == InWidget->GetVisibility();
+                    }
+                    else if (EBlazePushWidgetToLayerState::AfterPush == State)
+                    {
+                        Widget = InWidget;
+                    }
+                },
+                true);
+
+            FTickableGameObject::TickObjects(World->Get(), LEVELTICK_All, false, 0.0f);
+            Depth->Set(PreviousDepth, ECVF_SetByCode);
+
+            if (TestNotNull(TEXT("Widget should be pushed"), Widget))
+            {
+                const auto bGatedBeforePush = TestTrue(TEXT("Widget should be collapsed before it is added"),
+                                                       bHeldOnInitialize && bCollapsedOnInitialize);
+                const auto bHeld = TestTrue(TEXT("Widget should remain collapsed after activation"),
+                                            Widget->IsActivated()
+                                                && ESlateVisibility::Collapsed == Widget->GetVisibility());
+
+                // The widget references no textures so it is revealed on the next tick of the gate
+                FBlazeResidencyGate::Tick(0.0f);
+                const auto bRevealed = TestTrue(TEXT("Widget should be revealed with its original visibility"),
+                                                !FBlazeResidencyGate::IsHeld(*Widget)
+                                                    && ESlateVisibility::Collapsed != Widget->GetVisibility());
+
+                const auto Hidden = CreateWidget<UBlazeAutomationTestActivatableWidget>(World->Get());
+                FBlazeResidencyGate::Hold(*Hidden);
+                Hidden->SetVisibility(ESlateVisibility::Hidden);
+                FBlazeResidencyGate::Tick(0.0f);
+                const auto bKeptVisibility =
+                    TestTrue(TEXT("Visibility set while the widget is held should be kept when it is revealed"),
+                             !FBlazeResidencyGate::IsHeld(*Hidden)
+                                 && ESlateVisibility::Hidden == Hidden->GetVisibility());
+
+                return bGatedBeforePush && bHeld && bRevealed && bKeptVisibility;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+    #if BLAZE_WITH_COROUTINES
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazeCoroutinePushResumesWhenLoadHandleInvalidTest,
+                                 "Blaze.Coroutines.PushResumesWhenLoadHandleInvalid",
+                                 BlazeAsyncLoadTests::AutomationTestFlags)
+bool FBlazeCoroutinePushResumesWhenLoadHandleInvalidTest::RunTest(const FString&)
+{
+    const auto Layout = NewObject<UBlazeAutomationTestPrimaryLayout>(GetTransientPackage(), NAME_None, RF_Transient);
+    if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+    {
+        auto bFinished{ false };
+        UCommonActivatableWidget* Widget = reinterpret_cast<UCommonActivatableWidget*>(0x1);
+
+        BlazeAsyncLoadTests::PushThenWaitUntilPopped(Layout, bFinished, Widget);
+
+        const auto bNullWidget = TestNull(TEXT("Invalid async widget loads should resume with no widget"), Widget);
+        const auto bFinishedFlow =
+            TestTrue(TEXT("Coroutine should run to completion without suspending"), bFinished);
+        return bNullWidget && bFinishedFlow;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazeCoroutineResumesWhenWidgetPoppedTest,
+                                 "Blaze.Coroutines.ResumesWhenWidgetPopped",
+                                 BlazeAsyncLoadTests::AutomationTestFlags)
+bool FBlazeCoroutineResumesWhenWidgetPoppedTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazeAsyncLoadTests::TestLayerTag;
+            // The stack only activates and deactivates the displayed widget once it has constructed its Slate widget
+            Layout->AddTestLayer(LayerTag)->TakeWidget();
+            const auto Widget =
+                Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+
+            auto bPopped{ false };
+            BlazeAsyncLoadTests::WaitUntilPopped(Widget, bPopped);
+            const auto bSuspended = TestFalse(TEXT("Coroutine should wait while the widget is displayed"), bPopped);
+
+            const auto Cover =
+                Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+            const auto bCovered =
+                TestFalse(TEXT("Coroutine should wait while the widget is covered by another widget"), bPopped);
+            Layout->RemoveWidgetFromLayer(LayerTag, Cover);
+            const auto bUncovered =
+                TestFalse(TEXT("Coroutine should wait once the covering widget is popped"), bPopped);
+
+            Layout->RemoveWidgetFromLayer(LayerTag, Widget);
+            const auto bResumed = TestTrue(TEXT("Coroutine should resume once the widget is popped"), bPopped);
+
+            auto bCollected{ false };
+            const auto Unreferenced = CreateWidget<UBlazeAutomationTestActivatableWidget>(World->Get());
+            BlazeAsyncLoadTests::WaitUntilPopped(Unreferenced, bCollected);
+            Unreferenced->MarkAsGarbage();
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            const auto bResumedOnCollect =
+                TestTrue(TEXT("Coroutine should resume once the widget is garbage collected"), bCollected);
+
+            return bSuspended && bCovered && bUncovered && bResumed && bResumedOnCollect;
+        }
+        else
+        {
+            return false;
+        }
     }
     else
     {
         return false;
     }
 }
+    #endif
 
 #endif
@@ -1,14 +1,145 @@
 #pragma once
 
 #include "Blaze/Actions/AsyncAction_CreateWidgetAsync.h"
+#include "Blaze/BlazeActivatableWidgetStack.h"
+#include "Blaze/BlazeFeedView.h"
+#include "Blaze/BlazeLayoutDefinition.h"
+#include "Blaze/BlazePayloadReceiver.h"
 #include "Blaze/BlazePrimaryLayout.h"
+#include "Blaze/BlazePrimaryLayoutManager.h"
+#include "Blaze/BlazeSubsystem.h"
 #include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "CommonActivatableWidget.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/PlayerController.h"
+#include "Widgets/CommonActivatableWidgetContainer.h"
 #include "BlazeAutomationTestTypes.generated.h"
 
+UCLASS(NotBlueprintable)
+class UBlazeAutomationTestActivatableWidget final : public UCommonActivatableWidget
+{
+    GENERATED_BODY()
+};
+
+USTRUCT()
+struct FBlazeAutomationTestPayload
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    int32 Value{ 0 };
+};
+
+UCLASS(NotBlueprintable)
+class UBlazeAutomationTestPayloadWidget final : public UCommonActivatableWidget, public IBlazePayloadReceiver
+{
+    GENERATED_BODY()
+
+public:
+    virtual void ReceivePayload(FInstancedStruct&& Payload) override
+    {
+        bReceivedBeforeConstruct = !bConstructed;
+        if (const auto TestPayload = Payload.GetPtr<FBlazeAutomationTestPayload>())
+        {
+            ReceivedValue = TestPayload->Value;
+        }
+    }
+
+    virtual void MergePayload(FInstancedStruct& Payload, FInstancedStruct&& Incoming) const override
+    {
+        const auto TestPayload = Payload.GetMutablePtr<FBlazeAutomationTestPayload>();
+        const auto IncomingPayload = Incoming.GetPtr<FBlazeAutomationTestPayload>();
+        if (TestPayload && IncomingPayload)
+        {
+            TestPayload->Value += IncomingPayload->Value;
+        }
+    }
+
+    int32 ReceivedValue{ INDEX_NONE };
+    bool bReceivedBeforeConstruct{ false };
+    bool bConstructed{ false };
+
+protected:
+    virtual void NativeConstruct() override
+    {
+        Super::NativeConstruct();
+        bConstructed = true;
+    }
+};
+
+UCLASS(NotBlueprintable)
+class UBlazeAutomationTestFeedEntryWidget final : public UUserWidget, public IBlazePayloadReceiver
+{
+    GENERATED_BODY()
+
+public:
+    virtual void ReceivePayload(FInstancedStruct&& Payload) override
+    {
+        NumReceived++;
+        if (const auto TestPayload = Payload.GetPtr<FBlazeAutomationTestPayload>())
+        {
+            ReceivedValue = TestPayload->Value;
+        }
+    }
+
+    int32 ReceivedValue{ INDEX_NONE };
+    int32 NumReceived{ 0 };
+};
+
+UCLASS(NotBlueprintable)
+class UBlazeAutomationTestFeedView final : public UBlazeFeedView
+{
+    GENERATED_BODY()
+
+public:
+    void Configure(const int32 InNumVisibleEntries, const int32 InMaxEntries)
+    {
+        EntryWidgetClass = UBlazeAutomationTestFeedEntryWidget::StaticClass();
+        NumVisibleEntries = InNumVisibleEntries;
+        MaxEntries = InMaxEntries;
+    }
+};
+
 UCLASS(NotBlueprintable)
 class UBlazeAutomationTestPrimaryLayout final : public UBlazePrimaryLayout
 {
     GENERATED_BODY()
+
+public:
+    template <typename StackT = UCommonActivatableWidgetStack>
+    StackT* AddTestLayer(const FGameplayTag LayerTag, const FBlazeLayerConfig& Config = FBlazeLayerConfig())
+    {
+        const auto Stack = WidgetTree->ConstructWidget<StackT>();
+        RegisterLayer(LayerTag, Stack, Config);
+        return Stack;
+    }
+
+    void AddTestHeadlessLayer(const FGameplayTag LayerTag, const FBlazeLayerConfig& Config)
+    {
+        RegisterHeadlessLayer(LayerTag, Config);
+    }
+
+    void AddTestFeedLayer(const FGameplayTag LayerTag, UBlazeFeedView* Feed) { RegisterFeedLayer(LayerTag, Feed); }
+
+    /** Construct the widgets of the snapshot being restored as the ticker does on each frame. */
+    bool TickTestRestoreSnapshot() { return TickRestoreSnapshot(0.f); }
+
+    /** Display the waiting entries of queue layers as the ticker does on each frame. */
+    bool TickTestQueuedEntries() { return TickQueuedEntries(0.f); }
+};
+
+UCLASS(NotBlueprintable)
+class UBlazeAutomationTestDefinitionPrimaryLayout final : public UBlazePrimaryLayout
+{
+    GENERATED_BODY()
+
+public:
+    /** Set the definition that instances created afterwards build their layers from. */
+    static void SetTestLayoutDefinition(UBlazeLayoutDefinition* Definition)
+    {
+        GetMutableDefault<ThisClass>()->LayoutDefinition = Definition;
+    }
 };
 
 UCLASS(NotBlueprintable)
@@ -47,3 +178,79 @@ public:
         return Action;
     }
 };
+
+UCLASS(NotBlueprintable)
+class UBlazeAutomationTestGameInstance final : public UGameInstance
+{
+    GENERATED_BODY()
+
+public:
+    void SetTestWorldContext(FWorldContext& InWorldContext)
+    {
+        WorldContext = &InWorldContext;
+        InWorldContext.OwningGameInstance = this;
+        InWorldContext.World()->SetGameInstance(this);
+    }
+};
+
+/** A subsystem that is only created for UBlazeAutomationTestGameInstance. */
+UCLASS(NotBlueprintable)
+class UBlazeAutomationTestSubsystem final : public UBlazeSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override
+    {
+        return Outer && Outer->IsA<UBlazeAutomationTestGameInstance>();
+    }
+};
+
+UCLASS(NotBlueprintable)
+class UBlazeAutomationTestPrimaryLayoutManager final : public UBlazePrimaryLayoutManager
+{
+    GENERATED_BODY()
+
+public:
+    /** The layer registered on each layout created by the manager. */
+    UPROPERTY(Transient)
+    FGameplayTag LayerTag{ FGameplayTag::EmptyTag };
+
+    /** The layer registered on the shared layout, which is only created if the tag is valid. */
+    UPROPERTY(Transient)
+    FGameplayTag SharedLayerTag{ FGameplayTag::EmptyTag };
+
+    /** The number of times PrepareToCreatePrimaryLayouts has been invoked. */
+    int32 NumPrepareCalls{ 0 };
+
+    void SetSharedInputOwner(const EBlazeSharedInputOwner InSharedInputOwner)
+    {
+        SharedInputOwner = InSharedInputOwner;
+    }
+
+    void SetBatchPlayerJoins(const bool bInBatchPlayerJoins) { bBatchPlayerJoins = bInBatchPlayerJoins; }
+
+protected:
+    virtual void PrepareToCreatePrimaryLayouts(const int32 NumPlayers) override { NumPrepareCalls++; }
+
+    virtual UBlazePrimaryLayout* CreatePrimaryLayout(APlayerController* PlayerController) override
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(PlayerController);
+        if (Layout)
+        {
+            Layout->AddTestLayer(LayerTag);
+        }
+        return Layout;
+    }
+
+    virtual UBlazePrimaryLayout* CreateSharedLayout(APlayerController* PlayerController) override
+    {
+        const auto Layout =
+            SharedLayerTag.IsValid() ? CreateWidget<UBlazeAutomationTestPrimaryLayout>(PlayerController) : nullptr;
+        if (Layout)
+        {
+            Layout->AddTestLayer(SharedLayerTag);
+        }
+        return Layout;
+    }
+};
@@ -0,0 +1,1900 @@
+#if WITH_DEV_AUTOMATION_TESTS
+
+    #include "Blaze/BlazeActivatableWidgetStack.h"
+    #include "Blaze/BlazeFunctionLibrary.h"
+    #include "Blaze/BlazeGarbageCollection.h"
+    #include "Blaze/BlazeHeadlessPrimaryLayout.h"
+    #include "Blaze/BlazeHitchDetector.h"
+    #include "Blaze/BlazeMemoryPressure.h"
+    #include "Blaze/BlazePrimaryLayout.h"
+    #include "Blaze/BlazeTransitionBudget.h"
+    #include "Blaze/BlazeViewModelStore.h"
+    #include "Blaze/BlazeWidgetQuery.h"
+    #include "Blueprint/UserWidget.h"
+    #include "CommonInputSubsystem.h"
+    #include "Components/Overlay.h"
+    #include "Components/PanelWidget.h"
+    #include "Engine/Engine.h"
+    #include "Engine/LocalPlayer.h"
+    #include "HAL/IConsoleManager.h"
+    #include "Misc/AutomationTest.h"
+    #include "NativeGameplayTags.h"
+    #include "Tests/Blaze/BlazeAutomationTestTypes.h"
+    #include "Tests/Blaze/BlazeTestWorld.h"
+    #include "Tickable.h"
+
+namespace BlazePrimaryLayoutTests
+{
+    constexpr auto AutomationTestFlags =
+        EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestLayerTag, "Blaze.Test.Layout.Layer");
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestSharedLayerTag, "Blaze.Test.Layout.SharedLayer");
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestFeedTag, "Blaze.Test.Layout.Feed");
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestModalLayerTag, "Blaze.Test.Layout.Modal");
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestHealthFieldTag, "Blaze.Test.ViewModel.Health");
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestAmmoFieldTag, "Blaze.Test.ViewModel.Ammo");
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestScoreFieldTag, "Blaze.Test.ViewModel.Score");
+
+    FBlazePushRequest PushAsync(UBlazePrimaryLayout& Layout, UClass* WidgetClass)
+    {
+        return Layout.PushWidgetToLayerAsync(TestLayerTag,
+                                             false,
+                                             TSoftClassPtr<UCommonActivatableWidget>(WidgetClass),
+                                             FBlazePushRequestDelegate());
+    }
+
+    TArray<UClass*> GetLayerWidgetClasses(const UBlazePrimaryLayout& Layout)
+    {
+        TArray<UCommonActivatableWidget*> Widgets;
+        Layout.GetLayerWidgets(TestLayerTag, Widgets);
+        TArray<UClass*> WidgetClasses;
+        for (const auto Widget : Widgets)
+        {
+            WidgetClasses.Add(Widget->GetClass());
+        }
+        return WidgetClasses;
+    }
+
+    void ForceLinkPrimaryLayoutTests() {}
+} // namespace BlazePrimaryLayoutTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutTransactionDefersPushesTest,
+                                 "Blaze.PrimaryLayout.TransactionDefersPushes",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutTransactionDefersPushesTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            const auto Layer = Layout->AddTestLayer(LayerTag);
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+
+            Layout->BeginLayerTransaction();
+            const auto Kept = Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+            const auto Discarded = Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+
+            const auto bCreated = TestNotNull(TEXT("Pushes within a transaction should create the widget"), Kept)
+                && TestNotNull(TEXT("Pushes within a transaction should create the widget"), Discarded);
+            const auto bDeferred =
+                TestEqual(TEXT("Pushes within a transaction should be deferred"), Layer->GetNumWidgets(), 0);
+
+            if (Discarded)
+            {
+                Layout->RemoveWidgetFromLayer(LayerTag, Discarded);
+            }
+            Layout->CommitLayerTransaction();
+
+            const auto bClosed =
+                TestFalse(TEXT("The transaction should be closed after commit"), Layout->IsInLayerTransaction());
+            const auto bApplied =
+                TestEqual(TEXT("Committing should apply the remaining push"), Layer->GetNumWidgets(), 1);
+            const auto bKept =
+                TestTrue(TEXT("The kept widget should be in the layer"), Layer->GetWidgetList().Contains(Kept));
+            const auto bCancelledOut =
+                TestFalse(TEXT("A widget pushed and removed in one transaction should never be added"),
+                          Layer->GetWidgetList().Contains(Discarded));
+
+            // A Blaze stack places the earlier pushes below the last push without activating them
+            const auto& StackTag = BlazePrimaryLayoutTests::TestModalLayerTag;
+            const auto Stack = Layout->AddTestLayer<UBlazeActivatableWidgetStack>(StackTag, FBlazeLayerConfig());
+            Stack->TakeWidget();
+            auto Activations{ 0 };
+            TArray<UCommonActivatableWidget*> Pushed;
+            Layout->BeginLayerTransaction();
+            for (auto i = 0; i < 3; ++i)
+            {
+                const auto Widget = Pushed.Add_GetRef(Layout->PushWidgetToLayer(StackTag, WidgetClass));
+                Widget->OnActivated().AddLambda([&Activations] { Activations++; });
+            }
+            Layout->CommitLayerTransaction();
+            const auto bSingleActivation =
+                TestTrue(TEXT("Pushes should be stacked in the order they were made"), Stack->GetWidgetList() == Pushed)
+                && TestTrue(TEXT("The last push should be displayed"), Stack->GetActiveWidget() == Pushed[2])
+                && TestEqual(TEXT("Only the last push should be activated"), Activations, 1)
+                && TestTrue(TEXT("The last push should be active"), Pushed[2]->IsActivated());
+
+            return bCreated && bDeferred && bClosed && bApplied && bKept && bCancelledOut && bSingleActivation;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutClearLayerTest,
+                                 "Blaze.PrimaryLayout.ClearLayer",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutClearLayerTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        const auto Feed = CreateWidget<UBlazeAutomationTestFeedView>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout)
+            && TestNotNull(TEXT("Feed should be created"), Feed))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            const auto& FeedTag = BlazePrimaryLayoutTests::TestFeedTag;
+            // A headless layer removes widgets immediately so the layer is cleared without Slate transitions
+            Layout->AddTestHeadlessLayer(LayerTag, FBlazeLayerConfig());
+            Feed->Configure(4, 50);
+            Layout->AddTestFeedLayer(FeedTag, Feed);
+            const auto GetNumWidgets = [Layout, &LayerTag] {
+                TArray<UCommonActivatableWidget*> Widgets;
+                Layout->GetLayerWidgets(LayerTag, Widgets);
+                return Widgets.Num();
+            };
+
+            const auto bEmpty =
+                TestEqual(TEXT("Clearing an empty layer should remove nothing"), Layout->ClearLayer(LayerTag), 0);
+
+            for (auto i = 0; i < 3; ++i)
+            {
+                Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+            }
+            const auto bCleared =
+                TestEqual(TEXT("Clearing should report every widget removed"), Layout->ClearLayer(LayerTag), 3)
+                && TestEqual(TEXT("Clearing should remove every widget"), GetNumWidgets(), 0);
+
+            for (auto i = 0; i < 3; ++i)
+            {
+                Layout->PushEntryToFeed(FeedTag, FInstancedStruct::Make(FBlazeAutomationTestPayload()));
+            }
+            const auto bFeedCleared =
+                TestEqual(TEXT("Clearing a feed should report every entry discarded"), Layout->ClearLayer(FeedTag), 3)
+                && TestEqual(TEXT("Clearing a feed should discard every entry"), Feed->GetNumEntries(), 0);
+
+            return bEmpty && bCleared && bFeedCleared;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutPopUntilTest,
+                                 "Blaze.PrimaryLayout.PopUntil",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutPopUntilTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Layout->AddTestHeadlessLayer(LayerTag, FBlazeLayerConfig());
+            const auto GetWidgets = [Layout, &LayerTag] {
+                TArray<UCommonActivatableWidget*> Widgets;
+                Layout->GetLayerWidgets(LayerTag, Widgets);
+                return Widgets;
+            };
+
+            TArray<UCommonActivatableWidget*> Pushed;
+            for (auto i = 0; i < 4; ++i)
+            {
+                Pushed.Add(Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestActivatableWidget::StaticClass()));
+            }
+
+            const auto bPopped = TestEqual(TEXT("PopUntil should report the widgets above the widget"),
+                                           Layout->PopUntil(LayerTag, Pushed[1]),
+                                           2)
+                && TestTrue(TEXT("PopUntil should leave the widget on top"),
+                            GetWidgets() == TArray<UCommonActivatableWidget*>({ Pushed[0], Pushed[1] }));
+            const auto bTop = TestEqual(TEXT("PopUntil on the top widget should remove nothing"),
+                                        Layout->PopUntil(LayerTag, Pushed[1]),
+                                        0)
+                && TestEqual(TEXT("PopUntil on the top widget should leave the layer alone"), GetWidgets().Num(), 2);
+
+            Layout->ClearLayer(LayerTag);
+            AddExpectedMessagePlain(TEXT("ignored as widget is not present on the Layer"),
+                                    ELogVerbosity::Warning,
+                                    EAutomationExpectedMessageFlags::Contains,
+                                    1);
+            const auto bEmpty = TestEqual(TEXT("PopUntil on an empty layer should remove nothing"),
+                                          Layout->PopUntil(LayerTag, Pushed[0]),
+                                          0);
+
+            return bPopped && bTop && bEmpty;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutPopAllTest,
+                                 "Blaze.PrimaryLayout.PopAll",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutPopAllTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            const auto& ModalLayerTag = BlazePrimaryLayoutTests::TestModalLayerTag;
+            Layout->AddTestHeadlessLayer(LayerTag, FBlazeLayerConfig());
+            Layout->AddTestHeadlessLayer(ModalLayerTag, FBlazeLayerConfig());
+            const auto GetWidgets = [Layout](const FGameplayTag& Tag) {
+                TArray<UCommonActivatableWidget*> Widgets;
+                Layout->GetLayerWidgets(Tag, Widgets);
+                return Widgets;
+            };
+            const auto PopAllOfClass = [Layout](const UClass* WidgetClass) {
+                return Layout->PopAll([WidgetClass](const FGameplayTag&, UCommonActivatableWidget& Widget) {
+                    return Widget.GetClass() == WidgetClass;
+                });
+            };
+
+            const auto bEmpty = TestEqual(TEXT("PopAll on empty layers should remove nothing"),
+                                          PopAllOfClass(UBlazeAutomationTestActivatableWidget::StaticClass()),
+                                          0);
+
+            const auto Kept = Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestPayloadWidget::StaticClass());
+            Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+            Layout->PushWidgetToLayer(ModalLayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+
+            const auto bPopped = TestEqual(TEXT("PopAll should report every matching widget"),
+                                           PopAllOfClass(UBlazeAutomationTestActivatableWidget::StaticClass()),
+                                           2)
+                && TestTrue(TEXT("PopAll should keep widgets that do not match"),
+                            GetWidgets(LayerTag) == TArray<UCommonActivatableWidget*>({ Kept }))
+                && TestTrue(TEXT("PopAll should remove matching widgets from every layer"),
+                            GetWidgets(ModalLayerTag).IsEmpty());
+
+            const auto bLayerFiltered =
+                TestEqual(TEXT("PopAll should only remove widgets on the layers the predicate selects"),
+                          Layout->PopAll([&ModalLayerTag](const FGameplayTag& Tag, UCommonActivatableWidget&) {
+                              return ModalLayerTag == Tag;
+                          }),
+                          0)
+                && TestEqual(TEXT("Widgets on other layers should remain"), GetWidgets(LayerTag).Num(), 1);
+
+            return bEmpty && bPopped && bLayerFiltered;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutCancelsPushesOnDestructTest,
+                                 "Blaze.PrimaryLayout.CancelsPushesOnDestruct",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutCancelsPushesOnDestructTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Layout->AddTestHeadlessLayer(LayerTag, FBlazeLayerConfig());
+            // The layout is destructed once the Slate widget constructed for it is released
+            Layout->TakeWidget();
+
+            auto CallbackState{ EBlazePushWidgetToLayerState::AfterPush };
+            const auto Request = Layout->PushWidgetToLayerAsync<UCommonActivatableWidget>(
+                LayerTag,
+                false,
+                TSoftClassPtr<UCommonActivatableWidget>(UBlazeAutomationTestActivatableWidget::StaticClass()),
+                [&CallbackState](const auto State, auto*) { CallbackState = State; });
+            const auto bPending = TestTrue(TEXT("Push should wait for the class to load"), Request.IsPending())
+                && TestEqual(TEXT("Layout should track the pending push"), Layout->GetNumPendingPushRequests(), 1);
+
+            Layout->ReleaseSlateResources(true);
+            const auto bCanceled =
+                TestTrue(TEXT("Destructing the layout should cancel the push"),
+                         EBlazePushRequestStatus::Canceled == Request.GetStatus())
+                && TestTrue(TEXT("Push delegate should be notified of the cancellation"),
+                            EBlazePushWidgetToLayerState::Canceled == CallbackState)
+                && TestEqual(TEXT("Layout should have no pending pushes"), Layout->GetNumPendingPushRequests(), 0);
+
+            // Complete the load, which must no longer push the widget
+            FTickableGameObject::TickObjects(World->Get(), LEVELTICK_All, false, 0.0f);
+            TArray<UCommonActivatableWidget*> Widgets;
+            Layout->GetLayerWidgets(LayerTag, Widgets);
+            const auto bNotPushed = TestTrue(TEXT("Canceled push should not add a widget"), Widgets.IsEmpty());
+
+            return bPending && bCanceled && bNotPushed;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutPushPolicyAllowAllTest,
+                                 "Blaze.PrimaryLayout.PushPolicyAllowAll",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutPushPolicyAllowAllTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    const auto Depth = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.Preload.SoftReferenceDepth"));
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestNotNull(TEXT("Preload depth console variable should exist"), Depth))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            // Load the classes directly rather than waiting on dependency closures computed on a worker thread
+            const auto PreviousDepth = Depth->GetInt();
+            Depth->Set(0, ECVF_SetByCode);
+
+            FBlazeLayerConfig Config;
+            Config.PushPolicy = EBlazePushPolicy::AllowAll;
+            Layout->AddTestHeadlessLayer(BlazePrimaryLayoutTests::TestLayerTag, Config);
+            const auto WidgetA = UBlazeAutomationTestActivatableWidget::StaticClass();
+            const auto WidgetB = UBlazeAutomationTestPayloadWidget::StaticClass();
+
+            const auto First = BlazePrimaryLayoutTests::PushAsync(*Layout, WidgetA);
+            const auto Second = BlazePrimaryLayoutTests::PushAsync(*Layout, WidgetB);
+            const auto Third = BlazePrimaryLayoutTests::PushAsync(*Layout, WidgetA);
+            const auto bRequested = TestTrue(TEXT("Every request should be pending"),
+                                             First.IsPending() && Second.IsPending() && Third.IsPending());
+
+            FTickableGameObject::TickObjects(World->Get(), LEVELTICK_All, false, 0.0f);
+            Depth->Set(PreviousDepth, ECVF_SetByCode);
+
+            const auto bStack = TestTrue(TEXT("Layer should hold a widget for every request in request order"),
+                                         BlazePrimaryLayoutTests::GetLayerWidgetClasses(*Layout)
+                                             == TArray<UClass*>({ WidgetA, WidgetB, WidgetA }));
+            return bRequested && bStack;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutPushPolicyDropDuplicateClassTest,
+                                 "Blaze.PrimaryLayout.PushPolicyDropDuplicateClass",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutPushPolicyDropDuplicateClassTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    const auto Depth = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.Preload.SoftReferenceDepth"));
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestNotNull(TEXT("Preload depth console variable should exist"), Depth))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            // Load the classes directly rather than waiting on dependency closures computed on a worker thread
+            const auto PreviousDepth = Depth->GetInt();
+            Depth->Set(0, ECVF_SetByCode);
+
+            FBlazeLayerConfig Config;
+            Config.PushPolicy = EBlazePushPolicy::DropDuplicateClass;
+            Config.DuplicateWindow = 60.f;
+            Layout->AddTestHeadlessLayer(BlazePrimaryLayoutTests::TestLayerTag, Config);
+            const auto WidgetA = UBlazeAutomationTestActivatableWidget::StaticClass();
+            const auto WidgetB = UBlazeAutomationTestPayloadWidget::StaticClass();
+
+            const auto First = BlazePrimaryLayoutTests::PushAsync(*Layout, WidgetA);
+            const auto Second = BlazePrimaryLayoutTests::PushAsync(*Layout, WidgetB);
+            const auto Third = BlazePrimaryLayoutTests::PushAsync(*Layout, WidgetA);
+            const auto bRequested =
+                TestTrue(TEXT("First request for each class should be pending"),
+                         First.IsPending() && Second.IsPending())
+                && TestFalse(TEXT("Request for a class that is pending should be dropped"), Third.IsValid());
+
+            FTickableGameObject::TickObjects(World->Get(), LEVELTICK_All, false, 0.0f);
+            Depth->Set(PreviousDepth, ECVF_SetByCode);
+
+            const auto bStack = TestTrue(TEXT("Layer should hold one widget per class"),
+                                         BlazePrimaryLayoutTests::GetLayerWidgetClasses(*Layout)
+                                             == TArray<UClass*>({ WidgetA, WidgetB }));
+            return bRequested && bStack;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutPushPolicyLatestWinsTest,
+                                 "Blaze.PrimaryLayout.PushPolicyLatestWins",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutPushPolicyLatestWinsTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    const auto Depth = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.Preload.SoftReferenceDepth"));
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestNotNull(TEXT("Preload depth console variable should exist"), Depth))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            // Load the classes directly rather than waiting on dependency closures computed on a worker thread
+            const auto PreviousDepth = Depth->GetInt();
+            Depth->Set(0, ECVF_SetByCode);
+
+            FBlazeLayerConfig Config;
+            Config.PushPolicy = EBlazePushPolicy::LatestWins;
+            Layout->AddTestHeadlessLayer(BlazePrimaryLayoutTests::TestLayerTag, Config);
+            const auto WidgetA = UBlazeAutomationTestActivatableWidget::StaticClass();
+            const auto WidgetB = UBlazeAutomationTestPayloadWidget::StaticClass();
+
+            const auto First = BlazePrimaryLayoutTests::PushAsync(*Layout, WidgetA);
+            const auto Second = BlazePrimaryLayoutTests::PushAsync(*Layout, WidgetB);
+            const auto bRequested =
+                TestTrue(TEXT("Latest request should be pending"), Second.IsPending())
+                && TestTrue(TEXT("Earlier request should be canceled"),
+                            EBlazePushRequestStatus::Canceled == First.GetStatus());
+
+            FTickableGameObject::TickObjects(World->Get(), LEVELTICK_All, false, 0.0f);
+            Depth->Set(PreviousDepth, ECVF_SetByCode);
+
+            const auto bStack = TestTrue(TEXT("Layer should only hold the widget of the latest request"),
+                                         BlazePrimaryLayoutTests::GetLayerWidgetClasses(*Layout)
+                                             == TArray<UClass*>({ WidgetB }));
+            return bRequested && bStack;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutCaptureSnapshotTest,
+                                 "Blaze.PrimaryLayout.CaptureSnapshot",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutCaptureSnapshotTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Layout->AddTestLayer(LayerTag);
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+            Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+            Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+
+            const auto Snapshot = Layout->CaptureSnapshot();
+            if (TestEqual(TEXT("Snapshot should contain the populated layer"), Snapshot.Layers.Num(), 1))
+            {
+                const auto& LayerSnapshot = Snapshot.Layers[0];
+                const auto bLayerName =
+                    TestEqual(TEXT("Snapshot should record the layer name"), LayerSnapshot.LayerName, LayerTag);
+                const auto bWidgets =
+                    TestEqual(TEXT("Snapshot should record every widget"), LayerSnapshot.Widgets.Num(), 2);
+                const auto bClass = TestTrue(TEXT("Snapshot should record the widget class"),
+                                             LayerSnapshot.Widgets.Num() > 0
+                                                 && LayerSnapshot.Widgets[0].WidgetClass.Get() == WidgetClass);
+                return bLayerName && bWidgets && bClass;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutRestoreSnapshotAcrossFramesTest,
+                                 "Blaze.PrimaryLayout.RestoreSnapshotAcrossFrames",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutRestoreSnapshotAcrossFramesTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    const auto Budget = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.Restore.FrameBudgetMs"));
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestNotNull(TEXT("Restore budget console variable should exist"), Budget))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            // A headless layer removes widgets immediately so the restore replaces the layer without Slate
+            Layout->AddTestHeadlessLayer(LayerTag, FBlazeLayerConfig());
+            const TArray<UClass*> WidgetClasses({ UBlazeAutomationTestActivatableWidget::StaticClass(),
+                                                  UBlazeAutomationTestPayloadWidget::StaticClass(),
+                                                  UBlazeAutomationTestActivatableWidget::StaticClass() });
+            for (const auto WidgetClass : WidgetClasses)
+            {
+                Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+            }
+            const auto Snapshot = Layout->CaptureSnapshot();
+            Layout->ClearLayer(LayerTag);
+            const auto Replaced =
+                Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+
+            const auto GetWidgets = [Layout, &LayerTag] {
+                TArray<UCommonActivatableWidget*> Widgets;
+                Layout->GetLayerWidgets(LayerTag, Widgets);
+                return Widgets;
+            };
+
+            // No time is available so a single widget is constructed per frame
+            const auto PreviousBudget = Budget->GetFloat();
+            Budget->Set(0.f, ECVF_SetByCode);
+            auto NumCompletions{ 0 };
+            auto bRestored{ false };
+            Layout->RestoreSnapshot(Snapshot, [&NumCompletions, &bRestored](const bool bSuccess) {
+                NumCompletions++;
+                bRestored = bSuccess;
+            });
+            // The classes are already loaded so the load completes when the streamable manager next ticks
+            FTickableGameObject::TickObjects(World->Get(), LEVELTICK_All, false, 0.0f);
+
+            auto NumFrames{ 1 };
+            auto bUnchanged{ true };
+            while (Layout->IsRestoringSnapshot() && NumFrames <= WidgetClasses.Num() + 1)
+            {
+                bUnchanged &= GetWidgets() == TArray<UCommonActivatableWidget*>({ Replaced });
+                Layout->TickTestRestoreSnapshot();
+                NumFrames++;
+            }
+            Budget->Set(PreviousBudget, ECVF_SetByCode);
+
+            const auto Widgets = GetWidgets();
+            const auto bSpread =
+                TestTrue(TEXT("Layer should be left unchanged until every widget is constructed"), bUnchanged)
+                && TestEqual(TEXT("Construction should be spread over a frame per widget and a final frame"),
+                             NumFrames,
+                             WidgetClasses.Num() + 1);
+            const auto bCompleted = TestFalse(TEXT("Restore should complete"), Layout->IsRestoringSnapshot())
+                && TestEqual(TEXT("Completion callback should be invoked once"), NumCompletions, 1)
+                && TestTrue(TEXT("Completion callback should report success"), bRestored);
+            const auto bReplaced = TestEqual(TEXT("Layer should hold every restored widget"), Widgets.Num(), 3)
+                && TestFalse(TEXT("Restore should replace the widgets on the layer"), Widgets.Contains(Replaced))
+                && TestTrue(TEXT("Restored widgets should keep their order"),
+                            3 == Widgets.Num() && Widgets[0]->GetClass() == WidgetClasses[0]
+                                && Widgets[1]->GetClass() == WidgetClasses[1]
+                                && Widgets[2]->GetClass() == WidgetClasses[2]);
+            return bSpread && bCompleted && bReplaced;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutRehydratesBelowDisplayedWidgetTest,
+                                 "Blaze.PrimaryLayout.RehydratesBelowDisplayedWidget",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutRehydratesBelowDisplayedWidgetTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            FBlazeLayerConfig Config;
+            Config.DehydrateDepth = 1;
+            const auto Stack = Layout->AddTestLayer<UBlazeActivatableWidgetStack>(LayerTag, Config);
+            // The stack only releases the widgets it removes once it has constructed its Slate widget
+            Stack->TakeWidget();
+
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+            TArray<UCommonActivatableWidget*> Pushed;
+            for (auto i = 0; i < 4; ++i)
+            {
+                Pushed.Add(Layout->PushWidgetToLayer(LayerTag, WidgetClass));
+            }
+            const auto NumWidgets = [Layout] {
+                const auto Snapshot = Layout->CaptureSnapshot();
+                return Snapshot.Layers.IsEmpty() ? 0 : Snapshot.Layers[0].Widgets.Num();
+            };
+
+            const auto bDehydrated =
+                TestEqual(TEXT("Layer should keep the displayed widget and one widget below it alive"),
+                          Stack->GetNumWidgets(),
+                          2)
+                && TestEqual(TEXT("Layer should retain the dehydrated widgets"), NumWidgets(), 4);
+
+            Layout->RemoveWidgetFromLayer(LayerTag, Pushed[3]);
+            const auto bRehydrated =
+                TestEqual(TEXT("Popping to the last live widget should rehydrate the widget below it"),
+                          Stack->GetNumWidgets(),
+                          2)
+                && TestTrue(TEXT("Rehydration should not change the displayed widget"),
+                            Stack->GetActiveWidget() == Pushed[2] && Stack->GetWidgetList()[1] == Pushed[2])
+                && TestTrue(TEXT("Rehydrated widget should be a new instance of the dehydrated class"),
+                            Stack->GetWidgetList()[0] != Pushed[1] && Stack->GetWidgetList()[0]->IsA(WidgetClass))
+                && TestEqual(TEXT("Layer should retain the remaining dehydrated widget"), NumWidgets(), 3);
+
+            const auto Rehydrated = Stack->GetWidgetList()[0];
+            Layout->RemoveWidgetFromLayer(LayerTag, Pushed[2]);
+            const auto bBottom = TestEqual(TEXT("Popping again should rehydrate the bottom widget"),
+                                           Stack->GetNumWidgets(),
+                                           2)
+                && TestTrue(TEXT("Rehydrated widget should be displayed once navigation returns to it"),
+                            Stack->GetActiveWidget() == Rehydrated)
+                && TestEqual(TEXT("Layer should have no dehydrated widgets left"), NumWidgets(), 2);
+
+            return bDehydrated && bRehydrated && bBottom;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutRehydratesEmptyStackTest,
+                                 "Blaze.PrimaryLayout.RehydratesEmptyStack",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutRehydratesEmptyStackTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            FBlazeLayerConfig Config;
+            Config.DehydrateDepth = 1;
+            const auto Stack = Layout->AddTestLayer(LayerTag, Config);
+            Stack->TakeWidget();
+
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+            TArray<UCommonActivatableWidget*> Pushed;
+            for (auto i = 0; i < 4; ++i)
+            {
+                Pushed.Add(Layout->PushWidgetToLayer(LayerTag, WidgetClass));
+            }
+
+            // A plain stack cannot insert widgets below the live widgets so waits until the layer is empty
+            Layout->RemoveWidgetFromLayer(LayerTag, Pushed[3]);
+            const auto bWaits = TestEqual(TEXT("Layer with live widgets should not rehydrate"),
+                                          Stack->GetNumWidgets(),
+                                          1);
+
+            Layout->RemoveWidgetFromLayer(LayerTag, Pushed[2]);
+            const auto bRehydrated =
+                TestEqual(TEXT("Empty layer should rehydrate the displayed widget and DehydrateDepth widgets below it"),
+                          Stack->GetNumWidgets(),
+                          2)
+                && TestTrue(TEXT("Rehydrated widgets should replace the dehydrated instances"),
+                            !Stack->GetWidgetList().Contains(Pushed[0]) && !Stack->GetWidgetList().Contains(Pushed[1]))
+                && TestTrue(TEXT("Top-most rehydrated widget should be displayed"),
+                            Stack->GetActiveWidget() == Stack->GetWidgetList().Last());
+
+            return bWaits && bRehydrated;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutReportsHitchesTest,
+                                 "Blaze.PrimaryLayout.ReportsHitches",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutReportsHitchesTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    const auto Threshold = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.HitchDetector.ThresholdMs"));
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestNotNull(TEXT("Hitch threshold console variable should exist"), Threshold))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Layout->AddTestLayer(LayerTag);
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+
+            // Any measurable duration exceeds the threshold so that every operation is reported
+            const auto PreviousThreshold = Threshold->GetFloat();
+            Threshold->Set(0.0001f, ECVF_SetByCode);
+            FBlazeHitchDetector::Reset();
+            Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+            Threshold->Set(PreviousThreshold, ECVF_SetByCode);
+
+            const auto& Reports = FBlazeHitchDetector::GetReports();
+            if (TestEqual(TEXT("A single push should produce a single report"), Reports.Num(), 1))
+            {
+                const auto& Report = Reports[0];
+                const auto bOperation =
+                    TestEqual(TEXT("Report should record the operation"), FString(Report.Operation), TEXT("Push"));
+                const auto bLayerName =
+                    TestEqual(TEXT("Report should record the layer name"), Report.LayerName, LayerTag);
+                const auto bClass = TestEqual(TEXT("Report should record the widget class"),
+                                              Report.WidgetClass,
+                                              WidgetClass->GetName());
+                const auto bSplit = TestTrue(TEXT("Report should split construction from activation"),
+                                             Report.ConstructMs <= Report.TotalMs);
+                FBlazeHitchDetector::Reset();
+                return bOperation && bLayerName && bClass && bSplit;
+            }
+            else
+            {
+                FBlazeHitchDetector::Reset();
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutCountsOwnedObjectsTest,
+                                 "Blaze.PrimaryLayout.CountsOwnedObjects",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutCountsOwnedObjectsTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Layout->AddTestLayer(LayerTag);
+
+            const auto Before = FBlazeGarbageCollection::CountObjects(*Layout);
+            const auto Widget =
+                Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+            const auto After = FBlazeGarbageCollection::CountObjects(*Layout);
+
+            const auto bPushed = TestNotNull(TEXT("Widget should be pushed"), Widget);
+            const auto bCounted = TestTrue(TEXT("Pushed widget should be counted as owned by the layout"),
+                                           After.Objects > Before.Objects);
+            const auto bTraversed = TestEqual(TEXT("Unclustered objects should all be traversed"),
+                                              After.GetTraversedObjects(),
+                                              After.Objects);
+            return bPushed && bCounted && bTraversed;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutClustersWidgetsTest,
+                                 "Blaze.PrimaryLayout.ClustersWidgets",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutClustersWidgetsTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    const auto CreateClusters = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.CreateGCClusters"));
+    const auto ClusterWidgets = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.GC.ClusterWidgets"));
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestNotNull(TEXT("GC cluster console variable should exist"), CreateClusters)
+        && TestNotNull(TEXT("Cluster widgets console variable should exist"), ClusterWidgets))
+    {
+        const auto PreviousCreateClusters = CreateClusters->GetBool();
+        const auto PreviousClusterWidgets = ClusterWidgets->GetBool();
+        CreateClusters->Set(true, ECVF_SetByCode);
+        ClusterWidgets->Set(true, ECVF_SetByCode);
+
+        auto bSuccess{ false };
+        TWeakObjectPtr<UWidgetTree> WeakWidgetTree{ nullptr };
+        TWeakObjectPtr<UWidget> WeakRootWidget{ nullptr };
+        if (const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+            TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            FBlazeLayerConfig Config;
+            Config.bClusterWidgets = true;
+            Layout->AddTestLayer(LayerTag, Config);
+
+            // A cluster is only created for a widget tree that references other objects
+            const auto Widget = Layout->PushWidgetToLayer<UCommonActivatableWidget>(
+                LayerTag,
+                UBlazeAutomationTestActivatableWidget::StaticClass(),
+                [](UCommonActivatableWidget& InWidget) {
+                    InWidget.WidgetTree->RootWidget = InWidget.WidgetTree->ConstructWidget<UOverlay>();
+                });
+            if (TestNotNull(TEXT("Widget should be pushed"), Widget))
+            {
+                WeakWidgetTree = Widget->WidgetTree;
+                WeakRootWidget = Widget->WidgetTree->RootWidget;
+                const auto Counts = FBlazeGarbageCollection::CountObjects(*Layout);
+                const auto bClusterRoot =
+                    TestTrue(TEXT("Widget tree should be the root of a cluster"),
+                             GUObjectArray.ObjectToObjectItem(Widget->WidgetTree)
+                                 ->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
+                const auto bClustered =
+                    TestTrue(TEXT("Widgets in the tree should be counted as clustered"),
+                             1 == Counts.Clusters && Counts.ClusteredObjects > 0);
+
+                // A payload may assign objects to the tree after the push, which a cluster would not see
+                const auto Receiver = Layout->PushWidgetToLayer<UCommonActivatableWidget>(
+                    LayerTag,
+                    UBlazeAutomationTestPayloadWidget::StaticClass(),
+                    [](UCommonActivatableWidget& InWidget) {
+                        InWidget.WidgetTree->RootWidget = InWidget.WidgetTree->ConstructWidget<UOverlay>();
+                    });
+                const auto bReceiverSkipped = TestNotNull(TEXT("Payload receiver should be pushed"), Receiver)
+                    && TestFalse(TEXT("Payload receivers should not be clustered"),
+                                 GUObjectArray.ObjectToObjectItem(Receiver->WidgetTree)
+                                     ->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
+                bSuccess = bClusterRoot && bClustered && bReceiverSkipped;
+            }
+        }
+
+        // Nothing references the layout so the widget and its cluster are released by the next collection
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        const auto bReleased = TestTrue(TEXT("Cluster should be released with the widget"),
+                                        !WeakWidgetTree.IsValid() && !WeakRootWidget.IsValid());
+
+        CreateClusters->Set(PreviousCreateClusters, ECVF_SetByCode);
+        ClusterWidgets->Set(PreviousClusterWidgets, ECVF_SetByCode);
+        return bSuccess && bReleased;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutHeadlessLayerRecordsProxiesTest,
+                                 "Blaze.PrimaryLayout.HeadlessLayerRecordsProxies",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutHeadlessLayerRecordsProxiesTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeHeadlessPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Headless layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Layout->RegisterHeadlessLayers(FGameplayTagContainer(LayerTag));
+
+            auto bInitialized{ false };
+            const auto Widget = Layout->PushWidgetToLayer<UBlazeAutomationTestActivatableWidget>(
+                LayerTag,
+                UBlazeAutomationTestActivatableWidget::StaticClass(),
+                [&bInitialized](auto&) { bInitialized = true; });
+
+            const auto bRegistered = TestTrue(TEXT("Headless layer should be registered"), Layout->HasLayer(LayerTag))
+                && TestNull(TEXT("Headless layer should have no container"), Layout->GetLayer(LayerTag));
+            const auto bPushed = TestNotNull(TEXT("Push should return a proxy of the widget class"), Widget)
+                && TestTrue(TEXT("Push should invoke the init function"), bInitialized);
+            const auto bNoSlate =
+                TestFalse(TEXT("Proxy should not build a Slate widget"), Widget && Widget->GetCachedWidget().IsValid());
+            const auto bRecorded = TestEqual(TEXT("Layer should record the proxy"),
+                                             Layout->CaptureSnapshot().NumWidgets(),
+                                             1);
+
+            auto bReleased{ false };
+            if (Widget)
+            {
+                const auto Handle = Widget->OnSlateReleased().AddLambda([&bReleased] { bReleased = true; });
+                Layout->RemoveWidgetFromLayer(LayerTag, Widget);
+                Widget->OnSlateReleased().Remove(Handle);
+            }
+            const auto bRemoved = TestEqual(TEXT("Layer should forget the popped proxy"),
+                                            Layout->CaptureSnapshot().NumWidgets(),
+                                            0)
+                && TestTrue(TEXT("Popping the proxy should broadcast its release"), bReleased);
+            return bRegistered && bPushed && bNoSlate && bRecorded && bRemoved;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutDeliversPayloadTest,
+                                 "Blaze.PrimaryLayout.DeliversPayload",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutDeliversPayloadTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Layout->AddTestLayer(LayerTag);
+
+            FBlazeAutomationTestPayload TestPayload;
+            TestPayload.Value = 42;
+            auto Payload = FInstancedStruct::Make(TestPayload);
+            auto bReceivedBeforeInit{ false };
+            const auto Widget = Cast<UBlazeAutomationTestPayloadWidget>(Layout->PushWidgetToLayerWithPayload(
+                LayerTag,
+                UBlazeAutomationTestPayloadWidget::StaticClass(),
+                MoveTemp(Payload),
+                [&bReceivedBeforeInit](auto& WidgetToInit) {
+                    const auto PayloadWidget = Cast<UBlazeAutomationTestPayloadWidget>(&WidgetToInit);
+                    bReceivedBeforeInit = PayloadWidget && INDEX_NONE != PayloadWidget->ReceivedValue;
+                }));
+
+            const auto bPushed = TestNotNull(TEXT("Widget should be pushed"), Widget);
+            const auto bReceived = bPushed
+                && TestEqual(TEXT("Widget should receive the payload"), Widget->ReceivedValue, 42)
+                && TestTrue(TEXT("Payload should be delivered before construction"), Widget->bReceivedBeforeConstruct)
+                && TestTrue(TEXT("Payload should be delivered before the init function"), bReceivedBeforeInit);
+            const auto bMoved = TestFalse(TEXT("Payload should be moved into the widget"), Payload.IsValid());
+            return bPushed && bReceived && bMoved;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutQueuesAndMergesEntriesTest,
+                                 "Blaze.PrimaryLayout.QueuesAndMergesEntries",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutQueuesAndMergesEntriesTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            FBlazeLayerConfig Config;
+            Config.QueueMaxVisible = 1;
+            // A headless layer removes widgets immediately so the queue advances without Slate transitions
+            Layout->AddTestHeadlessLayer(LayerTag, Config);
+
+            const auto Enqueue = [Layout, &LayerTag](const int32 Value, const int32 Priority, const FName MergeKey) {
+                FBlazeAutomationTestPayload TestPayload;
+                TestPayload.Value = Value;
+                return Layout->EnqueueWidgetToLayer(LayerTag,
+                                                    UBlazeAutomationTestPayloadWidget::StaticClass(),
+                                                    FInstancedStruct::Make(TestPayload),
+                                                    Priority,
+                                                    MergeKey);
+            };
+            const auto GetWidgets = [Layout, &LayerTag] {
+                TArray<UCommonActivatableWidget*> Widgets;
+                Layout->GetLayerWidgets(LayerTag, Widgets);
+                return Widgets;
+            };
+            const auto PopDisplayedValue = [Layout, &LayerTag, &GetWidgets] {
+                const auto Widgets = GetWidgets();
+                const auto Widget = 1 == Widgets.Num() ? Cast<UBlazeAutomationTestPayloadWidget>(Widgets[0]) : nullptr;
+                if (Widget)
+                {
+                    Layout->RemoveWidgetFromLayer(LayerTag, Widget);
+                    Layout->TickTestQueuedEntries();
+                }
+                return Widget ? Widget->ReceivedValue : INDEX_NONE;
+            };
+
+            // The first entry is displayed while the rest are held as data and same-key entries merge
+            Enqueue(1, 0, NAME_None);
+            Enqueue(5, 0, TEXT("Ammo"));
+            Enqueue(5, 0, TEXT("Ammo"));
+            Enqueue(5, 0, TEXT("Ammo"));
+            Enqueue(100, 10, NAME_None);
+
+            const auto bHeld = TestEqual(TEXT("Only one widget should be displayed"), GetWidgets().Num(), 1)
+                && TestEqual(TEXT("Merged entries should wait as one"), Layout->GetNumQueuedEntries(LayerTag), 2);
+
+            // Removing the displayed widget makes room for the highest priority entry and then the merged entry
+            const auto bOrdered = TestEqual(TEXT("The first entry should be displayed"), PopDisplayedValue(), 1)
+                && TestEqual(TEXT("The highest priority entry should be displayed next"), PopDisplayedValue(), 100)
+                && TestEqual(TEXT("The merged entry should be displayed last"), PopDisplayedValue(), 15)
+                && TestEqual(TEXT("No entries should wait"), Layout->GetNumQueuedEntries(LayerTag), 0)
+                && TestFalse(TEXT("The queue should stop ticking once empty"), Layout->TickTestQueuedEntries());
+
+            Enqueue(1, 0, NAME_None);
+            Enqueue(2, 0, NAME_None);
+            const auto bCleared = TestEqual(TEXT("The entry should wait"), Layout->GetNumQueuedEntries(LayerTag), 1)
+                && TestEqual(TEXT("Clearing should remove the widget"), Layout->ClearLayer(LayerTag), 1)
+                && TestEqual(TEXT("Clearing should discard waiting entries"), Layout->GetNumQueuedEntries(LayerTag), 0);
+
+            return bHeld && bOrdered && bCleared;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutFeedRecyclesEntryWidgetsTest,
+                                 "Blaze.PrimaryLayout.FeedRecyclesEntryWidgets",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutFeedRecyclesEntryWidgetsTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        const auto Feed = CreateWidget<UBlazeAutomationTestFeedView>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout)
+            && TestNotNull(TEXT("Feed should be created"), Feed))
+        {
+            const auto& FeedTag = BlazePrimaryLayoutTests::TestFeedTag;
+            Feed->Configure(4, 50);
+            Layout->AddTestFeedLayer(FeedTag, Feed);
+
+            auto NextValue{ 0 };
+            const auto PushEntries = [Layout, &FeedTag, &NextValue](const int32 Count) {
+                for (int32 Index = 0; Index < Count; Index++)
+                {
+                    FBlazeAutomationTestPayload TestPayload;
+                    TestPayload.Value = NextValue++;
+                    Layout->PushEntryToFeed(FeedTag, FInstancedStruct::Make(TestPayload));
+                }
+            };
+            const auto GetDisplayedValues = [Feed] {
+                TArray<int32> Values;
+                for (const auto EntryWidget : Feed->GetEntryWidgets())
+                {
+                    if (ESlateVisibility::Collapsed != EntryWidget->GetVisibility())
+                    {
+                        Values.Add(CastChecked<UBlazeAutomationTestFeedEntryWidget>(EntryWidget)->ReceivedValue);
+                    }
+                }
+                return Values;
+            };
+
+            PushEntries(200);
+            Feed->RefreshEntries();
+            const auto bBounded = TestTrue(TEXT("Feed should be registered as a layer"), Layout->HasLayer(FeedTag))
+                && TestEqual(TEXT("Feed should retain MaxEntries entries"), Feed->GetNumEntries(), 50)
+                && TestEqual(TEXT("Feed should create one widget per visible entry"), Feed->GetEntryWidgets().Num(), 4)
+                && TestTrue(TEXT("Feed should display the latest entries"),
+                            GetDisplayedValues() == TArray<int32>({ 196, 197, 198, 199 }));
+
+            PushEntries(1);
+            Feed->RefreshEntries();
+            const auto bFollows = TestTrue(TEXT("Feed should follow new entries"),
+                                           GetDisplayedValues() == TArray<int32>({ 197, 198, 199, 200 }));
+
+            Feed->ScrollBy(2);
+            PushEntries(1);
+            Feed->RefreshEntries();
+            const auto bScrolled = TestTrue(TEXT("Feed should keep a scrolled window in place"),
+                                            GetDisplayedValues() == TArray<int32>({ 195, 196, 197, 198 }))
+                && TestEqual(TEXT("Scroll offset should account for the new entry"), Feed->GetScrollOffset(), 3);
+
+            Feed->ScrollToLatest();
+            Feed->RefreshEntries();
+            const auto bLatest = TestTrue(TEXT("Feed should return to the latest entries"),
+                                          GetDisplayedValues() == TArray<int32>({ 198, 199, 200, 201 }))
+                && TestEqual(TEXT("Feed should still have one widget per visible entry"),
+                             Feed->GetEntryWidgets().Num(),
+                             4);
+
+            // Sequences restart after a clear so the same sequence must be delivered again to the recycled widget
+            Feed->ClearEntries();
+            PushEntries(1);
+            Feed->RefreshEntries();
+            Feed->ClearEntries();
+            PushEntries(1);
+            Feed->RefreshEntries();
+            const auto bCleared = TestTrue(TEXT("Feed should display the entry pushed after a clear"),
+                                           GetDisplayedValues() == TArray<int32>({ 203 }));
+
+            return bBounded && bFollows && bScrolled && bLatest && bCleared;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutReclaimsMemoryByPressureTest,
+                                 "Blaze.PrimaryLayout.ReclaimsMemoryByPressure",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutReclaimsMemoryByPressureTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        const auto Feed = CreateWidget<UBlazeAutomationTestFeedView>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout)
+            && TestNotNull(TEXT("Feed should be created"), Feed))
+        {
+            const auto& FeedTag = BlazePrimaryLayoutTests::TestFeedTag;
+            Feed->Configure(4, 50);
+            Layout->AddTestFeedLayer(FeedTag, Feed);
+            for (int32 Index = 0; Index < 4; Index++)
+            {
+                Layout->PushEntryToFeed(FeedTag, FInstancedStruct::Make(FBlazeAutomationTestPayload()));
+            }
+            Feed->RefreshEntries();
+            Feed->ClearEntries();
+            Feed->PushEntry(FInstancedStruct::Make(FBlazeAutomationTestPayload()));
+            Feed->RefreshEntries();
+
+            const auto Medium = Layout->ReclaimMemory(EBlazeMemoryPressure::Medium);
+            const auto bMedium = TestEqual(TEXT("Medium pressure should not release feed entry widgets"),
+                                           Medium.ReleasedFeedWidgets,
+                                           0)
+                && TestEqual(TEXT("Feed should keep its entry widgets"), Feed->GetEntryWidgets().Num(), 4);
+
+            const auto High = Layout->ReclaimMemory(EBlazeMemoryPressure::High);
+            const auto bHigh = TestEqual(TEXT("High pressure should release the unused feed entry widgets"),
+                                         High.ReleasedFeedWidgets,
+                                         3)
+                && TestEqual(TEXT("Feed should keep the widget displaying an entry"), Feed->GetEntryWidgets().Num(), 1);
+
+            Feed->SetVisibility(ESlateVisibility::Collapsed);
+            const auto bHidden = TestEqual(TEXT("A hidden feed should release every entry widget"),
+                                           Layout->ReclaimMemory(EBlazeMemoryPressure::High).ReleasedFeedWidgets,
+                                           1)
+                && TestTrue(TEXT("A hidden feed should have no entry widgets"), Feed->GetEntryWidgets().IsEmpty());
+
+            Feed->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+            Feed->PushEntry(FInstancedStruct::Make(FBlazeAutomationTestPayload()));
+            Feed->RefreshEntries();
+            const auto bRecreated = TestEqual(TEXT("Feed should recreate entry widgets when they are required"),
+                                              Feed->GetEntryWidgets().Num(),
+                                              2);
+
+            // Both stacks keep the displayed widget and one widget below it alive, so each dehydrates one widget
+            FBlazeLayerConfig Config;
+            Config.DehydrateDepth = 1;
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            const auto Stack = Layout->AddTestLayer<UBlazeActivatableWidgetStack>(LayerTag, Config);
+            Config.bPinWidgetClasses = true;
+            const auto& PinnedLayerTag = BlazePrimaryLayoutTests::TestModalLayerTag;
+            const auto PinnedStack = Layout->AddTestLayer<UBlazeActivatableWidgetStack>(PinnedLayerTag, Config);
+            // The stacks only release the widgets they remove once they have constructed their Slate widgets
+            Stack->TakeWidget();
+            PinnedStack->TakeWidget();
+
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+            UCommonActivatableWidget* Displayed{ nullptr };
+            UCommonActivatableWidget* PinnedDisplayed{ nullptr };
+            for (auto i = 0; i < 3; ++i)
+            {
+                Displayed = Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+                PinnedDisplayed = Layout->PushWidgetToLayer(PinnedLayerTag, WidgetClass);
+            }
+
+            const auto Low = Layout->ReclaimMemory(EBlazeMemoryPressure::Low);
+            const auto bLow = TestEqual(TEXT("Low pressure should only release the classes of unpinned layers"),
+                                        Low.ReleasedWidgetClasses,
+                                        1)
+                && TestEqual(TEXT("Low pressure should not dehydrate widgets"), Low.DehydratedWidgets, 0);
+
+            const TWeakObjectPtr<UCommonActivatableWidget> Hidden{ Stack->GetWidgetList()[0] };
+            const auto MediumStacks = Layout->ReclaimMemory(EBlazeMemoryPressure::Medium);
+            const auto bMediumStacks =
+                TestEqual(TEXT("Medium pressure should dehydrate the hidden widget of each stack"),
+                          MediumStacks.DehydratedWidgets,
+                          2)
+                && TestEqual(TEXT("Medium pressure should release the class of the newly dehydrated widget"),
+                             MediumStacks.ReleasedWidgetClasses,
+                             1)
+                && TestTrue(TEXT("Medium pressure should keep only the displayed widget"),
+                            1 == Stack->GetNumWidgets() && Stack->GetActiveWidget() == Displayed);
+
+            // The stack no longer pools the dehydrated widget, so the next collection destroys it
+            Layout->AddToRoot();
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            Layout->RemoveFromRoot();
+            const auto bDestroyed =
+                TestFalse(TEXT("Medium pressure should destroy dehydrated widgets"), Hidden.IsValid());
+
+            // Popping the displayed widget rehydrates the widgets whose classes were released from WidgetClassPath
+            Layout->RemoveWidgetFromLayer(LayerTag, Displayed);
+            const auto bRehydrated = TestEqual(TEXT("Released widgets should rehydrate once navigation returns"),
+                                               Stack->GetNumWidgets(),
+                                               2)
+                && TestTrue(TEXT("Rehydrated widgets should be loaded from the class path"),
+                            Stack->GetWidgetList()[0]->IsA(WidgetClass) && Stack->GetWidgetList()[1]->IsA(WidgetClass));
+
+            const auto Threshold = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.Memory.GCObjectThreshold"));
+            auto bCollect{ false };
+            if (TestNotNull(TEXT("Garbage collection threshold console variable should exist"), Threshold))
+            {
+                const auto PreviousThreshold = Threshold->GetInt();
+                Threshold->Set(1, ECVF_SetByCode);
+                FBlazeMemoryPressure::Respond(EBlazeMemoryPressure::High);
+                const auto bPending = TestTrue(TEXT("High pressure should wait for a large widget removal"),
+                                               FBlazeMemoryPressure::IsCollectionPending());
+                Layout->RemoveWidgetFromLayer(PinnedLayerTag, PinnedDisplayed);
+                bCollect = bPending
+                    && TestFalse(TEXT("Removing a large widget should request a garbage collection"),
+                                 FBlazeMemoryPressure::IsCollectionPending());
+                Threshold->Set(PreviousThreshold, ECVF_SetByCode);
+            }
+
+            return bMedium && bHigh && bHidden && bRecreated && bLow && bMediumStacks && bDestroyed && bRehydrated
+                && bCollect;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutAdaptsTransitionsToFrameBudgetTest,
+                                 "Blaze.PrimaryLayout.AdaptsTransitionsToFrameBudget",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutAdaptsTransitionsToFrameBudgetTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    const auto Budget = IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.Transition.FrameBudgetMs"));
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestNotNull(TEXT("Frame budget console variable should exist"), Budget))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto PreviousBudget = Budget->GetFloat();
+            Budget->Set(10.0f, ECVF_SetByCode);
+            FBlazeTransitionBudget::Reset();
+
+            const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            FBlazeLayerConfig Config;
+            Config.TransitionDuration = 0.4f;
+            const auto Stack = Layout->AddTestLayer(LayerTag, Config);
+            const auto RecordFrames = [](const double FrameMs) {
+                for (auto i = 0; i < 50; ++i)
+                {
+                    FBlazeTransitionBudget::RecordFrameTime(FrameMs / 1000.0);
+                }
+            };
+            const auto PushAndGetDuration = [Layout, &LayerTag, Stack] {
+                Layout->PushWidgetToLayer(LayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+                return Stack->GetTransitionDuration();
+            };
+
+            const auto bRegistered = TestEqual(TEXT("Layer should use the configured transition duration"),
+                                               Stack->GetTransitionDuration(),
+                                               0.4f);
+
+            RecordFrames(5.0);
+            const auto bFull = TestEqual(TEXT("Transition should play in full within the budget"),
+                                         PushAndGetDuration(),
+                                         0.4f);
+
+            RecordFrames(13.0);
+            const auto bShortened = TestEqual(TEXT("Transition should be shortened over the budget"),
+                                              PushAndGetDuration(),
+                                              0.2f);
+
+            RecordFrames(30.0);
+            const auto bSkipped =
+                TestEqual(TEXT("Transition should be skipped well over the budget"), PushAndGetDuration(), 0.f);
+
+            RecordFrames(14.5);
+            const auto bHeld = TestTrue(TEXT("Transitions should stay skipped without clear headroom"),
+                                        EBlazeTransitionLevel::Skipped == FBlazeTransitionBudget::GetLevel());
+            RecordFrames(12.0);
+            RecordFrames(5.0);
+            const auto bRestored = TestEqual(TEXT("Transition should be restored once there is headroom"),
+                                             PushAndGetDuration(),
+                                             0.4f);
+
+            const auto& Stats = FBlazeTransitionBudget::GetStats();
+            const auto bStats = TestEqual(TEXT("Full transitions should be counted"), Stats.Full, 2)
+                && TestEqual(TEXT("Shortened transitions should be counted"), Stats.Shortened, 1)
+                && TestEqual(TEXT("Skipped transitions should be counted"), Stats.Skipped, 1);
+
+            FBlazeLayerConfig FixedConfig;
+            FixedConfig.TransitionDuration = 0.4f;
+            FixedConfig.bAdaptTransitionToFrameBudget = false;
+            const auto& FixedLayerTag = BlazePrimaryLayoutTests::TestSharedLayerTag;
+            const auto FixedStack = Layout->AddTestLayer(FixedLayerTag, FixedConfig);
+            Layout->PushWidgetToLayer(FixedLayerTag, UBlazeAutomationTestActivatableWidget::StaticClass());
+            const auto bFixed = TestEqual(TEXT("Layer that does not adapt should play in full"),
+                                          FixedStack->GetTransitionDuration(),
+                                          0.4f)
+                && TestEqual(TEXT("Transitions that do not adapt should not be counted"), Stats.Full, 2);
+
+            // Skipped transitions change the displayed widget immediately once the stack has its Slate widget
+            const auto& ModalLayerTag = BlazePrimaryLayoutTests::TestModalLayerTag;
+            const auto ModalStack = Layout->AddTestLayer(ModalLayerTag, Config);
+            ModalStack->TakeWidget();
+            RecordFrames(30.0);
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+            const auto Bottom = Layout->PushWidgetToLayer(ModalLayerTag, WidgetClass);
+            const auto Top = Layout->PushWidgetToLayer(ModalLayerTag, WidgetClass);
+
+            // Deactivating the displayed widget bypasses the layout, as the back handler does
+            RecordFrames(12.0);
+            RecordFrames(5.0);
+            Top->DeactivateWidget();
+            const auto bDeactivated =
+                TestTrue(TEXT("Deactivating the displayed widget should display the widget below it"),
+                         ModalStack->GetActiveWidget() == Bottom)
+                && TestEqual(TEXT("Change made outside of the layout should apply the budget to the next change"),
+                             ModalStack->GetTransitionDuration(),
+                             0.4f);
+
+            Budget->Set(PreviousBudget, ECVF_SetByCode);
+            FBlazeTransitionBudget::Reset();
+            return bRegistered && bFull && bShortened && bSkipped && bHeld && bRestored && bStats && bFixed
+                && bDeactivated;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutViewModelStoreCoalescesUpdatesTest,
+                                 "Blaze.PrimaryLayout.ViewModelStoreCoalescesUpdates",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutViewModelStoreCoalescesUpdatesTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        const auto Store = Layout ? Layout->GetViewModelStore() : nullptr;
+        if (TestNotNull(TEXT("View-model store should be created"), Store)
+            && TestTrue(TEXT("View-model store should be created once"), Store == Layout->GetViewModelStore()))
+        {
+            const auto& HealthTag = BlazePrimaryLayoutTests::TestHealthFieldTag;
+            const auto& AmmoTag = BlazePrimaryLayoutTests::TestAmmoFieldTag;
+            const auto& ScoreTag = BlazePrimaryLayoutTests::TestScoreFieldTag;
+
+            auto NumNotifications{ 0 };
+            FGameplayTagContainer NotifiedFields;
+            FGameplayTagContainer BoundFields;
+            BoundFields.AddTag(HealthTag);
+            BoundFields.AddTag(AmmoTag);
+            Store->BindFields(BoundFields,
+                              FBlazeViewModelFieldsChanged::CreateLambda([&](const FGameplayTagContainer& Changed) {
+                                  NumNotifications++;
+                                  NotifiedFields = Changed;
+                              }));
+
+            const auto SetValue = [Store](const FGameplayTag& Field, const int32 Value) {
+                FBlazeAutomationTestPayload TestPayload;
+                TestPayload.Value = Value;
+                return Store->SetFieldValue(Field, TestPayload);
+            };
+
+            SetValue(HealthTag, 100);
+            SetValue(HealthTag, 90);
+            SetValue(HealthTag, 80);
+            SetValue(AmmoTag, 30);
+            SetValue(ScoreTag, 5);
+            const auto bUnchanged =
+                TestFalse(TEXT("Writing an unchanged value should be ignored"), SetValue(AmmoTag, 30))
+                && TestEqual(TEXT("Dirty fields should be queued once"), Store->GetNumDirtyFields(), 3)
+                && TestEqual(TEXT("Each change should bump the version"), Store->GetFieldVersion(HealthTag), 3)
+                && TestEqual(TEXT("Bindings should not be notified before dispatch"), NumNotifications, 0);
+
+            Store->DispatchDirtyFields();
+            const auto Value = Store->GetFieldValue<FBlazeAutomationTestPayload>(HealthTag);
+            const auto bCoalesced = TestEqual(TEXT("Binding should be notified once"), NumNotifications, 1)
+                && TestTrue(TEXT("Binding should receive the bound fields that changed"), NotifiedFields == BoundFields)
+                && TestTrue(TEXT("Store should hold the latest value"), Value && 80 == Value->Value)
+                && TestEqual(TEXT("Dirty queue should be drained"), Store->GetNumDirtyFields(), 0);
+
+            SetValue(ScoreTag, 10);
+            Store->DispatchDirtyFields();
+            Store->DispatchDirtyFields();
+            const auto bFiltered = TestEqual(TEXT("Unbound fields should not notify"), NumNotifications, 1);
+
+            // A binding that unbinds itself and binds another takes effect once the dispatch completes
+            auto NumOneShot{ 0 };
+            auto NumLate{ 0 };
+            FDelegateHandle OneShotHandle;
+            OneShotHandle = Store->BindFields(
+                FGameplayTagContainer(ScoreTag),
+                FBlazeViewModelFieldsChanged::CreateLambda([&](const FGameplayTagContainer&) {
+                    NumOneShot++;
+                    Store->UnbindFields(OneShotHandle);
+                    Store->BindFields(FGameplayTagContainer(ScoreTag),
+                                      FBlazeViewModelFieldsChanged::CreateLambda(
+                                          [&NumLate](const FGameplayTagContainer&) { NumLate++; }));
+                }));
+            SetValue(ScoreTag, 15);
+            Store->DispatchDirtyFields();
+            const auto bDeferredBinding = TestEqual(TEXT("A binding should be notified once"), NumOneShot, 1)
+                && TestEqual(TEXT("A binding added during dispatch should wait for the next dispatch"), NumLate, 0);
+            SetValue(ScoreTag, 20);
+            Store->DispatchDirtyFields();
+            const auto bRebound = TestEqual(TEXT("An unbound binding should not be notified"), NumOneShot, 1)
+                && TestEqual(TEXT("A binding added during dispatch should be notified"), NumLate, 1);
+
+            return bUnchanged && bCoalesced && bFiltered && bDeferredBinding && bRebound;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutBuildsLayersFromDefinitionTest,
+                                 "Blaze.PrimaryLayout.BuildsLayersFromDefinition",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutBuildsLayersFromDefinitionTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto& LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+        const auto& ModalLayerTag = BlazePrimaryLayoutTests::TestModalLayerTag;
+
+        TArray<FBlazeLayerDefinition> LayerDefinitions;
+        auto& LayerDefinition = LayerDefinitions.AddDefaulted_GetRef();
+        LayerDefinition.LayerTag = LayerTag;
+        LayerDefinition.ContainerClass = UCommonActivatableWidgetStack::StaticClass();
+        LayerDefinition.ZOrder = 10;
+        auto& ModalLayerDefinition = LayerDefinitions.AddDefaulted_GetRef();
+        ModalLayerDefinition.LayerTag = ModalLayerTag;
+        ModalLayerDefinition.ContainerClass = UCommonActivatableWidgetQueue::StaticClass();
+        ModalLayerDefinition.ZOrder = 0;
+
+        const auto Definition = FBlazeTestWorld::CreateLayoutDefinition(MoveTemp(LayerDefinitions));
+        Definition->AddToRoot();
+        UBlazeAutomationTestDefinitionPrimaryLayout::SetTestLayoutDefinition(Definition);
+        const auto Layout = CreateWidget<UBlazeAutomationTestDefinitionPrimaryLayout>(World->Get());
+        UBlazeAutomationTestDefinitionPrimaryLayout::SetTestLayoutDefinition(nullptr);
+        Definition->RemoveFromRoot();
+
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto Layer = Layout->GetLayer(LayerTag);
+            const auto ModalLayer = Layout->GetLayer(ModalLayerTag);
+            const auto bBuilt =
+                TestTrue(TEXT("Stack layer should be built"), IsValid(Cast<UCommonActivatableWidgetStack>(Layer)))
+                && TestTrue(TEXT("Queue layer should be built"),
+                            IsValid(Cast<UCommonActivatableWidgetQueue>(ModalLayer)));
+            const auto Overlay = bBuilt ? Layer->GetParent() : nullptr;
+            const auto bOrdered = bBuilt && TestNotNull(TEXT("Layers should share an overlay"), Overlay)
+                && TestTrue(TEXT("Layers should be ordered by ZOrder"),
+                            Overlay->GetChildIndex(ModalLayer) < Overlay->GetChildIndex(Layer));
+            return bBuilt && bOrdered;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutManagerSharedLayerConstructsOnceTest,
+                                 "Blaze.PrimaryLayoutManager.SharedLayerConstructsOnce",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutManagerSharedLayerConstructsOnceTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto GameInstance = World->CreateGameInstance(UBlazeAutomationTestPrimaryLayoutManager::StaticClass());
+
+        auto bSuccess{ false };
+        const auto Subsystem = GameInstance->GetSubsystem<UBlazeAutomationTestSubsystem>();
+        if (TestNotNull(TEXT("Test subsystem should be created by the test game instance"), Subsystem))
+        {
+            const auto Manager = NewObject<UBlazeAutomationTestPrimaryLayoutManager>(Subsystem);
+            Manager->LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Manager->SharedLayerTag = BlazePrimaryLayoutTests::TestSharedLayerTag;
+            Manager->SetSharedInputOwner(EBlazeSharedInputOwner::PushingPlayer);
+            FBlazeTestWorld::SwitchToPrimaryLayoutManager(*Subsystem, Manager);
+
+            TArray<ULocalPlayer*> LocalPlayers;
+            for (auto i = 0; i < 2; ++i)
+            {
+                const auto LocalPlayer = LocalPlayers.Add_GetRef(NewObject<ULocalPlayer>(GEngine));
+                GameInstance->AddLocalPlayer(LocalPlayer, FPlatformMisc::GetPlatformUserForUserIndex(i));
+                if (const auto PlayerController = World->SpawnActor<APlayerController>())
+                {
+                    PlayerController->Player = LocalPlayer;
+                    LocalPlayer->PlayerController = PlayerController;
+                }
+                Subsystem->NotifyPlayerAdded(LocalPlayer);
+            }
+
+            const auto SharedLayout = Manager->GetSharedLayout();
+            const auto& SharedLayerTag = BlazePrimaryLayoutTests::TestSharedLayerTag;
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+            const auto Widget = UBlazeFunctionLibrary::PushContentToLayer(LocalPlayers[1], SharedLayerTag, WidgetClass);
+
+            const auto bShared = TestNotNull(TEXT("Shared layout should be created"), SharedLayout)
+                && TestTrue(TEXT("Every player should route the shared layer to the shared layout"),
+                            Manager->GetLayoutForLayer(LocalPlayers[0], SharedLayerTag) == SharedLayout
+                                && Manager->GetLayoutForLayer(LocalPlayers[1], SharedLayerTag) == SharedLayout)
+                && TestTrue(TEXT("Other layers should route to the player layout"),
+                            Manager->GetLayoutForLayer(LocalPlayers[1], BlazePrimaryLayoutTests::TestLayerTag)
+                                == Manager->GetPrimaryLayout(LocalPlayers[1]));
+            const auto bPushed = TestNotNull(TEXT("Push onto the shared layer should create the widget"), Widget)
+                && TestTrue(TEXT("Widget should be constructed by the shared layout"), Widget->IsIn(SharedLayout))
+                && TestTrue(TEXT("Widget should be owned by the pushing player"),
+                            Widget->GetOwningLocalPlayer() == LocalPlayers[1]);
+
+            // Each player may only pop the shared widgets that it owns
+            UBlazeFunctionLibrary::PushContentToLayer(LocalPlayers[0], SharedLayerTag, WidgetClass);
+            const auto bPopped = TestEqual(TEXT("PopAll should remove the shared widgets owned by the player"),
+                                           UBlazeFunctionLibrary::PopAll(LocalPlayers[0], FBlazeWidgetQuery()),
+                                           1)
+                && TestEqual(TEXT("PopAll should keep the shared widgets owned by other players"),
+                             SharedLayout ? SharedLayout->CaptureSnapshot().NumWidgets() : -1,
+                             1);
+
+            Subsystem->NotifyPlayerDestroyed(LocalPlayers[1]);
+            const auto bReleased = TestEqual(TEXT("Widgets of a destroyed player should be removed"),
+                                             SharedLayout ? SharedLayout->CaptureSnapshot().NumWidgets() : -1,
+                                             0);
+
+            Subsystem->NotifyPlayerDestroyed(LocalPlayers[0]);
+            const auto bLayoutReleased = TestNull(TEXT("Shared layout should be released with the last player"),
+                                                  Manager->GetSharedLayout());
+            bSuccess = bShared && bPushed && bPopped && bReleased && bLayoutReleased;
+        }
+
+        GameInstance->Shutdown();
+        GameInstance->RemoveFromRoot();
+        return bSuccess;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutManagerSharedWidgetsFollowOwnerTest,
+                                 "Blaze.PrimaryLayoutManager.SharedWidgetsFollowOwner",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutManagerSharedWidgetsFollowOwnerTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto GameInstance = World->CreateGameInstance(UBlazeAutomationTestPrimaryLayoutManager::StaticClass());
+
+        auto bSuccess{ false };
+        const auto Subsystem = GameInstance->GetSubsystem<UBlazeAutomationTestSubsystem>();
+        if (TestNotNull(TEXT("Test subsystem should be created by the test game instance"), Subsystem))
+        {
+            const auto Manager = NewObject<UBlazeAutomationTestPrimaryLayoutManager>(Subsystem);
+            Manager->LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Manager->SharedLayerTag = BlazePrimaryLayoutTests::TestSharedLayerTag;
+            FBlazeTestWorld::SwitchToPrimaryLayoutManager(*Subsystem, Manager);
+
+            TArray<ULocalPlayer*> LocalPlayers;
+            for (auto i = 0; i < 2; ++i)
+            {
+                const auto LocalPlayer = LocalPlayers.Add_GetRef(NewObject<ULocalPlayer>(GEngine));
+                GameInstance->AddLocalPlayer(LocalPlayer, FPlatformMisc::GetPlatformUserForUserIndex(i));
+                if (const auto PlayerController = World->SpawnActor<APlayerController>())
+                {
+                    PlayerController->Player = LocalPlayer;
+                    LocalPlayer->PlayerController = PlayerController;
+                }
+                Subsystem->NotifyPlayerAdded(LocalPlayer);
+            }
+
+            const auto SharedLayout = Manager->GetSharedLayout();
+            if (TestNotNull(TEXT("Shared layout should be created"), SharedLayout))
+            {
+                // Construct the Slate widgets so that popped widgets are released to the pool of the stack
+                SharedLayout->TakeWidget();
+
+                const auto& SharedLayerTag = BlazePrimaryLayoutTests::TestSharedLayerTag;
+                const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+                const auto First =
+                    UBlazeFunctionLibrary::PushContentToLayer(LocalPlayers[1], SharedLayerTag, WidgetClass);
+                const auto bFirst = TestNotNull(TEXT("Push onto the shared layer should create the widget"), First)
+                    && TestTrue(TEXT("Widget should be owned by the owner of the shared layout"),
+                                First->GetOwningLocalPlayer() == LocalPlayers[0]);
+                UBlazeFunctionLibrary::PopContentFromLayer(SharedLayerTag, First);
+
+                Subsystem->NotifyPlayerDestroyed(LocalPlayers[0]);
+                const auto Second =
+                    UBlazeFunctionLibrary::PushContentToLayer(LocalPlayers[1], SharedLayerTag, WidgetClass);
+                const auto bSecond = TestNotNull(TEXT("Push after the owner is destroyed should create the widget"),
+                                                 Second)
+                    && TestTrue(TEXT("Widget should be owned by the player that the layout was transferred to"),
+                                Second->GetOwningLocalPlayer() == LocalPlayers[1]);
+
+                Subsystem->NotifyPlayerDestroyed(LocalPlayers[1]);
+                bSuccess = bFirst && bSecond;
+            }
+        }
+
+        GameInstance->Shutdown();
+        GameInstance->RemoveFromRoot();
+        return bSuccess;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutManagerBatchesPlayerJoinsTest,
+                                 "Blaze.PrimaryLayoutManager.BatchesPlayerJoins",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutManagerBatchesPlayerJoinsTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto GameInstance = World->CreateGameInstance(UBlazeAutomationTestPrimaryLayoutManager::StaticClass());
+
+        auto bSuccess{ false };
+        const auto Subsystem = GameInstance->GetSubsystem<UBlazeAutomationTestSubsystem>();
+        if (TestNotNull(TEXT("Test subsystem should be created by the test game instance"), Subsystem))
+        {
+            const auto Manager = NewObject<UBlazeAutomationTestPrimaryLayoutManager>(Subsystem);
+            Manager->LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            Manager->SharedLayerTag = BlazePrimaryLayoutTests::TestSharedLayerTag;
+            Manager->SetBatchPlayerJoins(true);
+            FBlazeTestWorld::SwitchToPrimaryLayoutManager(*Subsystem, Manager);
+
+            TArray<ULocalPlayer*> LocalPlayers;
+            for (auto i = 0; i < 3; ++i)
+            {
+                const auto LocalPlayer = LocalPlayers.Add_GetRef(NewObject<ULocalPlayer>(GEngine));
+                GameInstance->AddLocalPlayer(LocalPlayer, FPlatformMisc::GetPlatformUserForUserIndex(i));
+                if (const auto PlayerController = World->SpawnActor<APlayerController>())
+                {
+                    PlayerController->Player = LocalPlayer;
+                    LocalPlayer->PlayerController = PlayerController;
+                }
+                Subsystem->NotifyPlayerAdded(LocalPlayer);
+            }
+            // A player that leaves before its join is processed never receives a layout
+            Subsystem->NotifyPlayerRemoved(LocalPlayers[2]);
+
+            // A player whose controller has not been spawned yet keeps waiting for its join
+            const auto WaitingPlayer = LocalPlayers.Add_GetRef(NewObject<ULocalPlayer>(GEngine));
+            GameInstance->AddLocalPlayer(WaitingPlayer, FPlatformMisc::GetPlatformUserForUserIndex(3));
+            Subsystem->NotifyPlayerAdded(WaitingPlayer);
+
+            const auto bDeferred =
+                TestEqual(TEXT("Joins should be pending until processed"), Manager->GetNumPendingPlayerJoins(), 3)
+                && TestNull(TEXT("No layout should be created when a player is added"),
+                            Manager->GetPrimaryLayout(LocalPlayers[0]))
+                && TestNull(TEXT("No shared layout should be created when a player is added"),
+                            Manager->GetSharedLayout());
+
+            Manager->FlushPendingPlayerJoins();
+
+            const auto bJoined =
+                TestEqual(TEXT("Only the join without a controller should remain pending after a flush"),
+                          Manager->GetNumPendingPlayerJoins(),
+                          1)
+                && TestNotNull(TEXT("First player should have a layout"), Manager->GetPrimaryLayout(LocalPlayers[0]))
+                && TestNotNull(TEXT("Second player should have a layout"), Manager->GetPrimaryLayout(LocalPlayers[1]))
+                && TestNull(TEXT("Removed player should not have a layout"),
+                            Manager->GetPrimaryLayout(LocalPlayers[2]))
+                && TestNotNull(TEXT("Shared layout should be created by the batch"), Manager->GetSharedLayout())
+                && TestEqual(TEXT("Layout classes should be prepared once per batch"), Manager->NumPrepareCalls, 1)
+                && TestNull(TEXT("Player without a controller should not have a layout yet"),
+                            Manager->GetPrimaryLayout(WaitingPlayer));
+
+            if (const auto PlayerController = World->SpawnActor<APlayerController>())
+            {
+                PlayerController->Player = WaitingPlayer;
+                WaitingPlayer->PlayerController = PlayerController;
+            }
+            Manager->FlushPendingPlayerJoins();
+            const auto bWaitedForController =
+                TestEqual(TEXT("No joins should be pending once the controller exists"),
+                          Manager->GetNumPendingPlayerJoins(),
+                          0)
+                && TestNotNull(TEXT("Player should have a layout once its controller exists"),
+                               Manager->GetPrimaryLayout(WaitingPlayer));
+
+            for (const auto LocalPlayer : LocalPlayers)
+            {
+                Subsystem->NotifyPlayerDestroyed(LocalPlayer);
+            }
+            bSuccess = bDeferred && bJoined && bWaitedForController;
+        }
+
+        GameInstance->Shutdown();
+        GameInstance->RemoveFromRoot();
+        return bSuccess;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazePrimaryLayoutManagerCountsInputSuspensionsTest,
+                                 "Blaze.PrimaryLayoutManager.CountsInputSuspensions",
+                                 BlazePrimaryLayoutTests::AutomationTestFlags)
+bool FBlazePrimaryLayoutManagerCountsInputSuspensionsTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+    {
+        const auto GameInstance = World->CreateGameInstance(UBlazeAutomationTestPrimaryLayoutManager::StaticClass());
+
+        auto bSuccess{ false };
+        const auto Subsystem = GameInstance->GetSubsystem<UBlazeAutomationTestSubsystem>();
+        if (TestNotNull(TEXT("Test subsystem should be created by the test game instance"), Subsystem))
+        {
+            const auto Manager = NewObject<UBlazeAutomationTestPrimaryLayoutManager>(Subsystem);
+            Manager->LayerTag = BlazePrimaryLayoutTests::TestLayerTag;
+            FBlazeTestWorld::SwitchToPrimaryLayoutManager(*Subsystem, Manager);
+
+            const auto LocalPlayer = NewObject<ULocalPlayer>(GEngine);
+            GameInstance->AddLocalPlayer(LocalPlayer, FPlatformMisc::GetPlatformUserForUserIndex(0));
+            if (const auto PlayerController = World->SpawnActor<APlayerController>())
+            {
+                PlayerController->Player = LocalPlayer;
+                LocalPlayer->PlayerController = PlayerController;
+            }
+            Subsystem->NotifyPlayerAdded(LocalPlayer);
+
+            const auto CommonInputSubsystem = UCommonInputSubsystem::Get(LocalPlayer);
+            if (TestNotNull(TEXT("Player should have a layout"), Manager->GetPrimaryLayout(LocalPlayer))
+                && TestNotNull(TEXT("Player should have a CommonInputSubsystem"), CommonInputSubsystem))
+            {
+                const FName ExternalReason(TEXT("BlazeTestExternalSuspension"));
+                CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, ExternalReason, true);
+                const auto bIgnoresExternal =
+                    TestEqual(TEXT("Suspensions created outside of Blaze should not be counted"),
+                              Manager->GetNumInputSuspendedPlayers(),
+                              0);
+
+                const auto Token =
+                    UBlazeFunctionLibrary::SuspendInputForPlayer(LocalPlayer, FName(TEXT("BlazeTestSuspension")));
+                const auto bCountsSuspended = TestEqual(TEXT("Suspensions created by Blaze should be counted"),
+                                                        Manager->GetNumInputSuspendedPlayers(),
+                                                        1);
+
+                UBlazeFunctionLibrary::ResumeInputForPlayer(LocalPlayer, Token);
+                const auto bCountsResumed =
+                    TestEqual(TEXT("Resumed suspensions should not be counted while another system suspends input"),
+                              Manager->GetNumInputSuspendedPlayers(),
+                              0);
+                CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, ExternalReason, false);
+
+                bSuccess = bIgnoresExternal && bCountsSuspended && bCountsResumed;
+            }
+            Subsystem->NotifyPlayerDestroyed(LocalPlayer);
+        }
+
+        GameInstance->Shutdown();
+        GameInstance->RemoveFromRoot();
+        return bSuccess;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+#endif
@@ -0,0 +1,420 @@
+#if WITH_DEV_AUTOMATION_TESTS
+
+    #include "Blaze/BlazePrimaryLayout.h"
+    #include "Blaze/BlazePrimaryLayoutManager.h"
+    #include "Blaze/BlazePushRequest.h"
+    #include "CommonInputSubsystem.h"
+    #include "Containers/Ticker.h"
+    #include "Engine/Engine.h"
+    #include "Engine/LocalPlayer.h"
+    #include "HAL/IConsoleManager.h"
+    #include "Math/RandomStream.h"
+    #include "Misc/AutomationTest.h"
+    #include "NativeGameplayTags.h"
+    #include "Tests/Blaze/BlazeAutomationTestTypes.h"
+    #include "Tests/Blaze/BlazeTestWorld.h"
+    #include "Tickable.h"
+    #include "UObject/UObjectIterator.h"
+
+namespace BlazeSoakTests
+{
+    // The soak takes several seconds so it is excluded from the product test runs
+    constexpr auto AutomationTestFlags =
+        EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::StressFilter;
+
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestLayerTag, "Blaze.Test.Soak.Layer");
+
+    constexpr int32 Seed{ 0x5EED };
+    constexpr int32 NumOperations{ 5000 };
+    constexpr int32 NumPlayers{ 4 };
+
+    // Invariants that require a garbage collection are checked at this interval
+    constexpr int32 CheckpointInterval{ 500 };
+
+    // The run is split into this many buckets to measure how the cost of each operation drifts over the run
+    constexpr int32 NumTimingBuckets{ 10 };
+
+    // The number of async push handles retained so that individual requests can be canceled
+    constexpr int32 MaxRetainedRequests{ 32 };
+
+    enum class EOperation : uint8
+    {
+        SyncPush,
+        AsyncPush,
+        Pop,
+        ClearLayer,
+        Cancel,
+        Tick,
+        AddPlayer,
+        RemovePlayer,
+        DestroyPlayer,
+        SwitchManager,
+        Num
+    };
+
+    constexpr int32 NumOperationTypes{ static_cast<int32>(EOperation::Num) };
+
+    const TCHAR* const OperationNames[NumOperationTypes] = {
+        TEXT("SyncPush"), TEXT("AsyncPush"), TEXT("Pop"),          TEXT("ClearLayer"),    TEXT("Cancel"),
+        TEXT("Tick"),     TEXT("AddPlayer"), TEXT("RemovePlayer"), TEXT("DestroyPlayer"), TEXT("SwitchManager")
+    };
+
+    // The relative frequency of each operation
+    constexpr int32 OperationWeights[NumOperationTypes] = { 20, 20, 20, 4, 6, 15, 6, 4, 3, 2 };
+
+    void ForceLinkSoakTests() {}
+
+    /** Count the layouts, managers and activatable widgets that are alive, excluding defaults and archetypes. */
+    int32 CountLiveBlazeObjects()
+    {
+        constexpr auto ExclusionFlags = RF_ClassDefaultObject | RF_ArchetypeObject;
+        auto Count{ 0 };
+        for (TObjectIterator<UBlazePrimaryLayout> It(ExclusionFlags); It; ++It)
+        {
+            Count++;
+        }
+        for (TObjectIterator<UBlazePrimaryLayoutManager> It(ExclusionFlags); It; ++It)
+        {
+            Count++;
+        }
+        for (TObjectIterator<UCommonActivatableWidget> It(ExclusionFlags); It; ++It)
+        {
+            Count++;
+        }
+        return Count;
+    }
+
+    struct FSoakPlayer
+    {
+        ULocalPlayer* LocalPlayer{ nullptr };
+        APlayerController* PlayerController{ nullptr };
+    };
+
+    /**
+     * Drives randomised operations against the layouts of a set of players hosted by a test game instance.
+     */
+    class FSoakHarness
+    {
+    public:
+        FSoakHarness(FAutomationTestBase& InTest, UBlazeAutomationTestGameInstance& InGameInstance)
+            : Test(InTest), GameInstance(InGameInstance), Random(Seed)
+        {
+        }
+
+        bool Initialize(const FBlazeTestWorld& World)
+        {
+            Subsystem = GameInstance.GetSubsystem<UBlazeAutomationTestSubsystem>();
+            if (Test.TestNotNull(TEXT("Test subsystem should be created by the test game instance"), Subsystem))
+            {
+                for (auto i = 0; i < NumPlayers; ++i)
+                {
+                    auto& Player = Players.AddDefaulted_GetRef();
+                    Player.LocalPlayer = NewObject<ULocalPlayer>(GEngine, ULocalPlayer::StaticClass());
+                    GameInstance.AddLocalPlayer(Player.LocalPlayer, FPlatformMisc::GetPlatformUserForUserIndex(i));
+                    Player.PlayerController = World.SpawnActor<APlayerController>();
+                    if (Player.PlayerController)
+                    {
+                        Player.PlayerController->Player = Player.LocalPlayer;
+                        Player.LocalPlayer->PlayerController = Player.PlayerController;
+                    }
+                }
+                return Test.TestFalse(TEXT("Every player should have a player controller"),
+                                      Players.ContainsByPredicate(
+                                          [](const auto& Player) { return nullptr == Player.PlayerController; }))
+                    && SwitchManager();
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        bool Run()
+        {
+            auto TotalWeight{ 0 };
+            for (const auto Weight : OperationWeights)
+            {
+                TotalWeight += Weight;
+            }
+
+            for (auto i = 0; i < NumOperations; ++i)
+            {
+                auto Roll = Random.RandRange(0, TotalWeight - 1);
+                auto Operation{ 0 };
+                while (Roll >= OperationWeights[Operation])
+                {
+                    Roll -= OperationWeights[Operation];
+                    Operation++;
+                }
+
+                const auto StartTime = FPlatformTime::Seconds();
+                if (!Apply(static_cast<EOperation>(Operation)))
+                {
+                    Test.AddError(FString::Printf(TEXT("Operation %d (%s) failed"), i, OperationNames[Operation]));
+                    return false;
+                }
+                const auto Bucket = i * NumTimingBuckets / NumOperations;
+                TimingSeconds[Operation][Bucket] += FPlatformTime::Seconds() - StartTime;
+                TimingCounts[Operation][Bucket]++;
+
+                if (0 == (i + 1) % CheckpointInterval && !CheckNoOrphanedWidgets())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /** Cancel every outstanding request and check that no request slot or input suspension leaked. */
+        bool Drain(const int32 BaselinePendingRequests, const int32 BaselineLiveRequests)
+        {
+            for (const auto& Player : Players)
+            {
+                if (const auto Layout = GetLayout(Player))
+                {
+                    Layout->CancelAllPushRequests();
+                }
+            }
+            Requests.Reset();
+
+            const auto bPending = Test.TestEqual(TEXT("No request should remain pending after draining"),
+                                                 FBlazePushRequest::GetNumPendingRequests(),
+                                                 BaselinePendingRequests);
+            const auto bLive = Test.TestEqual(TEXT("Every request slot should return to the pool"),
+                                              FBlazePushRequest::GetNumLiveRequests(),
+                                              BaselineLiveRequests);
+            auto bInputResumed{ true };
+            for (const auto& Player : Players)
+            {
+                if (const auto CommonInputSubsystem = UCommonInputSubsystem::Get(Player.LocalPlayer))
+                {
+                    bInputResumed &= Test.TestFalse(TEXT("Input should not remain suspended after draining"),
+                                                    CommonInputSubsystem->GetInputTypeFilter(
+                                                        ECommonInputType::MouseAndKeyboard));
+                }
+            }
+            return bPending && bLive && bInputResumed && CheckNoOrphanedWidgets();
+        }
+
+        void DestroyPlayers()
+        {
+            for (const auto& Player : Players)
+            {
+                Subsystem->NotifyPlayerDestroyed(Player.LocalPlayer);
+            }
+        }
+
+        /** Report how the mean cost of each operation changed between the start and the end of the run. */
+        void ReportTimingDrift() const
+        {
+            for (auto Operation = 0; Operation < NumOperationTypes; ++Operation)
+            {
+                const auto FirstCount = TimingCounts[Operation][0];
+                const auto LastCount = TimingCounts[Operation][NumTimingBuckets - 1];
+                if (FirstCount > 0 && LastCount > 0)
+                {
+                    const auto FirstUs = TimingSeconds[Operation][0] * 1000000.0 / FirstCount;
+                    const auto LastUs = TimingSeconds[Operation][NumTimingBuckets - 1] * 1000000.0 / LastCount;
+                    Test.AddInfo(FString::Printf(TEXT("%s: %.2fus at start, %.2fus at end (%+.0f%%)"),
+                                                 OperationNames[Operation],
+                                                 FirstUs,
+                                                 LastUs,
+                                                 FirstUs > 0.0 ? (LastUs - FirstUs) * 100.0 / FirstUs : 0.0));
+                }
+            }
+        }
+
+    private:
+        FAutomationTestBase& Test;
+        UBlazeAutomationTestGameInstance& GameInstance;
+        FRandomStream Random;
+        UBlazeAutomationTestSubsystem* Subsystem{ nullptr };
+        TArray<FSoakPlayer> Players;
+        TArray<FBlazePushRequest> Requests;
+        double TimingSeconds[NumOperationTypes][NumTimingBuckets]{};
+        int32 TimingCounts[NumOperationTypes][NumTimingBuckets]{};
+
+        UBlazePrimaryLayoutManager* GetManager() const
+        {
+            return FBlazeTestWorld::GetPrimaryLayoutManager(*Subsystem);
+        }
+
+        UBlazePrimaryLayout* GetLayout(const FSoakPlayer& Player) const
+        {
+            const auto Manager = GetManager();
+            return Manager ? Manager->GetPrimaryLayout(Player.LocalPlayer) : nullptr;
+        }
+
+        const FSoakPlayer& PickPlayer() { return Players[Random.RandRange(0, Players.Num() - 1)]; }
+
+        bool Apply(const EOperation Operation)
+        {
+            const auto& Player = PickPlayer();
+            const auto Layout = GetLayout(Player);
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+            switch (Operation)
+            {
+                case EOperation::SyncPush:
+                    return !Layout || nullptr != Layout->PushWidgetToLayer(TestLayerTag, WidgetClass);
+                case EOperation::AsyncPush:
+                    if (Layout)
+                    {
+                        auto Request =
+                            Layout->PushWidgetToLayerAsync(TestLayerTag,
+                                                           Random.RandRange(0, 1) > 0,
+                                                           TSoftClassPtr<UCommonActivatableWidget>(WidgetClass),
+                                                           FBlazePushRequestDelegate());
+                        if (Request.IsPending())
+                        {
+                            if (Requests.Num() >= MaxRetainedRequests)
+                            {
+                                Requests.RemoveAtSwap(Random.RandRange(0, Requests.Num() - 1));
+                            }
+                            Requests.Add(MoveTemp(Request));
+                        }
+                    }
+                    return true;
+                case EOperation::Pop:
+                    if (const auto Layer = Layout ? Layout->GetLayer(TestLayerTag) : nullptr)
+                    {
+                        const auto& Widgets = Layer->GetWidgetList();
+                        if (!Widgets.IsEmpty())
+                        {
+                            Layout->RemoveWidgetFromLayer(TestLayerTag,
+                                                          Widgets[Random.RandRange(0, Widgets.Num() - 1)]);
+                        }
+                    }
+                    return true;
+                case EOperation::ClearLayer:
+                    if (Layout)
+                    {
+                        Layout->ClearLayer(TestLayerTag);
+                    }
+                    return true;
+                case EOperation::Cancel:
+                    if (!Requests.IsEmpty())
+                    {
+                        const auto Index = Random.RandRange(0, Requests.Num() - 1);
+                        Requests[Index].Cancel();
+                        Requests.RemoveAtSwap(Index);
+                    }
+                    else if (Layout)
+                    {
+                        Layout->CancelAllPushRequests();
+                    }
+                    return true;
+                case EOperation::Tick:
+                    // Completes async loads of already loaded classes and advances Blaze tickers
+                    FTickableGameObject::TickObjects(GameInstance.GetWorld(), LEVELTICK_All, false, 0.0f);
+                    FTSTicker::GetCoreTicker().Tick(0.0f);
+                    return true;
+                case EOperation::AddPlayer:
+                    Subsystem->NotifyPlayerAdded(Player.LocalPlayer);
+                    return nullptr != GetLayout(Player);
+                case EOperation::RemovePlayer:
+                    Subsystem->NotifyPlayerRemoved(Player.LocalPlayer);
+                    return true;
+                case EOperation::DestroyPlayer:
+                    Subsystem->NotifyPlayerDestroyed(Player.LocalPlayer);
+                    return nullptr == GetLayout(Player);
+                case EOperation::SwitchManager:
+                    return SwitchManager();
+                default:
+                    checkNoEntry();
+                    return false;
+            }
+        }
+
+        /** Release the layouts of the current manager and switch to a new manager. */
+        bool SwitchManager()
+        {
+            if (GetManager())
+            {
+                DestroyPlayers();
+            }
+            const auto Manager = NewObject<UBlazeAutomationTestPrimaryLayoutManager>(Subsystem);
+            Manager->LayerTag = TestLayerTag;
+            FBlazeTestWorld::SwitchToPrimaryLayoutManager(*Subsystem, Manager);
+            return Test.TestTrue(TEXT("Subsystem should use the new manager"), GetManager() == Manager);
+        }
+
+        /** Collect garbage and check that every remaining widget is hosted by a layout of the current manager. */
+        bool CheckNoOrphanedWidgets()
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+            TSet<const UBlazePrimaryLayout*> Layouts;
+            for (const auto& Player : Players)
+            {
+                if (const auto Layout = GetLayout(Player))
+                {
+                    Layouts.Add(Layout);
+                }
+            }
+
+            auto NumOrphans{ 0 };
+            for (TObjectIterator<UBlazeAutomationTestActivatableWidget> It; It; ++It)
+            {
+                if (It->GetTypedOuter<UGameInstance>() == &GameInstance
+                    && !Layouts.Contains(It->GetTypedOuter<UBlazePrimaryLayout>()))
+                {
+                    NumOrphans++;
+                }
+            }
+            return Test.TestEqual(TEXT("Widgets should not outlive the layouts that host them"), NumOrphans, 0);
+        }
+    };
+} // namespace BlazeSoakTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazeSoakRandomisedLayoutOperationsTest,
+                                 "Blaze.Soak.RandomisedLayoutOperations",
+                                 BlazeSoakTests::AutomationTestFlags)
+bool FBlazeSoakRandomisedLayoutOperationsTest::RunTest(const FString&)
+{
+    // Compute closures synchronously so that the run is deterministic
+    const auto SoftReferenceDepth =
+        IConsoleManager::Get().FindConsoleVariable(TEXT("Blaze.Preload.SoftReferenceDepth"));
+    if (TestNotNull(TEXT("Soft reference depth console variable should exist"), SoftReferenceDepth))
+    {
+        const auto PreviousSoftReferenceDepth = SoftReferenceDepth->GetInt();
+        SoftReferenceDepth->Set(0, ECVF_SetByCode);
+
+        const auto BaselineObjects = BlazeSoakTests::CountLiveBlazeObjects();
+        const auto BaselinePendingRequests = FBlazePushRequest::GetNumPendingRequests();
+        const auto BaselineLiveRequests = FBlazePushRequest::GetNumLiveRequests();
+
+        auto World = MakeUnique<FBlazeTestWorld>();
+        auto bSuccess{ false };
+        if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid()))
+        {
+            const auto GameInstance =
+                World->CreateGameInstance(UBlazeAutomationTestPrimaryLayoutManager::StaticClass());
+
+            {
+                BlazeSoakTests::FSoakHarness Harness(*this, *GameInstance);
+                bSuccess = Harness.Initialize(*World) && Harness.Run()
+                    && Harness.Drain(BaselinePendingRequests, BaselineLiveRequests);
+                Harness.ReportTimingDrift();
+                Harness.DestroyPlayers();
+            }
+
+            GameInstance->Shutdown();
+            GameInstance->RemoveFromRoot();
+        }
+        World.Reset();
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+        SoftReferenceDepth->Set(PreviousSoftReferenceDepth, ECVF_SetByCode);
+
+        const auto bObjectsReleased = TestEqual(TEXT("Blaze object count should return to baseline after GC"),
+                                                BlazeSoakTests::CountLiveBlazeObjects(),
+                                                BaselineObjects);
+        return bSuccess && bObjectsReleased;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+    #include "Engine/Engine.h"
+    #include "Engine/World.h"
+    #include "Tests/Blaze/BlazeAutomationTestTypes.h"
+
+/**
+ * A minimal game world that is created for the duration of an automation test.
+ */
+class FBlazeTestWorld
+{
+public:
+    FBlazeTestWorld()
+    {
+        if (GEngine)
+        {
+            World = UWorld::CreateWorld(EWorldType::Game,
+                                        false,
+                                        MakeUniqueObjectName(GetTransientPackage(),
+                                                             UWorld::StaticClass(),
+                                                             FName(TEXT("BlazeAutomationTestWorld"))),
+                                        GetTransientPackage(),
+                                        true);
+            if (World)
+            {
+                World->SetShouldTick(false);
+                World->AddToRoot();
+
+                auto& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+                WorldContext.SetCurrentWorld(World);
+            }
+        }
+    }
+
+    ~FBlazeTestWorld()
+    {
+        if (World)
+        {
+            World->RemoveFromRoot();
+            if (GEngine)
+            {
+                GEngine->DestroyWorldContext(World);
+            }
+            World->DestroyWorld(false);
+        }
+    }
+
+    bool IsValid() const { return nullptr != World; }
+
+    template <typename TActor>
+    TActor* SpawnActor() const
+    {
+        if (World)
+        {
+            FActorSpawnParameters SpawnParameters;
+            SpawnParameters.ObjectFlags |= RF_Transient;
+            SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+            return World->SpawnActor<TActor>(TActor::StaticClass(),
+                                             FVector::ZeroVector,
+                                             FRotator::ZeroRotator,
+                                             SpawnParameters);
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    UWorld* Get() const { return World; }
+
+    /** Create and initialize a game instance for the world whose subsystem creates a manager of the class. */
+    UBlazeAutomationTestGameInstance*
+    CreateGameInstance(const TSoftClassPtr<UBlazePrimaryLayoutManager>& ManagerClass) const
+    {
+        const auto Subsystem = GetMutableDefault<UBlazeAutomationTestSubsystem>();
+        Subsystem->PrimaryLayoutManagerClass = ManagerClass;
+        const auto GameInstance = NewObject<UBlazeAutomationTestGameInstance>(GEngine);
+        GameInstance->AddToRoot();
+        GameInstance->SetTestWorldContext(*GEngine->GetWorldContextFromWorld(World));
+        GameInstance->Init();
+        Subsystem->PrimaryLayoutManagerClass.Reset();
+        return GameInstance;
+    }
+
+    static UBlazePrimaryLayoutManager* GetPrimaryLayoutManager(const UBlazeSubsystem& Subsystem)
+    {
+        return Subsystem.PrimaryLayoutManager;
+    }
+
+    static void SwitchToPrimaryLayoutManager(UBlazeSubsystem& Subsystem, UBlazePrimaryLayoutManager* Manager)
+    {
+        Subsystem.SwitchToPrimaryLayoutManager(Manager);
+    }
+
+    /** Create a layout definition with the layers. */
+    static UBlazeLayoutDefinition* CreateLayoutDefinition(TArray<FBlazeLayerDefinition>&& Layers)
+    {
+        const auto Definition = NewObject<UBlazeLayoutDefinition>();
+        Definition->Layers = MoveTemp(Layers);
+        return Definition;
+    }
+
+private:
+    UWorld* World{ nullptr };
+};
+
+#endif
@@ -0,0 +1,245 @@
+#if WITH_DEV_AUTOMATION_TESTS
+
+    #include "Blaze/BlazeActivatableWidgetStack.h"
+    #include "Blaze/BlazePrimaryLayout.h"
+    #include "Blaze/BlazeTrace.h"
+    #include "HAL/FileManager.h"
+    #include "Misc/AutomationTest.h"
+    #include "Misc/Paths.h"
+    #include "NativeGameplayTags.h"
+    #include "Tests/Blaze/BlazeAutomationTestTypes.h"
+    #include "Tests/Blaze/BlazeTestWorld.h"
+
+namespace BlazeTraceTests
+{
+    constexpr auto AutomationTestFlags =
+        EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+    // Replaying recorded sessions is a benchmark rather than a correctness check
+    constexpr auto ReplayAutomationTestFlags =
+        EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter;
+
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TestLayerTag, "Blaze.Test.Trace.Layer");
+
+    void ForceLinkTraceTests() {}
+
+    FString GetTraceDir()
+    {
+        return FPaths::ProjectSavedDir() / TEXT("Blaze/Traces");
+    }
+
+    /** Create a layout that registers every layer referenced by the trace. */
+    UBlazePrimaryLayout* CreateReplayLayout(UWorld* World, const FBlazeTrace& Trace)
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World);
+        if (Layout)
+        {
+            for (const auto& Event : Trace.Events)
+            {
+                const FName TagName(*Trace.GetString(Event.LayerName));
+                const auto LayerTag = FGameplayTag::RequestGameplayTag(TagName, false);
+                if (LayerTag.IsValid() && !Layout->HasLayer(LayerTag))
+                {
+                    Layout->AddTestLayer(LayerTag);
+                }
+            }
+        }
+        return Layout;
+    }
+} // namespace BlazeTraceTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazeTraceRecordAndReplayTest,
+                                 "Blaze.Trace.RecordAndReplay",
+                                 BlazeTraceTests::AutomationTestFlags)
+bool FBlazeTraceRecordAndReplayTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestFalse(TEXT("No trace should be recording before the test"), FBlazeTraceRecorder::IsRecording()))
+    {
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout))
+        {
+            const auto& LayerTag = BlazeTraceTests::TestLayerTag;
+            Layout->AddTestLayer(LayerTag);
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+
+            FBlazeTraceRecorder::Start();
+            const auto First = Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+            Layout->BeginLayerTransaction();
+            Layout->PushWidgetToLayer(LayerTag, WidgetClass);
+            Layout->CommitLayerTransaction();
+            if (First)
+            {
+                Layout->RemoveWidgetFromLayer(LayerTag, First);
+            }
+            const auto Filename =
+                FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("Blaze"), TEXT(".blztrace"));
+            const auto Recorded = FBlazeTraceRecorder::Stop(Filename);
+
+            FBlazeTrace Loaded;
+            const auto bLoaded = TestTrue(TEXT("The saved trace should load"), Loaded.LoadFromFile(Filename));
+            IFileManager::Get().Delete(*Filename);
+
+            const auto bStopped = TestFalse(TEXT("Recording should stop"), FBlazeTraceRecorder::IsRecording());
+            const auto bRecorded = TestEqual(TEXT("Every operation should be recorded"), Recorded.Events.Num(), 5);
+            const auto bRoundTrip =
+                TestEqual(TEXT("The loaded trace should contain every event"), Loaded.Events.Num(), 5)
+                && TestTrue(TEXT("The loaded trace should contain the string table"),
+                            Loaded.Strings == Recorded.Strings)
+                && TestEqual(TEXT("The pop should reference the first push"),
+                             Loaded.Events[4].WidgetId,
+                             Loaded.Events[0].WidgetId);
+
+            const auto ReplayLayout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+            if (bLoaded && bRoundTrip && TestNotNull(TEXT("Replay layout should be created"), ReplayLayout))
+            {
+                const auto ReplayLayer = ReplayLayout->AddTestLayer(LayerTag);
+                const auto Report =
+                    FBlazeTraceReplayer::Replay(Loaded, [ReplayLayout](uint8) { return ReplayLayout; });
+
+                const auto& Pushes = Report.Timings[static_cast<int32>(EBlazeTraceOp::Push)];
+                const auto& Pops = Report.Timings[static_cast<int32>(EBlazeTraceOp::Pop)];
+                const auto bSkipped = TestEqual(TEXT("No event should be skipped"), Report.SkippedEvents, 0);
+                const auto bPushes = TestEqual(TEXT("Every push should be replayed"), Pushes.Count, 2);
+                const auto bPops = TestEqual(TEXT("Every pop should be replayed"), Pops.Count, 1);
+                const auto bLayer = TestEqual(TEXT("The replayed layer should match the recorded layer"),
+                                              ReplayLayer->GetNumWidgets(),
+                                              1);
+                return bStopped && bRecorded && bSkipped && bPushes && bPops && bLayer;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlazeTraceRecordsRehydratedWidgetsTest,
+                                 "Blaze.Trace.RecordsRehydratedWidgets",
+                                 BlazeTraceTests::AutomationTestFlags)
+bool FBlazeTraceRecordsRehydratedWidgetsTest::RunTest(const FString&)
+{
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestFalse(TEXT("No trace should be recording before the test"), FBlazeTraceRecorder::IsRecording()))
+    {
+        const auto& LayerTag = BlazeTraceTests::TestLayerTag;
+        FBlazeLayerConfig Config;
+        Config.DehydrateDepth = 1;
+        const auto Layout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        const auto ReplayLayout = CreateWidget<UBlazeAutomationTestPrimaryLayout>(World->Get());
+        if (TestNotNull(TEXT("Primary layout should be created"), Layout)
+            && TestNotNull(TEXT("Replay layout should be created"), ReplayLayout))
+        {
+            // The stacks only release the widgets they remove once they have constructed their Slate widgets
+            Layout->AddTestLayer<UBlazeActivatableWidgetStack>(LayerTag, Config)->TakeWidget();
+            const auto ReplayLayer = ReplayLayout->AddTestLayer<UBlazeActivatableWidgetStack>(LayerTag, Config);
+            ReplayLayer->TakeWidget();
+            const auto WidgetClass = UBlazeAutomationTestActivatableWidget::StaticClass();
+
+            FBlazeTraceRecorder::Start();
+            TArray<UCommonActivatableWidget*> Pushed;
+            for (auto i = 0; i < 3; ++i)
+            {
+                Pushed.Add(Layout->PushWidgetToLayer(LayerTag, WidgetClass));
+            }
+            // Popping to the last live widget rehydrates the bottom widget
+            Layout->RemoveWidgetFromLayer(LayerTag, Pushed[2]);
+            // A widget that is no longer on the layer is not recorded
+            Layout->RemoveWidgetFromLayer(LayerTag, Pushed[2]);
+            TArray<UCommonActivatableWidget*> Widgets;
+            Layout->GetLayerWidgets(LayerTag, Widgets);
+            if (!Widgets.IsEmpty())
+            {
+                Layout->RemoveWidgetFromLayer(LayerTag, Widgets[0]);
+            }
+            const auto Filename =
+                FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("Blaze"), TEXT(".blztrace"));
+            const auto Recorded = FBlazeTraceRecorder::Stop(Filename);
+            IFileManager::Get().Delete(*Filename);
+
+            if (TestEqual(TEXT("Pushes, pops and the rehydration should be recorded"), Recorded.Events.Num(), 6))
+            {
+                const auto& Rehydrate = Recorded.Events[4];
+                const auto& Pop = Recorded.Events[5];
+                const auto bRehydrate = TestTrue(TEXT("Rehydration should be recorded after the pop"),
+                                                 EBlazeTraceOp::Pop == Recorded.Events[3].Op
+                                                     && EBlazeTraceOp::Rehydrate == Rehydrate.Op);
+                const auto bPop =
+                    TestTrue(TEXT("The pop of the rehydrated widget should reference the rehydration"),
+                             EBlazeTraceOp::Pop == Pop.Op && 0 != Pop.WidgetId && Rehydrate.WidgetId == Pop.WidgetId);
+
+                const auto Report =
+                    FBlazeTraceReplayer::Replay(Recorded, [ReplayLayout](uint8) { return ReplayLayout; });
+                const auto bSkipped = TestEqual(TEXT("No event should be skipped"), Report.SkippedEvents, 0);
+                const auto bLayer = TestEqual(TEXT("The replayed layer should match the recorded layer"),
+                                              ReplayLayer->GetNumWidgets(),
+                                              1);
+                return bRehydrate && bPop && bSkipped && bLayer;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FBlazeTraceReplayTest,
+                                  "Blaze.Trace.Replay",
+                                  BlazeTraceTests::ReplayAutomationTestFlags)
+void FBlazeTraceReplayTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    TArray<FString> Filenames;
+    IFileManager::Get().FindFiles(Filenames, *(BlazeTraceTests::GetTraceDir() / TEXT("*.blztrace")), true, false);
+    for (const auto& Filename : Filenames)
+    {
+        OutBeautifiedNames.Add(FPaths::GetBaseFilename(Filename));
+        OutTestCommands.Add(BlazeTraceTests::GetTraceDir() / Filename);
+    }
+}
+
+bool FBlazeTraceReplayTest::RunTest(const FString& Parameters)
+{
+    FBlazeTrace Trace;
+    const auto World = MakeUnique<FBlazeTestWorld>();
+    if (TestTrue(TEXT("Automation test world should be valid"), World->IsValid())
+        && TestTrue(FString::Printf(TEXT("Trace [%s] should load"), *Parameters), Trace.LoadFromFile(Parameters)))
+    {
+        TMap<uint8, TObjectPtr<UBlazePrimaryLayout>> Layouts;
+        const auto Report = FBlazeTraceReplayer::Replay(Trace, [&](const uint8 Player) {
+            auto& Layout = Layouts.FindOrAdd(Player);
+            if (!Layout)
+            {
+                Layout = BlazeTraceTests::CreateReplayLayout(World->Get(), Trace);
+            }
+            return Layout.Get();
+        });
+        Report.Dump(*GLog);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+#endif
@@ -93,4 +93,8 @@ private:
     void OnCancel(TWeakObjectPtr<APlayerController> WeakPlayer,
                   FName SuspendInputToken,
                   TWeakObjectPtr<UAsyncAction_CreateWidgetAsync> Self);
+
+    void BeginLoad(const TArray<FSoftObjectPath>& Paths,
+                   TWeakObjectPtr<APlayerController> WeakPlayer,
+                   FName SuspendInputToken);
 };
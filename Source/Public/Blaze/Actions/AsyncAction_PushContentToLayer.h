@@ -13,6 +13,8 @@
  */
 #pragma once
 
+#include "Blaze/BlazePayloadReceiver.h"
+#include "Blaze/BlazePushRequest.h"
 #include "Engine/CancellableAsyncAction.h"
 #include "GameplayTagContainer.h"
 #include "UObject/SoftObjectPtr.h"
@@ -20,12 +22,14 @@
 
 class APlayerController;
 class UCommonActivatableWidget;
-struct FStreamableHandle;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPushContentToLayerAsyncSignature, UCommonActivatableWidget*, UserWidget);
 
 /**
  * Asynchronous action class for pushing a widget onto a specified UI layer.
+ *
+ * This is a thin Blueprint wrapper around FBlazePushRequest. Native code should prefer
+ * UBlazePrimaryLayout::PushWidgetToLayerAsync as it does not allocate a UObject per request.
  */
 UCLASS(MinimalAPI, BlueprintType)
 class UAsyncAction_PushContentToLayer final : public UCancellableAsyncAction
@@ -65,6 +69,8 @@ public:
      * @param LayerName The gameplay tag specifying the UI layer to place the widget on. Must be valid.
      * @param WidgetClass The widget class to be added to the specific layer. Must not be null.
      * @param bSuspendInputUntilComplete Indicates whether player input is suspended until the action is complete.
+     * @param bRevealWhenResident Indicates whether the widget remains collapsed until the textures it references
+     * have streamed in.
      * @return An instance of UAsyncAction_PushContentToLayer if successful, or nullptr if any of the parameters are
      * invalid.
      */
@@ -72,12 +78,46 @@ public:
               BlueprintCosmetic,
               DisplayName = "Push Content To Layer Async",
               Category = "Blaze",
-              meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
+              meta = (WorldContext = "WorldContextObject",
+                      BlueprintInternalUseOnly = "true",
+                      AdvancedDisplay = "bRevealWhenResident"))
     static BLAZE_API UAsyncAction_PushContentToLayer*
     PushContentToLayerAsync(APlayerController* PlayerController,
                             UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName,
                             UPARAM(meta = (AllowAbstract = false)) TSoftClassPtr<UCommonActivatableWidget> WidgetClass,
-                            bool bSuspendInputUntilComplete = true);
+                            bool bSuspendInputUntilComplete = true,
+                            bool bRevealWhenResident = false);
+
+    /**
+     * Loads and adds a widget, initialized from the payload, to the specified UI layer asynchronously.
+     *
+     * The payload is held until the widget class has loaded and is delivered to the widget via
+     * IBlazePayloadReceiver before OnInitialize is broadcast.
+     *
+     * @param PlayerController The player controller associated with this operation. Must not be null.
+     * @param LayerName The gameplay tag specifying the UI layer to place the widget on. Must be valid.
+     * @param WidgetClass The widget class to be added to the specific layer. Must not be null.
+     * @param Payload The payload delivered to the widget.
+     * @param bSuspendInputUntilComplete Indicates whether player input is suspended until the action is complete.
+     * @param bRevealWhenResident Indicates whether the widget remains collapsed until the textures it references
+     * have streamed in.
+     * @return An instance of UAsyncAction_PushContentToLayer if successful, or nullptr if any of the parameters are
+     * invalid.
+     */
+    UFUNCTION(BlueprintCallable,
+              BlueprintCosmetic,
+              DisplayName = "Push Content To Layer With Payload Async",
+              Category = "Blaze",
+              meta = (WorldContext = "WorldContextObject",
+                      BlueprintInternalUseOnly = "true",
+                      AdvancedDisplay = "bRevealWhenResident"))
+    static BLAZE_API UAsyncAction_PushContentToLayer* PushContentToLayerWithPayloadAsync(
+        APlayerController* PlayerController,
+        UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName,
+        UPARAM(meta = (AllowAbstract = false)) TSoftClassPtr<UCommonActivatableWidget> WidgetClass,
+        const FInstancedStruct& Payload,
+        bool bSuspendInputUntilComplete = true,
+        bool bRevealWhenResident = false);
 
 private:
     TWeakObjectPtr<APlayerController> PlayerController{ nullptr };
@@ -88,5 +128,13 @@ private:
 
     bool bSuspendInputUntilComplete{ false };
 
-    TSharedPtr<FStreamableHandle> Handle;
+    bool bRevealWhenResident{ false };
+
+    /** The payload supplied to the action, which is moved into the request when the action is activated. */
+    UPROPERTY(Transient)
+    FInstancedStruct Payload;
+
+    FBlazePushRequest Request;
+
+    void OnRequestStateChanged(EBlazePushWidgetToLayerState State, UCommonActivatableWidget* Widget);
 };
@@ -0,0 +1,67 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Widgets/CommonActivatableWidgetContainer.h"
+#include "BlazeActivatableWidgetStack.generated.h"
+
+/**
+ * @brief A stack that can also insert widgets below the widgets it already holds.
+ *
+ * UCommonActivatableWidgetStack only adds widgets to the top of the stack. Layers that dehydrate their back-stack
+ * (see FBlazeLayerConfig::DehydrateDepth) use this container so that dehydrated widgets can be recreated below the
+ * displayed widget before navigation returns to them. On a plain UCommonActivatableWidgetStack, dehydrated widgets
+ * are only recreated once every live widget has been removed from the layer.
+ *
+ * The stack can also discard the widgets that it pools for reuse, which a plain UCommonActivatableWidgetStack keeps
+ * for as long as it lives, so that memory pressure can release widgets that have been removed from the layer.
+ */
+UCLASS(MinimalAPI)
+class UBlazeActivatableWidgetStack : public UCommonActivatableWidgetStack
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Create a widget and insert it into the stack at the specified position.
+     *
+     * The displayed widget does not change unless the widget is inserted at the top of the stack.
+     *
+     * @param WidgetClass The class of widget to create.
+     * @param Index The position in the stack, where 0 is the bottom of the stack.
+     * @param InitFunc A function invoked with the widget before it is inserted.
+     * @return The widget inserted, or nullptr if it could not be created.
+     */
+    BLAZE_API UCommonActivatableWidget* InsertWidget(TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                                     int32 Index,
+                                                     TFunctionRef<void(UCommonActivatableWidget&)> InitFunc);
+
+    /**
+     * Insert an existing widget into the stack at the specified position without displaying it.
+     *
+     * Unlike AddWidgetInstance, a widget inserted at the top of the stack is neither displayed nor activated. It is
+     * expected that another widget is added on top of it, as when several pushes are applied in a single pass.
+     *
+     * @param Widget The widget to insert.
+     * @param Index The position in the stack, where 0 is the bottom of the stack.
+     */
+    BLAZE_API void InsertWidgetInstance(UCommonActivatableWidget& Widget, int32 Index);
+
+    /**
+     * Stop pooling the widgets created by the stack so that those removed from it can be garbage collected.
+     *
+     * The widgets on the stack are unaffected, but they are no longer recycled once they are removed.
+     */
+    BLAZE_API void ReleasePooledWidgets();
+};
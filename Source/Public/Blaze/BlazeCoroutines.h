@@ -0,0 +1,193 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Blaze/BlazePushRequest.h"
+#include "GameplayTagContainer.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+// Coroutine support is only available when the module is compiled as C++20 or later
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+    #define BLAZE_WITH_COROUTINES 1
+#else
+    #define BLAZE_WITH_COROUTINES 0
+#endif
+
+#if BLAZE_WITH_COROUTINES
+
+    #include <coroutine>
+
+class APlayerController;
+class UBlazePrimaryLayout;
+class UCommonActivatableWidget;
+class UUserWidget;
+struct FStreamableHandle;
+
+/**
+ * @brief The return type of a fire-and-forget coroutine that drives a Blaze UI flow.
+ *
+ * The coroutine starts executing immediately and frees itself once it returns. Every Blaze awaitable resumes
+ * the coroutine on the game thread, so a flow can be written as straight-line code:
+ *
+ * @code
+ * FBlazeCoroutine ShowSettings(UBlazePrimaryLayout* Layout)
+ * {
+ *     const auto Menu = co_await FBlazePushWidgetAwaitable(Layout, Tag_Menu, MenuClass);
+ *     co_await FBlazeWidgetPoppedAwaitable(Menu);
+ *     co_await FBlazePushWidgetAwaitable(Layout, Tag_Menu, SettingsClass);
+ * }
+ * @endcode
+ *
+ * Objects referenced by the coroutine are not kept alive while it is suspended, so hold them via
+ * TWeakObjectPtr and check them after each co_await.
+ */
+struct FBlazeCoroutine
+{
+    struct promise_type
+    {
+        FBlazeCoroutine get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { checkNoEntry(); }
+    };
+};
+
+/**
+ * Awaitable that loads a widget class and pushes an instance onto a layer.
+ * The result of the co_await is the pushed widget, or nullptr if the push was canceled or failed.
+ *
+ * @see UBlazePrimaryLayout::PushWidgetToLayerAsync
+ */
+class FBlazePushWidgetAwaitable final
+{
+public:
+    BLAZE_API FBlazePushWidgetAwaitable(UBlazePrimaryLayout* InLayout,
+                                        const FGameplayTag& InLayerName,
+                                        const TSoftClassPtr<UCommonActivatableWidget>& InWidgetClass,
+                                        bool bInSuspendInputUntilComplete = true,
+                                        bool bInRevealWhenResident = false);
+
+    UE_NONCOPYABLE(FBlazePushWidgetAwaitable);
+
+    bool await_ready() const { return !Layout.IsValid(); }
+    BLAZE_API bool await_suspend(std::coroutine_handle<> InHandle);
+    BLAZE_API UCommonActivatableWidget* await_resume() const;
+
+private:
+    TWeakObjectPtr<UBlazePrimaryLayout> Layout{ nullptr };
+    FGameplayTag LayerName{ FGameplayTag::EmptyTag };
+    TSoftClassPtr<UCommonActivatableWidget> WidgetClass{ nullptr };
+    bool bSuspendInputUntilComplete{ true };
+    bool bRevealWhenResident{ false };
+
+    FBlazePushRequest Request;
+    TWeakObjectPtr<UCommonActivatableWidget> Widget{ nullptr };
+    std::coroutine_handle<> Handle;
+    bool bSuspending{ false };
+    bool bDone{ false };
+
+    void OnStateChanged(EBlazePushWidgetToLayerState State, UCommonActivatableWidget* InWidget);
+};
+
+/**
+ * Awaitable that loads a widget class and creates an instance owned by the player.
+ * The assets that the class references are loaded alongside it, as computed by the dependency closure.
+ * The result of the co_await is the created widget, or nullptr if the load was canceled or failed.
+ */
+class FBlazeCreateWidgetAwaitable final
+{
+public:
+    BLAZE_API FBlazeCreateWidgetAwaitable(APlayerController* InOwningPlayer,
+                                          const TSoftClassPtr<UUserWidget>& InWidgetClass);
+
+    UE_NONCOPYABLE(FBlazeCreateWidgetAwaitable);
+
+    bool await_ready() const { return !OwningPlayer.IsValid(); }
+    BLAZE_API bool await_suspend(std::coroutine_handle<> InHandle);
+    BLAZE_API UUserWidget* await_resume() const;
+
+private:
+    TWeakObjectPtr<APlayerController> OwningPlayer{ nullptr };
+    TSoftClassPtr<UUserWidget> WidgetClass{ nullptr };
+
+    TSharedPtr<FStreamableHandle> LoadHandle;
+    std::coroutine_handle<> Handle;
+    bool bSuspending{ false };
+    bool bDone{ false };
+
+    void BeginLoad(const TArray<FSoftObjectPath>& Paths);
+    void OnLoadFinished();
+};
+
+/**
+ * Awaitable that loads a set of assets, typically the widget classes and textures used by an upcoming screen.
+ * The result of the co_await is the streamable handle that keeps the assets loaded, or nullptr if the load
+ * was canceled or failed. Awaiting an empty set of assets completes immediately with nullptr.
+ */
+class FBlazePreloadAwaitable final
+{
+public:
+    BLAZE_API explicit FBlazePreloadAwaitable(TArray<FSoftObjectPath> InPaths);
+
+    UE_NONCOPYABLE(FBlazePreloadAwaitable);
+
+    bool await_ready() const { return Paths.IsEmpty(); }
+    BLAZE_API bool await_suspend(std::coroutine_handle<> InHandle);
+    BLAZE_API TSharedPtr<FStreamableHandle> await_resume() const;
+
+private:
+    TArray<FSoftObjectPath> Paths;
+
+    TSharedPtr<FStreamableHandle> LoadHandle;
+    std::coroutine_handle<> Handle;
+    bool bSuspending{ false };
+    bool bDone{ false };
+
+    void OnLoadFinished();
+};
+
+/**
+ * Awaitable that completes once the widget has been popped from its layer.
+ * The widget is considered popped once its layer releases it, whether or not it was displayed. A widget that is
+ * covered by another widget pushed on top of it remains on its layer, so the awaitable keeps waiting. The awaitable
+ * completes immediately if the widget is not valid, and when the widget is garbage collected while the coroutine is
+ * suspended.
+ *
+ * Note: A widget that is dehydrated by its layer is released by it and is also considered popped.
+ */
+class FBlazeWidgetPoppedAwaitable final
+{
+public:
+    BLAZE_API explicit FBlazeWidgetPoppedAwaitable(UCommonActivatableWidget* InWidget);
+
+    UE_NONCOPYABLE(FBlazeWidgetPoppedAwaitable);
+
+    bool await_ready() const { return !Widget.IsValid(); }
+    BLAZE_API void await_suspend(std::coroutine_handle<> InHandle);
+    void await_resume() const {}
+
+private:
+    TWeakObjectPtr<UCommonActivatableWidget> Widget{ nullptr };
+    FDelegateHandle ReleasedHandle;
+    FDelegateHandle GarbageCollectedHandle;
+    std::coroutine_handle<> Handle;
+
+    void OnWidgetPopped();
+    void OnPostGarbageCollect();
+};
+
+#endif
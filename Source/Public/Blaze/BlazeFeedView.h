@@ -0,0 +1,139 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Blaze/BlazePayloadReceiver.h"
+#include "Blueprint/UserWidget.h"
+#include "Containers/Ticker.h"
+#include "BlazeFeedView.generated.h"
+
+class UPanelWidget;
+
+/**
+ * @brief A widget that displays a long history of entries using a fixed set of recycled entry widgets.
+ *
+ * Chat logs, combat logs and match histories can accumulate hundreds of entries. Pushing a widget per entry makes
+ * the cost of the layer grow with the length of the history. A feed instead keeps each entry as its payload in a
+ * ring buffer and only creates NumVisibleEntries widgets of EntryWidgetClass. These widgets are reused to show
+ * whichever entries are in the visible window. Pushing an entry costs the same regardless of the length of the
+ * history, and the visible window is refreshed at most once per frame by delivering a copy of the payload of each
+ * visible entry to a recycled widget via IBlazePayloadReceiver::ReceivePayload. A widget that already displays
+ * the entry is not updated.
+ *
+ * Entry widgets are added to EntryPanel, from the oldest visible entry to the newest. If the widget tree does not
+ * bind EntryPanel, a vertical box is created as the root of the widget tree.
+ *
+ * Feeds are registered with a UBlazePrimaryLayout via RegisterFeedLayer and entries are pushed via
+ * UBlazePrimaryLayout::PushEntryToFeed or UBlazeFunctionLibrary::PushEntryToFeed.
+ */
+UCLASS(MinimalAPI)
+class UBlazeFeedView : public UUserWidget
+{
+    GENERATED_BODY()
+
+public:
+    BLAZE_API virtual void BeginDestroy() override;
+
+    /**
+     * Append an entry to the feed.
+     *
+     * If the feed is scrolled to the latest entry the visible window follows the new entry, otherwise the window
+     * stays on the entries that are currently displayed. The oldest entry is discarded once the feed holds
+     * MaxEntries entries.
+     *
+     * @param Payload The payload of the entry, which is delivered to an entry widget when the entry is visible.
+     */
+    BLAZE_API void PushEntry(FInstancedStruct&& Payload);
+
+    /** Discard every entry in the feed. */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API void ClearEntries();
+
+    /**
+     * Move the visible window towards older entries, or towards newer entries if Delta is negative.
+     *
+     * @param Delta The number of entries to move the visible window by.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API void ScrollBy(int32 Delta);
+
+    /** Move the visible window so that it ends at the latest entry and follows new entries. */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API void ScrollToLatest();
+
+    /** Return the number of entries held by the feed. */
+    UFUNCTION(BlueprintPure, Category = "Blaze")
+    BLAZE_API int32 GetNumEntries() const;
+
+    /** Return the number of entries between the end of the visible window and the latest entry. */
+    UFUNCTION(BlueprintPure, Category = "Blaze")
+    FORCEINLINE int32 GetScrollOffset() const { return ScrollOffset; }
+
+    /** Return the entry widgets that have been created, in the order they are displayed. */
+    FORCEINLINE const TArray<TObjectPtr<UUserWidget>>& GetEntryWidgets() const { return EntryWidgets; }
+
+    /** Update the entry widgets to display the visible window immediately rather than on the next frame. */
+    BLAZE_API void RefreshEntries();
+
+    /**
+     * Remove the entry widgets that are not displaying an entry, or every entry widget if the feed is not visible.
+     * The entry widgets are created again when they are next required.
+     *
+     * @return The number of entry widgets removed.
+     */
+    BLAZE_API int32 ReleaseUnusedEntryWidgets();
+
+protected:
+    BLAZE_API virtual void NativeOnInitialized() override;
+
+    /** The class of the widgets that display the entries. The class MUST implement IBlazePayloadReceiver. */
+    UPROPERTY(EditAnywhere, Category = "Blaze", meta = (MustImplement = "/Script/Blaze.BlazePayloadReceiver"))
+    TSubclassOf<UUserWidget> EntryWidgetClass{ nullptr };
+
+    /** The number of entries displayed at once, which is the number of entry widgets created. */
+    UPROPERTY(EditAnywhere, Category = "Blaze", meta = (ClampMin = 1, UIMin = 1))
+    int32 NumVisibleEntries{ 8 };
+
+    /** The number of entries retained. The oldest entry is discarded when an entry is pushed onto a full feed. */
+    UPROPERTY(EditAnywhere, Category = "Blaze", meta = (ClampMin = 1, UIMin = 1))
+    int32 MaxEntries{ 500 };
+
+private:
+    /** The panel that hosts the entry widgets. */
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UPanelWidget> EntryPanel{ nullptr };
+
+    /** The payloads of the retained entries. The entry with sequence number N is stored at N % MaxEntries. */
+    UPROPERTY(Transient)
+    TArray<FInstancedStruct> Entries;
+
+    /** The entry widgets, in the order they are displayed. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UUserWidget>> EntryWidgets;
+
+    /** The sequence number of the entry displayed by each entry widget, or INDEX_NONE if it displays no entry. */
+    TArray<int64> DisplayedSequences;
+
+    /** The number of entries pushed onto the feed since it was created or cleared. */
+    int64 NumPushed{ 0 };
+
+    /** The number of entries between the end of the visible window and the latest entry. */
+    int32 ScrollOffset{ 0 };
+
+    /** The handle of the ticker that refreshes the entry widgets on the frame after the feed changes. */
+    FTSTicker::FDelegateHandle RefreshTickerHandle;
+
+    /** Schedule a refresh of the entry widgets on the next frame if one is not already scheduled. */
+    void MarkEntriesDirty();
+};
@@ -13,14 +13,17 @@
  */
 #pragma once
 
+#include "Blaze/BlazePayloadReceiver.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UObject/SoftObjectPtr.h"
 #include "BlazeFunctionLibrary.generated.h"
 
 class APlayerController;
+struct FBlazeWidgetQuery;
 struct FGameplayTag;
 class UBlazePrimaryLayout;
 class UBlazePrimaryLayoutManager;
+class UBlazeViewModelStore;
 class UCommonActivatableWidget;
 class ULocalPlayer;
 template <typename T>
@@ -52,6 +55,35 @@ public:
      */
     static BLAZE_API UBlazePrimaryLayout* GetPrimaryLayout(const ULocalPlayer* LocalPlayer);
 
+    /**
+     * Retrieves the layout that hosts the specified layer for the local player.
+     *
+     * This is the shared layout if the layer is registered with the shared layout of the primary layout manager,
+     * otherwise it is the primary layout of the player.
+     *
+     * @param LocalPlayer The local player that is accessing the layer.
+     * @param LayerName The tag identifying the layer.
+     * @return A pointer to the layout hosting the layer, or nullptr if the player has no primary layout.
+     */
+    static BLAZE_API UBlazePrimaryLayout* GetLayoutForLayer(const ULocalPlayer* LocalPlayer, FGameplayTag LayerName);
+
+    /**
+     * Retrieves the view-model store of the player, creating it on first use.
+     *
+     * @param PlayerController The player controller representing the player.
+     * @return The view-model store, or nullptr if the player has no primary layout.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    static BLAZE_API UBlazeViewModelStore* GetViewModelStore(const APlayerController* PlayerController);
+
+    /**
+     * Retrieves the view-model store of the local player, creating it on first use.
+     *
+     * @param LocalPlayer The local player.
+     * @return The view-model store, or nullptr if the player has no primary layout.
+     */
+    static BLAZE_API UBlazeViewModelStore* GetViewModelStore(const ULocalPlayer* LocalPlayer);
+
     /**
      * Adds a widget to the specified UI layer synchronously.
      *
@@ -83,6 +115,107 @@ public:
                        const FGameplayTag LayerName,
                        const TSubclassOf<UCommonActivatableWidget> WidgetClass);
 
+    /**
+     * Adds a widget, initialized from the payload, to the specified UI layer synchronously.
+     *
+     * The payload is delivered to the widget via IBlazePayloadReceiver before the widget is added to the layer.
+     *
+     * @param PlayerController The player controller representing the player.
+     * @param LayerName The tag identifying the target layer to which the widget should be added.
+     * @param WidgetClass The class of the widget to be activated and added to the specified layer.
+     * @param Payload The payload delivered to the widget.
+     * @return A pointer to the added widget instance upon successful execution, or nullptr if the process fails.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    static BLAZE_API UCommonActivatableWidget*
+    PushContentToLayerWithPayload(APlayerController* PlayerController,
+                                  UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName,
+                                  UPARAM(meta = (AllowAbstract = false))
+                                      TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                  const FInstancedStruct& Payload);
+
+    /**
+     * Adds a widget, initialized from the payload, to the specified UI layer for the local player.
+     *
+     * @param LocalPlayer The local player.
+     * @param LayerName The tag identifying the target layer to which the widget should be added.
+     * @param WidgetClass The class of the widget to be activated and added to the specified layer.
+     * @param Payload The payload moved into the widget.
+     * @return A pointer to the added widget instance upon successful execution, or nullptr if the process fails.
+     */
+    static BLAZE_API UCommonActivatableWidget*
+    PushContentToLayerWithPayload(const ULocalPlayer* LocalPlayer,
+                                  const FGameplayTag LayerName,
+                                  const TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                  FInstancedStruct&& Payload);
+
+    /**
+     * Enqueues a widget, initialized from the payload, onto the specified UI layer.
+     *
+     * The widget is displayed once the layer has room under its queue settings. Until then the entry is held as
+     * data, and waiting entries with the same widget class and MergeKey are merged.
+     *
+     * @param PlayerController The player controller representing the player.
+     * @param LayerName The tag identifying the target layer to which the widget should be added.
+     * @param WidgetClass The class of the widget to be activated and added to the specified layer.
+     * @param Payload The payload delivered to the widget.
+     * @param Priority The priority of the entry. Entries with a higher priority are displayed first.
+     * @param MergeKey The key identifying entries that are merged while waiting, or None to never merge.
+     * @return true if the entry was displayed, held or merged.
+     * @see UBlazePrimaryLayout::EnqueueWidgetToLayer
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze", meta = (AdvancedDisplay = "Priority,MergeKey"))
+    static BLAZE_API bool EnqueueContentToLayer(APlayerController* PlayerController,
+                                                UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName,
+                                                UPARAM(meta = (AllowAbstract = false))
+                                                    TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                                const FInstancedStruct& Payload,
+                                                int32 Priority = 0,
+                                                FName MergeKey = NAME_None);
+
+    /**
+     * Enqueues a widget, initialized from the payload, onto the specified UI layer for the local player.
+     *
+     * @param LocalPlayer The local player.
+     * @param LayerName The tag identifying the target layer to which the widget should be added.
+     * @param WidgetClass The class of the widget to be activated and added to the specified layer.
+     * @param Payload The payload moved into the widget.
+     * @param Priority The priority of the entry. Entries with a higher priority are displayed first.
+     * @param MergeKey The key identifying entries that are merged while waiting, or None to never merge.
+     * @return true if the entry was displayed, held or merged.
+     */
+    static BLAZE_API bool EnqueueContentToLayer(const ULocalPlayer* LocalPlayer,
+                                                FGameplayTag LayerName,
+                                                TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                                FInstancedStruct&& Payload,
+                                                int32 Priority = 0,
+                                                FName MergeKey = NAME_None);
+
+    /**
+     * Appends an entry to the specified feed.
+     *
+     * @param PlayerController The player controller representing the player.
+     * @param LayerName The tag identifying the feed.
+     * @param Payload The payload of the entry.
+     * @return true if the entry was pushed.
+     * @see UBlazeFeedView
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    static BLAZE_API bool PushEntryToFeed(APlayerController* PlayerController,
+                                          UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName,
+                                          const FInstancedStruct& Payload);
+
+    /**
+     * Appends an entry to the specified feed for the local player.
+     *
+     * @param LocalPlayer The local player.
+     * @param LayerName The tag identifying the feed.
+     * @param Payload The payload of the entry, which is moved into the feed.
+     * @return true if the entry was pushed.
+     */
+    static BLAZE_API bool
+    PushEntryToFeed(const ULocalPlayer* LocalPlayer, FGameplayTag LayerName, FInstancedStruct&& Payload);
+
     /**
      * Removes a specified activatable widget from the specified UI layer it is currently displayed within.
      *
@@ -93,6 +226,59 @@ public:
     static BLAZE_API void PopContentFromLayer(const FGameplayTag LayerName,
                                               UCommonActivatableWidget* ActivatableWidget);
 
+    /**
+     * Removes every widget from the specified UI layer without activating the widgets below the displayed widget.
+     *
+     * @param PlayerController The player controller representing the player.
+     * @param LayerName The tag identifying the layer to clear.
+     * @return The number of widgets removed, or the number of entries discarded if the layer is a feed.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    static BLAZE_API int32 ClearLayer(APlayerController* PlayerController,
+                                      UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName);
+
+    /**
+     * Removes every widget from the specified UI layer for the local player.
+     *
+     * @param LocalPlayer The local player.
+     * @param LayerName The tag identifying the layer to clear.
+     * @return The number of widgets removed, or the number of entries discarded if the layer is a feed.
+     */
+    static BLAZE_API int32 ClearLayer(const ULocalPlayer* LocalPlayer, const FGameplayTag LayerName);
+
+    /**
+     * Removes every widget above the specified widget from the UI layer, leaving the specified widget on top.
+     * The intermediate widgets are removed without being activated.
+     *
+     * @param LayerName The tag identifying the layer that contains the widget.
+     * @param ActivatableWidget The widget that remains on the layer.
+     * @return The number of widgets removed.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    static BLAZE_API int32 PopUntil(UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName,
+                                    UCommonActivatableWidget* ActivatableWidget);
+
+    /**
+     * Removes every widget that matches the query from the player's UI layers.
+     * The widgets are removed without activating any intermediate widgets.
+     *
+     * @param PlayerController The player controller representing the player.
+     * @param Query The query used to select the widgets to remove.
+     * @return The number of widgets removed.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    static BLAZE_API int32 PopAll(APlayerController* PlayerController, const FBlazeWidgetQuery& Query);
+
+    /**
+     * Removes every widget that matches the query from the local player's UI layers.
+     * This includes the widgets on the layers of the shared layout that the player may remove.
+     *
+     * @param LocalPlayer The local player.
+     * @param Query The query used to select the widgets to remove.
+     * @return The number of widgets removed.
+     */
+    static BLAZE_API int32 PopAll(const ULocalPlayer* LocalPlayer, const FBlazeWidgetQuery& Query);
+
 private:
     /**
      * Retrieves the primary layout manager associated with the specified world context.
@@ -147,8 +333,18 @@ private:
      */
     static void ResumeInputForPlayer(const ULocalPlayer* LocalPlayer, FName SuspendToken);
 
+    /**
+     * Return true if input for the local player is suspended by a token created by SuspendInputForPlayer that has
+     * not yet been resumed. Input type filters set on the CommonInputSubsystem by other systems are ignored.
+     *
+     * @param LocalPlayer The local player to check.
+     * @return true if Blaze has suspended input for the local player.
+     */
+    static bool IsInputSuspendedForPlayer(const ULocalPlayer* LocalPlayer);
+
     static UBlazePrimaryLayoutManager* GetPrimaryLayoutManager(const UGameInstance* GameInstance);
 
     friend class UBlazePrimaryLayout;
     friend class UAsyncAction_CreateWidgetAsync;
+    friend class FBlazePushRequest;
 };
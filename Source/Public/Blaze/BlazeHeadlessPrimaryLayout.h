@@ -0,0 +1,38 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Blaze/BlazePrimaryLayout.h"
+#include "BlazeHeadlessPrimaryLayout.generated.h"
+
+struct FGameplayTagContainer;
+
+/**
+ * @brief A primary layout that never constructs UMG or Slate widgets.
+ *
+ * The layout is created by UBlazeHeadlessPrimaryLayoutManager when UBlazeSubsystem is configured to run headless,
+ * such as on bot clients driving load tests. Every layer is a headless layer that records the widgets pushed onto
+ * it as proxies, so game code that pushes and pops content keeps working while paying almost none of the cost.
+ *
+ * @see UBlazePrimaryLayout::RegisterHeadlessLayer
+ */
+UCLASS(MinimalAPI, NotBlueprintable, meta = (DisableNativeTick))
+class UBlazeHeadlessPrimaryLayout final : public UBlazePrimaryLayout
+{
+    GENERATED_BODY()
+
+public:
+    /** Register a headless layer for each of the tags that has not already been registered. */
+    BLAZE_API void RegisterHeadlessLayers(const FGameplayTagContainer& LayerTags);
+};
@@ -0,0 +1,32 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Blaze/BlazePrimaryLayoutManager.h"
+#include "BlazeHeadlessPrimaryLayoutManager.generated.h"
+
+/**
+ * @brief The layout manager used when UBlazeSubsystem is configured to run headless.
+ *
+ * The manager creates a UBlazeHeadlessPrimaryLayout for each player with a headless layer for every tag in the
+ * HeadlessLayers of the subsystem. The layouts are never added to the player's screen.
+ */
+UCLASS(MinimalAPI, NotBlueprintable)
+class UBlazeHeadlessPrimaryLayoutManager final : public UBlazePrimaryLayoutManager
+{
+    GENERATED_BODY()
+
+protected:
+    BLAZE_API virtual UBlazePrimaryLayout* CreatePrimaryLayout(APlayerController* PlayerController) override;
+};
@@ -0,0 +1,142 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "UObject/ObjectMacros.h"
+#include "BlazeLayerConfig.generated.h"
+
+/**
+ * The policy applied when a widget is pushed asynchronously onto a layer.
+ */
+UENUM(BlueprintType)
+enum class EBlazePushPolicy : uint8
+{
+    // Every request is honoured.
+    AllowAll,
+    // A request is dropped if a request for the same widget class is pending on the layer or was made within the
+    // duplicate window.
+    DropDuplicateClass,
+    // A request cancels every request for the layer that is still pending.
+    LatestWins
+};
+
+/**
+ * @struct FBlazeLayerConfig
+ * @brief The per-layer settings supplied when a layer is registered with a UBlazePrimaryLayout.
+ *
+ * The default values preserve the behaviour of a plain layer.
+ */
+USTRUCT(BlueprintType)
+struct FBlazeLayerConfig
+{
+    GENERATED_BODY()
+
+    /**
+     * The number of widgets directly below the top of the layer that are kept alive.
+     *
+     * Widgets that are deeper than this in the layer are dehydrated. A dehydrated widget is removed from the layer,
+     * releasing its Slate resources, and only its class and the state saved via IBlazeStatefulWidget are retained.
+     * Dehydrated widgets are recreated below the displayed widget once fewer than DehydrateDepth widgets remain
+     * below it, which requires a UBlazeActivatableWidgetStack container. Other stacks recreate them once navigation
+     * has removed every live widget. A value of 0 disables dehydration.
+     * Dehydration is only supported on layers that are UCommonActivatableWidgetStack containers.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze", meta = (ClampMin = 0, UIMin = 0))
+    int32 DehydrateDepth{ 0 };
+
+    /**
+     * The policy applied when a widget is pushed asynchronously onto the layer.
+     * Exclusive layers such as menus and modals typically use LatestWins so that repeated requests do not
+     * load and construct widgets that are immediately covered.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze")
+    EBlazePushPolicy PushPolicy{ EBlazePushPolicy::AllowAll };
+
+    /** The time in seconds after a request during which a request for the same widget class is dropped. */
+    UPROPERTY(EditAnywhere,
+              BlueprintReadWrite,
+              Category = "Blaze",
+              meta = (ClampMin = 0,
+                      UIMin = 0,
+                      Units = "s",
+                      EditCondition = "PushPolicy == EBlazePushPolicy::DropDuplicateClass"))
+    float DuplicateWindow{ 0.5f };
+
+    /**
+     * Whether the widget tree of each widget pushed onto the layer is placed in its own GC cluster.
+     *
+     * The garbage collector treats a cluster as a single object, so the widgets of a long-lived layer such as a HUD
+     * are not traversed individually on every reachability pass. The container pools the widgets popped from the
+     * layer for reuse, so a cluster is retained for as long as the layout lives, unless a UBlazeActivatableWidgetStack
+     * discards its pool under memory pressure. Objects in a cluster are not scanned for references, so this must
+     * only be enabled for layers whose widgets do not add child widgets or assign new objects (such as textures) to
+     * the widgets in their tree after they have been pushed. Widgets that receive payloads or host a feed, and
+     * widgets instanced from widget blueprints that have not been cooked, are never clustered. Clusters are only
+     * created when "gc.CreateGCClusters" and "Blaze.GC.ClusterWidgets" are enabled.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze", AdvancedDisplay)
+    bool bClusterWidgets{ false };
+
+    /**
+     * Whether the classes of the dehydrated widgets of the layer stay loaded when memory pressure is signalled.
+     *
+     * An unpinned class is released under memory pressure and loaded synchronously when the widget is recreated.
+     * Layers that must navigate back without a hitch, such as the front end menu, typically pin their classes.
+     * Only a UBlazeActivatableWidgetStack container releases classes, as other stacks pool the widgets they remove.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze", AdvancedDisplay)
+    bool bPinWidgetClasses{ false };
+
+    /**
+     * The duration in seconds of the transition played by the container when the displayed widget changes.
+     * The transition type and curve are those designed on the container. A value of 0 disables the transition.
+     */
+    UPROPERTY(EditAnywhere,
+              BlueprintReadWrite,
+              Category = "Blaze|Transition",
+              meta = (ClampMin = 0, UIMin = 0, Units = "s"))
+    float TransitionDuration{ 0.f };
+
+    /**
+     * Whether the transition is shortened or skipped while recent frames exceed "Blaze.Transition.FrameBudgetMs".
+     * Disable this for transitions that convey information, which must always play in full.
+     */
+    UPROPERTY(EditAnywhere,
+              BlueprintReadWrite,
+              Category = "Blaze|Transition",
+              meta = (EditCondition = "TransitionDuration > 0"))
+    bool bAdaptTransitionToFrameBudget{ true };
+
+    /**
+     * The maximum number of widgets present on the layer before widgets enqueued onto the layer are held back.
+     *
+     * Widgets enqueued via UBlazePrimaryLayout::EnqueueWidgetToLayer are kept as data, and no widget is constructed
+     * for them, until the layer has room. Notification layers such as kill feeds and pickup toasts typically set a
+     * small value so that a burst of events costs a bounded amount of UI work. A value of 0 places no limit.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze|Queue", meta = (ClampMin = 0, UIMin = 0))
+    int32 QueueMaxVisible{ 0 };
+
+    /** The maximum number of enqueued widgets displayed per second. A value of 0 places no limit. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze|Queue", meta = (ClampMin = 0, UIMin = 0))
+    float QueueDisplayRate{ 0.f };
+
+    /**
+     * The maximum number of enqueued widgets held back as data.
+     * When the limit is exceeded the entry with the lowest priority that was enqueued last is discarded.
+     * A value of 0 places no limit.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze|Queue", meta = (ClampMin = 0, UIMin = 0))
+    int32 QueueMaxEntries{ 0 };
+};
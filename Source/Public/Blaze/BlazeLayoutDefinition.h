@@ -0,0 +1,77 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Blaze/BlazeLayerConfig.h"
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "Templates/SubclassOf.h"
+#include "BlazeLayoutDefinition.generated.h"
+
+class UCommonActivatableWidgetContainerBase;
+
+/**
+ * A layer created by a UBlazePrimaryLayout from a UBlazeLayoutDefinition.
+ */
+USTRUCT(BlueprintType)
+struct FBlazeLayerDefinition
+{
+    GENERATED_BODY()
+
+    /** The name of the layer. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blaze", meta = (Categories = "UILayersCategory"))
+    FGameplayTag LayerTag;
+
+    /** The class of the container that hosts the widgets of the layer. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blaze", meta = (AllowAbstract = false))
+    TSubclassOf<UCommonActivatableWidgetContainerBase> ContainerClass;
+
+    /** The order in which the layer is stacked. Layers with a higher ZOrder are displayed above those below it. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blaze")
+    int32 ZOrder{ 0 };
+
+    /** The settings of the layer. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blaze")
+    FBlazeLayerConfig Config;
+};
+
+/**
+ * @brief A data asset that describes the layers of a primary layout.
+ *
+ * A layout that references a definition builds its layers natively when it is initialized. The layer table is sized
+ * once and the containers are created and registered in a single pass, rather than the Blueprint graph of every
+ * layout instance calling Register Layer for each layer. The definition is validated when it is saved and cooked.
+ *
+ * @see UBlazePrimaryLayout::LayoutDefinition
+ */
+UCLASS(MinimalAPI, BlueprintType, Const)
+class UBlazeLayoutDefinition final : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** Return the layers of the definition. */
+    FORCEINLINE const TArray<FBlazeLayerDefinition>& GetLayers() const { return Layers; }
+
+#if WITH_EDITOR
+    BLAZE_API virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+
+private:
+    /** The layers of the layout. */
+    UPROPERTY(EditDefaultsOnly, Category = "Blaze", meta = (TitleProperty = "LayerTag"))
+    TArray<FBlazeLayerDefinition> Layers;
+
+    friend class FBlazeTestWorld;
+};
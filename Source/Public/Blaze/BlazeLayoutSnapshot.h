@@ -0,0 +1,106 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "UObject/SoftObjectPtr.h"
+#include "BlazeLayoutSnapshot.generated.h"
+
+class UCommonActivatableWidget;
+
+/**
+ * @struct FBlazeWidgetSnapshot
+ * @brief The captured state of a single widget on a layer.
+ */
+USTRUCT(BlueprintType)
+struct FBlazeWidgetSnapshot
+{
+    GENERATED_BODY()
+
+    /** The class of the widget. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze")
+    TSoftClassPtr<UCommonActivatableWidget> WidgetClass{ nullptr };
+
+    /**
+     * The state saved by the widget if it implements IBlazeStatefulWidget, otherwise empty.
+     *
+     * @see IBlazeStatefulWidget
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze")
+    TArray<uint8> State;
+
+    friend FArchive& operator<<(FArchive& Ar, FBlazeWidgetSnapshot& Snapshot)
+    {
+        Ar << Snapshot.WidgetClass;
+        Ar << Snapshot.State;
+        return Ar;
+    }
+};
+
+/**
+ * @struct FBlazeLayerSnapshot
+ * @brief The captured state of a single layer.
+ */
+USTRUCT(BlueprintType)
+struct FBlazeLayerSnapshot
+{
+    GENERATED_BODY()
+
+    /** The layer that the widgets were present on. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze", meta = (Categories = "UILayersCategory"))
+    FGameplayTag LayerName{ FGameplayTag::EmptyTag };
+
+    /** The widgets present on the layer, ordered from the bottom of the layer to the top. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze")
+    TArray<FBlazeWidgetSnapshot> Widgets;
+
+    friend FArchive& operator<<(FArchive& Ar, FBlazeLayerSnapshot& Snapshot)
+    {
+        auto TagName = Snapshot.LayerName.GetTagName();
+        Ar << TagName;
+        if (Ar.IsLoading())
+        {
+            Snapshot.LayerName = FGameplayTag::RequestGameplayTag(TagName, false);
+        }
+        Ar << Snapshot.Widgets;
+        return Ar;
+    }
+};
+
+/**
+ * @struct FBlazeLayoutSnapshot
+ * @brief The captured state of every layer in a primary layout.
+ *
+ * A snapshot is captured via UBlazePrimaryLayout::CaptureSnapshot() and can be restored onto the same
+ * or a different layout via UBlazePrimaryLayout::RestoreSnapshot(). It can be saved using the
+ * archive operator to persist UI state across travel or reconnects.
+ */
+USTRUCT(BlueprintType)
+struct FBlazeLayoutSnapshot
+{
+    GENERATED_BODY()
+
+    /** The captured layers. Layers that had no widgets are omitted. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze")
+    TArray<FBlazeLayerSnapshot> Layers;
+
+    /** Return the total number of widgets across all layers. */
+    BLAZE_API int32 NumWidgets() const;
+
+    friend FArchive& operator<<(FArchive& Ar, FBlazeLayoutSnapshot& Snapshot)
+    {
+        Ar << Snapshot.Layers;
+        return Ar;
+    }
+};
@@ -0,0 +1,74 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "UObject/ObjectMacros.h"
+#include "BlazeMemoryReclaim.generated.h"
+
+/**
+ * The severity of a memory pressure signal, which determines how much Blaze releases in response.
+ * Each level also performs the responses of the levels below it.
+ */
+UENUM(BlueprintType)
+enum class EBlazeMemoryPressure : uint8
+{
+    // Release the widget classes and pooled widgets retained by UBlazeActivatableWidgetStack layers that do not pin
+    // their classes.
+    Low,
+    // Dehydrate every widget that is not displayed in a stack layer. UBlazeActivatableWidgetStack layers also
+    // discard their pooled widgets, while other stacks only release the Slate resources of the widgets.
+    Medium,
+    // Release the entry widgets that feeds are not using, and request a garbage collection after the next
+    // large widget is removed from a layer.
+    High
+};
+
+/**
+ * @struct FBlazeMemoryReclaim
+ * @brief A report of the resources that Blaze released in response to memory pressure.
+ */
+USTRUCT(BlueprintType)
+struct FBlazeMemoryReclaim
+{
+    GENERATED_BODY()
+
+    /**
+     * The number of references to widget classes held by dehydrated widgets that were released. Only
+     * UBlazeActivatableWidgetStack layers release classes, as other stacks retain the widgets they pooled.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Blaze")
+    int32 ReleasedWidgetClasses{ 0 };
+
+    /** The number of widgets that were dehydrated, releasing their Slate resources. */
+    UPROPERTY(BlueprintReadOnly, Category = "Blaze")
+    int32 DehydratedWidgets{ 0 };
+
+    /** The number of entry widgets that were removed from feeds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Blaze")
+    int32 ReleasedFeedWidgets{ 0 };
+
+    /** Return true if nothing was released. */
+    FORCEINLINE bool IsEmpty() const
+    {
+        return 0 == ReleasedWidgetClasses && 0 == DehydratedWidgets && 0 == ReleasedFeedWidgets;
+    }
+
+    FBlazeMemoryReclaim& operator+=(const FBlazeMemoryReclaim& Other)
+    {
+        ReleasedWidgetClasses += Other.ReleasedWidgetClasses;
+        DehydratedWidgets += Other.DehydratedWidgets;
+        ReleasedFeedWidgets += Other.ReleasedFeedWidgets;
+        return *this;
+    }
+};
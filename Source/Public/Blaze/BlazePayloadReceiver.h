@@ -0,0 +1,69 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/Interface.h"
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+    #include "InstancedStruct.h"
+#else
+    #include "StructUtils/InstancedStruct.h"
+#endif
+#include "BlazePayloadReceiver.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UBlazePayloadReceiver : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * @class IBlazePayloadReceiver
+ * @brief Interface implemented by widgets that are initialized from a payload when pushed onto a layer.
+ *
+ * A payload is supplied to the push variants that accept an FInstancedStruct, such as
+ * UBlazePrimaryLayout::PushWidgetToLayerWithPayload, and allows a widget to establish its state in a single native
+ * pass rather than via an initialization callback and property sets after construction.
+ */
+class IBlazePayloadReceiver
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Receive the payload supplied when the widget was pushed.
+     *
+     * This is invoked after the widget has been created and before it is added to the layer, so it precedes
+     * NativeConstruct and any initialization callback supplied with the push. It is not invoked when Blaze
+     * recreates a dehydrated widget, which restores its state via IBlazeStatefulWidget instead.
+     *
+     * @param Payload The payload, which has been moved into the call and may be moved from.
+     */
+    virtual void ReceivePayload(FInstancedStruct&& Payload) = 0;
+
+    /**
+     * Merge the payload of an entry enqueued with the same merge key into the payload of an entry that is waiting
+     * to be displayed, such as combining three "+5 ammo" notifications into a single "+15 ammo" notification.
+     *
+     * This is invoked on the class default object of the widget class, so it must not depend on instance state.
+     * The default implementation keeps the most recent payload.
+     *
+     * @param Payload The payload of the waiting entry, which is updated in place.
+     * @param Incoming The payload of the entry being enqueued, which has been moved into the call.
+     */
+    virtual void MergePayload(FInstancedStruct& Payload, FInstancedStruct&& Incoming) const
+    {
+        Payload = MoveTemp(Incoming);
+    }
+};
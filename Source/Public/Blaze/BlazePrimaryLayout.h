@@ -13,25 +13,176 @@
  */
 #pragma once
 
+#include "Blaze/BlazeLayerConfig.h"
+#include "Blaze/BlazeLayoutSnapshot.h"
+#include "Blaze/BlazeMemoryReclaim.h"
+#include "Blaze/BlazePayloadReceiver.h"
+#include "Blaze/BlazePushRequest.h"
+#include "Blaze/BlazeWidgetQuery.h"
 #include "CommonUserWidget.h"
+#include "Containers/Ticker.h"
 #include "GameplayTagContainer.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 #include "BlazePrimaryLayout.generated.h"
 
+class UBlazeFeedView;
+class UBlazeLayoutDefinition;
+class UBlazeViewModelStore;
 class UCommonActivatableWidget;
+class UOverlay;
 struct FStreamableHandle;
 
 /**
- * The state of the async operation to push a widget onto a Layer.
+ * A layer mutation that was requested while a layer transaction was open.
+ * The mutation is applied when the outermost transaction is committed.
  */
-enum class EBlazePushWidgetToLayerState : uint8
+USTRUCT()
+struct FBlazePendingLayerMutation
 {
-    // State when the widget push operation is canceled or the Widget Class failed to resolve.
-    Canceled,
-    // State after the widget has been initialized and before pushed onto the layer.
-    Initialize,
-    // State after the widget has been pushed onto the layer.
-    AfterPush
+    GENERATED_BODY()
+
+    /** The layer that the mutation targets. */
+    UPROPERTY(Transient)
+    FGameplayTag LayerName{ FGameplayTag::EmptyTag };
+
+    /** The widget that is pushed onto, or removed from, the layer. */
+    UPROPERTY(Transient)
+    TObjectPtr<UCommonActivatableWidget> Widget{ nullptr };
+
+    /** True if the widget is removed from the layer, false if it is pushed onto the layer. */
+    UPROPERTY(Transient)
+    bool bRemove{ false };
+
+    FBlazePendingLayerMutation() {}
+
+    FBlazePendingLayerMutation(const FGameplayTag& InLayerName,
+                               UCommonActivatableWidget* InWidget,
+                               const bool bInRemove)
+        : LayerName(InLayerName), Widget(InWidget), bRemove(bInRemove)
+    {
+    }
+};
+
+/**
+ * A widget that has been removed from a layer to release its resources and that is recreated when
+ * navigation returns to it.
+ */
+USTRUCT()
+struct FBlazeDehydratedWidget
+{
+    GENERATED_BODY()
+
+    /**
+     * The class of the widget. The class is retained so that recreating the widget never triggers a load, unless
+     * it is released in response to memory pressure.
+     */
+    UPROPERTY(Transient)
+    TSubclassOf<UCommonActivatableWidget> WidgetClass{ nullptr };
+
+    /** The path of the class, which is loaded to recreate the widget if WidgetClass was released. */
+    UPROPERTY(Transient)
+    TSoftClassPtr<UCommonActivatableWidget> WidgetClassPath{ nullptr };
+
+    /** The state saved by the widget via IBlazeStatefulWidget, if any. */
+    UPROPERTY(Transient)
+    TArray<uint8> State;
+};
+
+/**
+ * A widget enqueued onto a layer that is held as data until the layer has room to display it.
+ */
+USTRUCT()
+struct FBlazeQueuedEntry
+{
+    GENERATED_BODY()
+
+    /** The class of the widget that displays the entry. */
+    UPROPERTY(Transient)
+    TSubclassOf<UCommonActivatableWidget> WidgetClass{ nullptr };
+
+    /** The payload delivered to the widget when it is created. */
+    UPROPERTY(Transient)
+    FInstancedStruct Payload;
+
+    /** The priority of the entry. Entries with a higher priority are displayed first. */
+    UPROPERTY(Transient)
+    int32 Priority{ 0 };
+
+    /** The key that identifies entries which are merged while waiting, or None if the entry is never merged. */
+    UPROPERTY(Transient)
+    FName MergeKey{ NAME_None };
+};
+
+/**
+ * A layer registered with a primary layout.
+ */
+USTRUCT()
+struct FBlazeLayer
+{
+    GENERATED_BODY()
+
+    /** The container that hosts the widgets of the layer, or null if the layer is headless. */
+    UPROPERTY(Transient)
+    TObjectPtr<UCommonActivatableWidgetContainerBase> Container{ nullptr };
+
+    /** The proxy widgets of a headless layer, ordered from bottom to top. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UCommonActivatableWidget>> HeadlessWidgets;
+
+    /** The settings supplied when the layer was registered. */
+    UPROPERTY(Transient)
+    FBlazeLayerConfig Config;
+
+    /** The dehydrated widgets of the layer, ordered from bottom to top. They sit below every widget in Container. */
+    UPROPERTY(Transient)
+    TArray<FBlazeDehydratedWidget> DehydratedWidgets;
+
+    /** The widget class of the most recent async push onto the layer. Used to apply the push policy. */
+    UPROPERTY(Transient)
+    FSoftObjectPath LastPushWidgetClass;
+
+    /** The time at which the most recent async push onto the layer was requested. */
+    double LastPushTime{ 0.0 };
+
+    /** The entries enqueued onto the layer that are waiting to be displayed, ordered by descending priority. */
+    UPROPERTY(Transient)
+    TArray<FBlazeQueuedEntry> QueuedEntries;
+
+    /** The earliest time at which the next enqueued entry may be displayed. */
+    double NextQueueDisplayTime{ 0.0 };
+
+    /** The name of the CSV profiler stat that records the number of widgets in the layer. */
+    FName CsvStatName{ NAME_None };
+
+    /** Return true if the layer records its widgets rather than hosting them in a container. */
+    FORCEINLINE bool IsHeadless() const { return nullptr == Container; }
+
+    /** Append the widgets of the layer to OutWidgets, ordered from bottom to top. */
+    void GetWidgets(TArray<UCommonActivatableWidget*>& OutWidgets) const;
+
+    /** Return the widget that is displayed by the layer. The top widget is displayed by a headless layer. */
+    UCommonActivatableWidget* GetActiveWidget() const;
+
+    /** Return the number of widgets in Container, or in HeadlessWidgets if the layer is headless. */
+    int32 GetNumWidgets() const;
+
+    /** Return true if the widget is on the layer. */
+    bool ContainsWidget(const UCommonActivatableWidget& Widget) const;
+
+    /** Set the transition duration of the container for a change of the displayed widget given recent frame times. */
+    void ApplyTransitionBudget() const;
+
+    /**
+     * Set the transition duration of the container for the next change of the displayed widget, without recording a
+     * transition. This applies the budget to changes made by CommonUI, such as by the back handler.
+     */
+    void RefreshTransitionBudget() const;
+
+    /** Add the widget to the top of Container, or append it to HeadlessWidgets if the layer is headless. */
+    void AddWidgetInstance(UCommonActivatableWidget& Widget);
+
+    /** Remove the widget from Container, or from HeadlessWidgets if the layer is headless, and release it. */
+    void RemoveWidget(UCommonActivatableWidget& Widget);
 };
 
 /**
@@ -65,12 +216,84 @@ class UBlazePrimaryLayout : public UCommonUserWidget
 public:
     BLAZE_API explicit UBlazePrimaryLayout(const FObjectInitializer& ObjectInitializer);
 
+    BLAZE_API virtual void BeginDestroy() override;
+
     template <typename T = UCommonActivatableWidget>
-    TSharedPtr<FStreamableHandle> PushWidgetToLayerAsync(
+    FBlazePushRequest PushWidgetToLayerAsync(
         const FGameplayTag LayerName,
         const bool bSuspendInputUntilComplete,
         const TSoftClassPtr<UCommonActivatableWidget> WidgetClass,
-        const TFunction<void(EBlazePushWidgetToLayerState, T*)> CallbackFunc = [](auto, auto) {});
+        const TFunction<void(EBlazePushWidgetToLayerState, T*)> CallbackFunc = [](auto, auto) {},
+        const bool bRevealWhenResident = false);
+
+    /**
+     * Asynchronously load the widget class and push an instance of it onto the specified layer.
+     *
+     * The request does not allocate a UObject so this is the preferred entry point for native code.
+     *
+     * @param LayerName The name of the layer onto which the widget will be pushed.
+     * @param bSuspendInputUntilComplete Determines whether player input is suspended until the operation completes.
+     * @param WidgetClass The soft class pointer to the activatable widget to be added to the layer.
+     * @param Delegate The delegate invoked as the request progresses through initialization, completion or
+     * cancellation.
+     * @param bRevealWhenResident Determines whether the pushed widget remains collapsed until the textures it
+     * references have streamed in, trading a little latency for no visible pop-in of low resolution mips.
+     * @return The handle to the request, or an empty handle if the load could not be started. The delegate has been
+     * invoked with the canceled state in the latter case.
+     */
+    BLAZE_API FBlazePushRequest PushWidgetToLayerAsync(const FGameplayTag& LayerName,
+                                                       bool bSuspendInputUntilComplete,
+                                                       const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass,
+                                                       FBlazePushRequestDelegate Delegate,
+                                                       bool bRevealWhenResident = false);
+
+    /**
+     * Asynchronously load the widget class and push an instance of it, initialized from the payload, onto the
+     * specified layer.
+     *
+     * The payload is held by the request while the widget class loads and is moved into the widget via
+     * IBlazePayloadReceiver::ReceivePayload before the delegate is invoked with the Initialize state. Objects
+     * referenced by the payload are kept alive while the request is pending.
+     *
+     * @param LayerName The name of the layer onto which the widget will be pushed.
+     * @param bSuspendInputUntilComplete Determines whether player input is suspended until the operation completes.
+     * @param WidgetClass The soft class pointer to the activatable widget to be added to the layer.
+     * @param Payload The payload delivered to the widget.
+     * @param Delegate The delegate invoked as the request progresses through initialization, completion or
+     * cancellation.
+     * @param bRevealWhenResident Determines whether the pushed widget remains collapsed until the textures it
+     * references have streamed in.
+     * @return The handle to the request, or an empty handle if the load could not be started.
+     */
+    BLAZE_API FBlazePushRequest
+    PushWidgetToLayerAsyncWithPayload(const FGameplayTag& LayerName,
+                                      bool bSuspendInputUntilComplete,
+                                      const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass,
+                                      FInstancedStruct&& Payload,
+                                      FBlazePushRequestDelegate Delegate,
+                                      bool bRevealWhenResident = false);
+
+    /**
+     * Cancel every pending async push onto the specified layer.
+     * Input suspended by the canceled requests is resumed immediately.
+     *
+     * @param LayerName The gameplay tag identifying the desired UI layer.
+     * @return The number of requests canceled.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API int32 CancelPushRequests(UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName);
+
+    /**
+     * Cancel every pending async push onto any layer of the layout.
+     * Input suspended by the canceled requests is resumed immediately.
+     *
+     * @return The number of requests canceled.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API int32 CancelAllPushRequests();
+
+    /** Return the number of async pushes onto the layout that have not yet completed or been canceled. */
+    FORCEINLINE int32 GetNumPendingPushRequests() const { return PendingPushRequests.Num(); }
 
     template <typename T = UCommonActivatableWidget>
     T* PushWidgetToLayer(
@@ -78,21 +301,236 @@ public:
         const UClass* WidgetClass,
         const TFunctionRef<void(T&)> InitInstanceFunc = [](auto&) {});
 
+    /**
+     * Push a widget of the specified class, initialized from the payload, onto the layer.
+     *
+     * The payload is moved into the widget via IBlazePayloadReceiver::ReceivePayload after the widget is created and
+     * before it is added to the layer, and so before NativeConstruct. The payload is discarded with a warning if the
+     * widget does not implement IBlazePayloadReceiver.
+     *
+     * @param LayerName The gameplay tag identifying the desired UI layer.
+     * @param WidgetClass The class of the widget to create.
+     * @param Payload The payload delivered to the widget.
+     * @param InitInstanceFunc The function invoked to initialize the widget after the payload is delivered.
+     * @return The widget instance or nullptr if the layer is not registered or the WidgetClass is null.
+     */
+    BLAZE_API UCommonActivatableWidget* PushWidgetToLayerWithPayload(
+        const FGameplayTag& LayerName,
+        const UClass* WidgetClass,
+        FInstancedStruct&& Payload,
+        TFunctionRef<void(UCommonActivatableWidget&)> InitInstanceFunc = [](auto&) {});
+
+    /**
+     * Enqueue a widget of the specified class, initialized from the payload, onto the layer.
+     *
+     * The widget is pushed immediately if the layer has room, as defined by the QueueMaxVisible and
+     * QueueDisplayRate settings of the layer. Otherwise the entry is held as data, without constructing a widget,
+     * and is pushed once a widget is removed from the layer and the display rate allows. Waiting entries are
+     * displayed in order of descending priority and then in the order they were enqueued. An entry with the same
+     * widget class and a MergeKey other than None as a waiting entry is merged into it via
+     * IBlazePayloadReceiver::MergePayload rather than displayed separately.
+     *
+     * @param LayerName The gameplay tag identifying the desired UI layer.
+     * @param WidgetClass The class of the widget to create.
+     * @param Payload The payload delivered to the widget.
+     * @param Priority The priority of the entry.
+     * @param MergeKey The key identifying entries that are merged while waiting.
+     * @return true if the entry was pushed, held or merged, false if the layer is not registered or the
+     * WidgetClass is null.
+     */
+    BLAZE_API bool EnqueueWidgetToLayer(const FGameplayTag& LayerName,
+                                        TSubclassOf<UCommonActivatableWidget> WidgetClass,
+                                        FInstancedStruct&& Payload,
+                                        int32 Priority = 0,
+                                        FName MergeKey = NAME_None);
+
+    /** Return the number of entries enqueued onto the specified layer that are waiting to be displayed. */
+    BLAZE_API int32 GetNumQueuedEntries(const FGameplayTag& LayerName) const;
+
     /**
      * Finds a widget in the specified layer by its gameplay tag and removes it if it exists.
      *
+     * If a layer transaction is open, the removal is deferred until the transaction is committed.
+     *
      * @param LayerName The gameplay tag identifying the desired UI layer.
      * @param ActivatableWidget The widget to remove from the specified layer.
      */
-    BLAZE_API void RemoveWidgetFromLayer(const FGameplayTag LayerName,
-                                         UCommonActivatableWidget* ActivatableWidget) const;
+    BLAZE_API void RemoveWidgetFromLayer(const FGameplayTag LayerName, UCommonActivatableWidget* ActivatableWidget);
+
+    /**
+     * Remove every widget from the specified layer.
+     *
+     * The widgets are removed within a single layer transaction so that none of the widgets below the
+     * displayed widget are activated while the layer is being cleared.
+     *
+     * Any pending async push onto the layer is canceled and any enqueued entry waiting to be displayed is
+     * discarded. If the layer is a feed, every entry of the feed is discarded.
+     *
+     * @param LayerName The gameplay tag identifying the desired UI layer.
+     * @return The number of widgets removed, or the number of entries discarded if the layer is a feed.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API int32 ClearLayer(UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName);
+
+    /**
+     * Remove every widget above the specified widget from the layer, leaving the specified widget on top.
+     *
+     * The widgets are removed within a single layer transaction so that only the specified widget is activated.
+     *
+     * @param LayerName The gameplay tag identifying the desired UI layer.
+     * @param ActivatableWidget The widget that remains on the layer.
+     * @return The number of widgets removed, or 0 if the widget is not present on the layer.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API int32 PopUntil(UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerName,
+                             UCommonActivatableWidget* ActivatableWidget);
+
+    /**
+     * Remove every widget that matches the query from the layers of the layout.
+     *
+     * The widgets are removed within a single layer transaction so that intermediate widgets are not activated.
+     *
+     * @param Query The query used to select the widgets to remove.
+     * @return The number of widgets removed.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API int32 PopAll(const FBlazeWidgetQuery& Query);
+
+    /**
+     * Remove every widget that matches the predicate from the layers of the layout.
+     *
+     * @param Predicate The function invoked with each layer and widget that returns true if the widget is removed.
+     * @return The number of widgets removed.
+     */
+    BLAZE_API int32 PopAll(TFunctionRef<bool(const FGameplayTag&, UCommonActivatableWidget&)> Predicate);
+
+    /**
+     * Collect the widgets on the specified layer from bottom to top, including widgets that are pending
+     * addition within the current layer transaction and excluding those that are pending removal.
+     *
+     * @param LayerName The gameplay tag identifying the desired UI layer.
+     * @param OutWidgets The array that the widgets are appended to.
+     */
+    BLAZE_API void GetLayerWidgets(const FGameplayTag& LayerName,
+                                   TArray<UCommonActivatableWidget*>& OutWidgets) const;
+
+    /**
+     * Open a layer transaction.
+     *
+     * While a transaction is open, widgets pushed onto layers are constructed and initialized immediately but
+     * are not added to their layer, and widgets removed from layers stay in place. The recorded mutations are
+     * applied together when the outermost transaction is committed, so a large transition settles in a single
+     * pass rather than activating, focusing and re-evaluating input configuration for every intermediate state.
+     *
+     * Transactions may be nested. Every call MUST be paired with a call to CommitLayerTransaction().
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API void BeginLayerTransaction();
+
+    /**
+     * Close a layer transaction opened by BeginLayerTransaction().
+     *
+     * When the outermost transaction is committed, the recorded mutations are applied per layer in an order that
+     * avoids activating intermediate widgets. Widgets below the displayed widget are removed first, then the pushed
+     * widgets are added and finally the previously displayed widgets are removed. A widget that is both pushed and
+     * removed within the same transaction is never added to the layer. When several widgets are pushed onto a
+     * UBlazeActivatableWidgetStack layer, only the last is activated and the others are inserted below it. A plain
+     * stack activates each pushed widget in turn as it is added.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API void CommitLayerTransaction();
+
+    /** Return true if a layer transaction is currently open. */
+    FORCEINLINE bool IsInLayerTransaction() const { return LayerTransactionDepth > 0; }
+
+    /**
+     * Capture the widget classes present on every layer, in order, along with the state of any widget
+     * that implements IBlazeStatefulWidget.
+     *
+     * @return The captured snapshot.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API FBlazeLayoutSnapshot CaptureSnapshot() const;
+
+    /**
+     * Restore a snapshot previously captured via CaptureSnapshot().
+     *
+     * The widget classes for the entire snapshot and the assets they reference are loaded in a single request, once
+     * the dependency closure of every class is known. The widgets are then constructed over as many frames as
+     * required to stay within the "Blaze.Restore.FrameBudgetMs" budget, and finally every layer in the snapshot is
+     * replaced with the restored widgets in a single layer transaction. Input for the owning player is suspended
+     * while the restore is in progress.
+     *
+     * Starting a restore cancels any restore that is already in progress, as does removing the layout from the screen.
+     *
+     * @param Snapshot The snapshot to restore.
+     * @param OnComplete The function invoked when the restore completes or is canceled, with true on success.
+     */
+    BLAZE_API void RestoreSnapshot(const FBlazeLayoutSnapshot& Snapshot,
+                                   TFunction<void(bool bSuccess)> OnComplete = nullptr);
+
+    /** Cancel the restore that is in progress, if any. Layers are left unchanged. */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API void CancelRestoreSnapshot();
+
+    /** Return true if a snapshot restore is in progress. */
+    FORCEINLINE bool IsRestoringSnapshot() const { return bRestoringSnapshot; }
+
+    /** Restore a snapshot previously captured via CaptureSnapshot(). */
+    UFUNCTION(DisplayName = "Restore Snapshot", BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    void BP_RestoreSnapshot(const FBlazeLayoutSnapshot& Snapshot);
+
+    /** Return true if a layer, either hosted by a container, headless or a feed, is registered with the name. */
+    FORCEINLINE bool HasLayer(const FGameplayTag LayerName) const
+    {
+        return Layers.Contains(LayerName) || Feeds.Contains(LayerName);
+    }
+
+    /**
+     * Append an entry to the feed registered with the specified name.
+     *
+     * The entry is kept as its payload and displayed by one of the recycled entry widgets of the feed, so the cost
+     * of the push does not depend on the number of entries in the feed.
+     *
+     * @param LayerName The gameplay tag identifying the feed.
+     * @param Payload The payload of the entry.
+     * @return true if the entry was pushed, false if no feed is registered with the name.
+     */
+    BLAZE_API bool PushEntryToFeed(const FGameplayTag& LayerName, FInstancedStruct&& Payload);
+
+    /** Return the feed registered with the specified name, or nullptr if there is none. */
+    BLAZE_API UBlazeFeedView* GetFeed(FGameplayTag LayerName) const;
+
+    /**
+     * Return the view-model store of the player that owns the layout, creating it on first use.
+     *
+     * @see UBlazeViewModelStore
+     */
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Blaze")
+    BLAZE_API UBlazeViewModelStore* GetViewModelStore();
+
+    /**
+     * Release resources held by the layout in response to memory pressure.
+     *
+     * At every level the classes retained by the dehydrated widgets of UBlazeActivatableWidgetStack layers that do
+     * not set bPinWidgetClasses are released, along with the widgets that those stacks pool for reuse. At Medium
+     * pressure every widget in a stack layer that is not displayed is also dehydrated, whatever the DehydrateDepth
+     * of the layer, and every UBlazeActivatableWidgetStack discards its pooled widgets. A plain stack keeps the
+     * widgets it dehydrates pooled, so only their Slate resources are released. At High pressure the entry widgets
+     * that feeds are not using are also released. This is invoked for every layout when the platform signals memory
+     * pressure.
+     *
+     * @param Pressure The severity of the pressure.
+     * @return The resources that were released.
+     */
+    BLAZE_API FBlazeMemoryReclaim ReclaimMemory(EBlazeMemoryPressure Pressure);
 
     /**
      * Retrieves the widget container associated with the specified gameplay layer.
      *
      * @param LayerName The gameplay tag identifying the desired layer.
      * @return A pointer to the widget container corresponding to the provided layer name, or nullptr if no match is
-     * found.
+     * found or the layer is headless.
      */
     BLAZE_API UCommonActivatableWidgetContainerBase* GetLayer(const FGameplayTag LayerName) const;
 
@@ -112,58 +550,266 @@ public:
     }
 
 protected:
+    BLAZE_API virtual void NativeOnInitialized() override;
+    BLAZE_API virtual void NativeDestruct() override;
+
+    /**
+     * The definition of the layers that the layout builds when it is initialized.
+     *
+     * The layers are built natively, before the OnInitialized event, so a layout that uses a definition does not
+     * need to register its layers from its Blueprint graph. The containers are added to LayerOverlay in ascending
+     * ZOrder. Layers may still be registered via Register Layer in addition to those in the definition.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Blaze")
+    TObjectPtr<UBlazeLayoutDefinition> LayoutDefinition{ nullptr };
+
+    /**
+     * The overlay that hosts the containers of the layers built from LayoutDefinition.
+     * If the widget tree does not bind LayerOverlay and has no root, an overlay is created as the root.
+     */
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UOverlay> LayerOverlay{ nullptr };
+
     /** Register a layer that widgets can be pushed onto. */
-    UFUNCTION(DisplayName = "Register Layer", BlueprintCallable, Category = "Blaze")
+    UFUNCTION(DisplayName = "Register Layer",
+              BlueprintCallable,
+              Category = "Blaze",
+              meta = (AutoCreateRefTerm = "Config", AdvancedDisplay = "Config"))
     void BP_RegisterLayer(UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerTag,
-                          UCommonActivatableWidgetContainerBase* LayerWidget);
+                          UCommonActivatableWidgetContainerBase* LayerWidget,
+                          const FBlazeLayerConfig& Config);
 
     /** Register a layer that widgets can be pushed onto. */
-    BLAZE_API void RegisterLayer(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget);
+    BLAZE_API void RegisterLayer(FGameplayTag LayerTag,
+                                 UCommonActivatableWidgetContainerBase* LayerWidget,
+                                 const FBlazeLayerConfig& Config = FBlazeLayerConfig());
+
+    /**
+     * Register a headless layer that widgets can be pushed onto.
+     *
+     * A headless layer has no container. It records the widgets pushed onto it as a stack of proxies, which are
+     * instances of the requested widget class that are never initialized, so no widget tree or Slate widget is
+     * constructed for them. Proxies are not activated. Removing a proxy broadcasts its OnSlateReleased event so
+     * that code waiting for the widget to be popped continues to work. Headless layers never dehydrate widgets
+     * and GetLayer() returns nullptr for them.
+     */
+    BLAZE_API void RegisterHeadlessLayer(FGameplayTag LayerTag, const FBlazeLayerConfig& Config = FBlazeLayerConfig());
+
+    /** Register a feed that entries can be pushed onto. */
+    UFUNCTION(DisplayName = "Register Feed Layer", BlueprintCallable, Category = "Blaze")
+    void BP_RegisterFeedLayer(UPARAM(meta = (Categories = "UILayersCategory")) FGameplayTag LayerTag,
+                              UBlazeFeedView* FeedWidget);
+
+    /**
+     * Register a feed that entries can be pushed onto.
+     *
+     * A feed is a layer for high-cardinality content such as chat and combat logs. Entries pushed onto it are
+     * held as data and displayed by a fixed set of recycled widgets rather than each constructing a widget.
+     * Widgets cannot be pushed onto a feed and a feed cannot share its name with another layer.
+     *
+     * @see UBlazeFeedView
+     */
+    BLAZE_API void RegisterFeedLayer(FGameplayTag LayerTag, UBlazeFeedView* FeedWidget);
+
+    /**
+     * Construct widgets of the snapshot being restored until the frame budget is exhausted.
+     *
+     * @return true if widgets remain to be constructed on a later frame.
+     */
+    BLAZE_API bool TickRestoreSnapshot(float DeltaTime);
+
+    /**
+     * Display the waiting entries of every layer that fit within the QueueMaxVisible and QueueDisplayRate settings.
+     *
+     * The ticker that invokes this is only registered while entries are waiting and is removed once none remain.
+     *
+     * @return true if entries remain waiting for a later frame.
+     */
+    BLAZE_API bool TickQueuedEntries(float DeltaTime);
 
 private:
     /**
      * A mapping that records registered layers for the primary layout.
-     * Layers are identified by a `FGameplayTag` and represented by a `UCommonActivatableWidgetContainerBase` object.
+     * Layers are identified by a `FGameplayTag` and hosted by a `UCommonActivatableWidgetContainerBase` object.
      */
     UPROPERTY(Transient, meta = (Categories = "UILayersCategory"))
-    TMap<FGameplayTag, TObjectPtr<UCommonActivatableWidgetContainerBase>> Layers;
+    TMap<FGameplayTag, FBlazeLayer> Layers;
+
+    /** The feeds registered for the primary layout. */
+    UPROPERTY(Transient, meta = (Categories = "UILayersCategory"))
+    TMap<FGameplayTag, TObjectPtr<UBlazeFeedView>> Feeds;
+
+    /** Create and register the layers described by the definition. */
+    void BuildLayers(const UBlazeLayoutDefinition& Definition);
+
+    /** The view-model store of the player, created on first use. */
+    UPROPERTY(Transient)
+    TObjectPtr<UBlazeViewModelStore> ViewModelStore{ nullptr };
+
+    /** The number of nested layer transactions that are currently open. */
+    int32 LayerTransactionDepth{ 0 };
+
+    /** The mutations recorded while a layer transaction is open, in the order they were requested. */
+    UPROPERTY(Transient)
+    TArray<FBlazePendingLayerMutation> PendingLayerMutations;
 
     /**
-     * Asynchronously pushes a widget onto a specified layer stack and manages input suspension if needed.
+     * Push a widget of the specified class onto the layer, or record the push if a layer transaction is open.
      *
-     * @param LayerName The name of the layer onto which the widget will be pushed.
-     * @param bSuspendInputUntilComplete Determines whether player input is suspended until the operation completes.
-     * @param WidgetClass The soft class pointer to the activatable widget to be added to the layer stack.
-     * @param CallbackFunc Callback function that provides the state of the async operation and a reference to the
-     * widget. The state indicates various stages such as initialization, completion, or cancellation.
-     * @return A shared pointer to the streamable handle managing the asset loading process tied to the async operation.
+     * @param LayerName The gameplay tag identifying the desired UI layer.
+     * @param WidgetClass The class of the widget to create.
+     * @param InitInstanceFunc The function invoked to initialize the widget before it is added to the layer.
+     * @return The widget instance or nullptr if the layer is not registered or the WidgetClass is null.
      */
-    BLAZE_API TSharedPtr<FStreamableHandle> PushWidgetToLayerStackAsync_Internal(
-        const FGameplayTag& LayerName,
-        bool bSuspendInputUntilComplete,
-        const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass,
-        TFunction<void(EBlazePushWidgetToLayerState, UCommonActivatableWidget*)> CallbackFunc);
-
-    void OnCancel(TWeakObjectPtr<UBlazePrimaryLayout> Self,
-                  TWeakObjectPtr<APlayerController> WeakPlayer,
-                  const TFunction<void(EBlazePushWidgetToLayerState, UCommonActivatableWidget*)>& CallbackFunc,
-                  FName SuspendInputToken);
+    BLAZE_API UCommonActivatableWidget*
+    PushWidgetToLayer_Internal(const FGameplayTag& LayerName,
+                               const UClass* WidgetClass,
+                               TFunctionRef<void(UCommonActivatableWidget&)> InitInstanceFunc);
+
+    friend class FBlazePushRequest;
+    friend class UBlazePrimaryLayoutManager;
+
+    /** Record the number of widgets in each layer into the CSV profiler. */
+    void RecordCsvStats() const;
+
+    /** The async pushes onto the layout that have not yet completed or been canceled. */
+    TArray<FBlazePushRequest> PendingPushRequests;
+
+    /** Invoked by a request started by the layout when it completes or is canceled. */
+    void OnPushRequestFinished(const FBlazePushRequest& Request);
+
+    /** Cancel the pending async pushes onto the specified layer, or onto every layer if LayerName is not valid. */
+    int32 CancelPushRequests_Internal(const FGameplayTag& LayerName);
+
+    /**
+     * Apply the push policy of the layer to an async push request.
+     *
+     * @return false if the request should be dropped.
+     */
+    bool ApplyPushPolicy(const FGameplayTag& LayerName, const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass);
+
+    /** True while the mutations of a committed layer transaction are being applied. */
+    bool bApplyingLayerMutations{ false };
+
+    /** Apply the mutations recorded during the layer transaction that was just committed. */
+    void ApplyPendingLayerMutations();
+
+    /**
+     * Dehydrate the widgets that are more than Depth entries below the top of the layer.
+     *
+     * @param Layer The layer to dehydrate.
+     * @param Depth The number of widgets directly below the top of the layer that are kept alive.
+     * @return The number of widgets dehydrated.
+     */
+    int32 DehydrateLayer(FBlazeLayer& Layer, int32 Depth);
+
+    /**
+     * Recreate dehydrated widgets once fewer than DehydrateDepth widgets remain below the displayed widget.
+     *
+     * Widgets are recreated below the live widgets of a UBlazeActivatableWidgetStack. Other stacks can only add
+     * widgets to the top, so their dehydrated widgets are recreated once the layer has no live widgets.
+     */
+    void RehydrateLayer(const FGameplayTag& LayerName, FBlazeLayer& Layer);
+
+    /** Recreate the dehydrated widget below any live widgets of the layer. */
+    void RehydrateWidget(const FGameplayTag& LayerName, FBlazeLayer& Layer, const FBlazeDehydratedWidget& Record);
+
+    /** Invoked when the displayed widget of a layer that supports dehydration or adapts its transition changes. */
+    void OnLayerDisplayedWidgetChanged(UCommonActivatableWidget* Widget, FGameplayTag LayerName);
+
+    /** True while a snapshot restore is in progress. */
+    bool bRestoringSnapshot{ false };
+
+    /** The snapshot being restored. */
+    FBlazeLayoutSnapshot RestoringSnapshot;
+
+    /** The index of the next layer in RestoringSnapshot to construct widgets for. */
+    int32 RestoreLayerIndex{ 0 };
+
+    /** The index of the next widget in the current layer of RestoringSnapshot to construct. */
+    int32 RestoreWidgetIndex{ 0 };
+
+    /** The widgets constructed so far while restoring a snapshot. */
+    UPROPERTY(Transient)
+    TArray<FBlazePendingLayerMutation> RestoredWidgets;
+
+    /**
+     * The handle that loads the widget classes of the snapshot being restored.
+     * It is retained until the restore finishes so that the classes are not released mid-restore.
+     */
+    TSharedPtr<FStreamableHandle> RestoreHandle;
+
+    /** The union of the dependency closures of the widget classes of the snapshot being restored. */
+    TSet<FSoftObjectPath> RestoreLoadPaths;
+
+    /** The number of dependency closures of the snapshot being restored that have not been computed. */
+    int32 RestorePendingClosures{ 0 };
+
+    /** Incremented by each restore so that a closure computed for an earlier restore is ignored. */
+    uint32 RestoreSerial{ 0 };
+
+    /** The handle of the ticker that constructs the widgets of the snapshot being restored. */
+    FTSTicker::FDelegateHandle RestoreTickerHandle;
+
+    /** The player whose input was suspended while restoring the snapshot. */
+    TWeakObjectPtr<APlayerController> RestoreSuspendedPlayer;
+
+    /** The token identifying the input suspension while restoring the snapshot. */
+    FName RestoreSuspendInputToken{ NAME_None };
+
+    /** The function to invoke when the restore completes or is canceled. */
+    TFunction<void(bool)> OnRestoreComplete;
+
+    /** Load the widget classes of the snapshot and their dependencies in a single request. */
+    void BeginRestoreSnapshotLoad();
+
+    /** Start constructing the widgets of the snapshot once the widget classes have loaded. */
+    void OnRestoreSnapshotLoaded();
+
+    /** Release the resources of the restore and invoke the completion callback. */
+    void FinishRestoreSnapshot(bool bSuccess);
+
+    /** The handle of the ticker that displays entries waiting on queue layers. */
+    FTSTicker::FDelegateHandle QueueTickerHandle;
+
+    /**
+     * Push the waiting entries of the layer that fit within its QueueMaxVisible and QueueDisplayRate settings.
+     *
+     * @return true if entries are still waiting on the layer.
+     */
+    bool DisplayQueuedEntries(const FGameplayTag& LayerName, FBlazeLayer& Layer);
+
+    /** Return the number of widgets on the layer, including those pushed or removed within an open transaction. */
+    int32 GetNumLayerWidgets(const FGameplayTag& LayerName, const FBlazeLayer& Layer) const;
+
+    /** Remove the ticker that displays waiting entries if no entries are waiting on any layer. */
+    void RemoveQueueTickerIfIdle();
+
+    /** Move the payload into the widget if it implements IBlazePayloadReceiver, otherwise discard it. */
+    static void DeliverPayload(UCommonActivatableWidget& Widget, FInstancedStruct&& Payload);
+
+    /** Create a widget for the layer, which is a proxy if the layer is headless. */
+    UCommonActivatableWidget* CreateLayerWidget(const FBlazeLayer& Layer,
+                                                TSubclassOf<UCommonActivatableWidget> WidgetClass);
 };
 
 template <typename T>
-TSharedPtr<FStreamableHandle>
+FBlazePushRequest
 UBlazePrimaryLayout::PushWidgetToLayerAsync(const FGameplayTag LayerName,
                                             const bool bSuspendInputUntilComplete,
                                             const TSoftClassPtr<UCommonActivatableWidget> WidgetClass,
-                                            const TFunction<void(EBlazePushWidgetToLayerState, T*)> CallbackFunc)
+                                            const TFunction<void(EBlazePushWidgetToLayerState, T*)> CallbackFunc,
+                                            const bool bRevealWhenResident)
 {
     static_assert(TIsDerivedFrom<T, UCommonActivatableWidget>::IsDerived,
                   "Template type T must be derived from UCommonActivatableWidget");
-    return PushWidgetToLayerStackAsync_Internal(
-        LayerName,
-        bSuspendInputUntilComplete,
-        WidgetClass,
-        [CallbackFunc](auto State, auto Widget) { CallbackFunc(State, Widget); });
+    return PushWidgetToLayerAsync(LayerName,
+                                  bSuspendInputUntilComplete,
+                                  WidgetClass,
+                                  FBlazePushRequestDelegate::CreateLambda([CallbackFunc](auto State, auto Widget) {
+                                      CallbackFunc(State, Cast<T>(Widget));
+                                  }),
+                                  bRevealWhenResident);
 }
 
 template <typename T>
@@ -173,20 +819,40 @@ T* UBlazePrimaryLayout::PushWidgetToLayer(const FGameplayTag LayerName,
 {
     static_assert(TIsDerivedFrom<T, UCommonActivatableWidget>::IsDerived,
                   "Template type T must be derived from UCommonActivatableWidget");
-    const auto Layer = GetLayer(LayerName);
-    if (ensureAlwaysMsgf(Layer,
-                         TEXT("PushWidgetToLayer called with unregistered layer [%s] on layout [%s]"),
-                         *LayerName.ToString(),
-                         *GetName())
-        && ensureAlwaysMsgf(WidgetClass,
-                            TEXT("PushWidgetToLayer called with null WidgetClass for layer [%s] on layout [%s]"),
-                            *LayerName.ToString(),
-                            *GetName()))
+    return Cast<T>(PushWidgetToLayer_Internal(LayerName, WidgetClass, [&InitInstanceFunc](auto& Widget) {
+        if (const auto TypedWidget = Cast<T>(&Widget))
+        {
+            InitInstanceFunc(*TypedWidget);
+        }
+    }));
+}
+
+/**
+ * A helper that opens a layer transaction on construction and commits it on destruction.
+ *
+ * @see UBlazePrimaryLayout::BeginLayerTransaction
+ */
+class FBlazeScopedLayerTransaction final
+{
+public:
+    explicit FBlazeScopedLayerTransaction(UBlazePrimaryLayout* InLayout) : Layout(InLayout)
     {
-        return Layer->AddWidget<T>(const_cast<UClass*>(WidgetClass), InitInstanceFunc);
+        if (InLayout)
+        {
+            InLayout->BeginLayerTransaction();
+        }
     }
-    else
+
+    ~FBlazeScopedLayerTransaction()
     {
-        return nullptr;
+        if (const auto CurrentLayout = Layout.Get())
+        {
+            CurrentLayout->CommitLayerTransaction();
+        }
     }
-}
+
+    UE_NONCOPYABLE(FBlazeScopedLayerTransaction);
+
+private:
+    TWeakObjectPtr<UBlazePrimaryLayout> Layout;
+};
@@ -15,10 +15,24 @@
 
 #include "BlazePrimaryLayoutManager.generated.h"
 
+struct FBlazeWidgetQuery;
+struct FGameplayTag;
 class UBlazeSubsystem;
+class UCommonActivatableWidget;
 class ULocalPlayer;
 class UBlazePrimaryLayout;
 
+/** The player whose input is routed to the widgets pushed onto the layers of the shared layout. */
+UENUM(BlueprintType)
+enum class EBlazeSharedInputOwner : uint8
+{
+    // Widgets receive input from the player that owns the shared layout, which is the first player added.
+    PrimaryPlayer,
+    // Widgets receive input from the player whose push created them. The widgets are removed when that player is
+    // destroyed.
+    PushingPlayer
+};
+
 /**
  * @struct FPrimaryLayoutMapping
  * @brief Represents an entry containing data about a primary layout associated with a local player.
@@ -70,6 +84,7 @@ class UBlazePrimaryLayoutManager : public UObject
 
 public:
     BLAZE_API virtual UWorld* GetWorld() const override;
+    BLAZE_API virtual void BeginDestroy() override;
 
     /**
      * Retrieves the primary layout associated with the specified local player.
@@ -82,6 +97,59 @@ public:
      */
     BLAZE_API UBlazePrimaryLayout* GetPrimaryLayout(const ULocalPlayer* LocalPlayer) const;
 
+    /** Return the layout shared by every local player, or nullptr if the manager does not create one. */
+    FORCEINLINE UBlazePrimaryLayout* GetSharedLayout() const { return SharedLayout; }
+
+    /**
+     * Retrieves the layout that hosts the specified layer for the local player.
+     *
+     * Layers registered with the shared layout are hosted by the shared layout for every player. Any other layer is
+     * hosted by the primary layout of the player.
+     *
+     * @param LocalPlayer The local player that is accessing the layer.
+     * @param LayerName The gameplay tag identifying the layer.
+     * @return The layout that hosts the layer, or nullptr if the player has no primary layout.
+     */
+    BLAZE_API UBlazePrimaryLayout* GetLayoutForLayer(const ULocalPlayer* LocalPlayer, FGameplayTag LayerName) const;
+
+    /**
+     * Assign the player that owns the input of a widget that is being pushed onto a layer by a local player.
+     *
+     * This does nothing unless the widget was created by the shared layout. The widget is assigned to the pushing
+     * player or to the owner of the shared layout, depending upon SharedInputOwner. It is expected to be invoked when
+     * the widget is initialized, before it is added to the layer and activated.
+     *
+     * @param Widget The widget being pushed.
+     * @param PushingPlayer The local player that requested the push.
+     */
+    BLAZE_API void AssignSharedWidgetOwner(UCommonActivatableWidget& Widget, const ULocalPlayer* PushingPlayer) const;
+
+    /**
+     * Remove every widget on the shared layout that matches the query and that the local player may remove.
+     *
+     * When SharedInputOwner is PushingPlayer only the widgets owned by the local player are removed, otherwise
+     * every matching widget is removed.
+     *
+     * @param LocalPlayer The local player that is removing the widgets.
+     * @param Query The query used to select the widgets to remove.
+     * @return The number of widgets removed.
+     */
+    BLAZE_API int32 PopAllSharedWidgets(const ULocalPlayer* LocalPlayer, const FBlazeWidgetQuery& Query) const;
+
+    /** Return the number of added players whose primary layout is waiting to be created by a batched join. */
+    FORCEINLINE int32 GetNumPendingPlayerJoins() const { return PendingPlayerJoins.Num(); }
+
+    /** Return the number of players with a primary layout whose input is suspended by Blaze. */
+    BLAZE_API int32 GetNumInputSuspendedPlayers() const;
+
+    /**
+     * Create the primary layouts of every player waiting on a batched join immediately, ignoring the frame budget.
+     *
+     * This can be used when code must access the layout of a player in the same frame that the player was added.
+     * A player whose controller has not been spawned remains pending.
+     */
+    BLAZE_API void FlushPendingPlayerJoins();
+
 protected:
     /**
      * @brief A template method invoked when a primary layout is successfully added to the viewport
@@ -123,6 +191,31 @@ protected:
      */
     BLAZE_API virtual UBlazePrimaryLayout* CreatePrimaryLayout(APlayerController* PlayerController);
 
+    /**
+     * @brief A template method invoked once per batched join step before the primary layouts of the step are created.
+     *
+     * Subclasses can override this method to resolve or load the layout classes once for every player that joins in
+     * the step, rather than in each call to CreatePrimaryLayout.
+     *
+     * @param NumPlayers The number of players waiting for a primary layout.
+     */
+    BLAZE_API virtual void PrepareToCreatePrimaryLayouts(int32 NumPlayers);
+
+    /**
+     * @brief Creates the layout shared by every local player.
+     *
+     * Global content such as notifications, system dialogs and loading overlays can be hosted by layers of the
+     * shared layout so that it is constructed once rather than once per player in split-screen. The shared layout
+     * is added to the whole viewport and pushes onto its layers from any player are routed to it.
+     *
+     * This method is invoked when the first player is added and returns nullptr by default, in which case there is
+     * no shared layout. The layers registered by the shared layout should not be registered by the primary layouts.
+     *
+     * @param PlayerController The player controller that will initially own the shared layout.
+     * @return A pointer to the newly created shared layout, or nullptr if there is no shared layout.
+     */
+    BLAZE_API virtual UBlazePrimaryLayout* CreateSharedLayout(APlayerController* PlayerController);
+
     /**
      * @brief Return the Z-order value to be used when adding a primary layout for a specified local player to the
      * player's screen.
@@ -137,10 +230,36 @@ protected:
     /** The Default ZOrder when adding layouts to the player's screen. */
     static constexpr int DefaultZOrder{ 1000 };
 
+    /** The ZOrder when adding the shared layout to the viewport, which places it above the player layouts. */
+    static constexpr int SharedLayoutZOrder{ DefaultZOrder + 100 };
+
+    /** The player whose input is routed to the widgets pushed onto the layers of the shared layout. */
+    UPROPERTY(EditDefaultsOnly, Category = "Blaze")
+    EBlazeSharedInputOwner SharedInputOwner{ EBlazeSharedInputOwner::PrimaryPlayer };
+
+    /**
+     * Whether the primary layouts of added players are created in a batched step at the end of the frame.
+     *
+     * When several controllers join at once, creating and adding each layout as the player is added stacks the
+     * construction hitches into one frame. A batched join defers the creation to the end of the frame, creates the
+     * layouts within the "Blaze.Join.FrameBudgetMs" budget and continues on later frames if required, and adds the
+     * layouts created in a step to the viewport together after the split-screen layout is applied once. The primary
+     * layout of an added player is not available until its join has been processed.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Blaze")
+    bool bBatchPlayerJoins{ false };
+
 private:
     UPROPERTY(Transient)
     TArray<FPrimaryLayoutMapping> PrimaryLayouts;
 
+    UPROPERTY(Transient)
+    TObjectPtr<UBlazePrimaryLayout> SharedLayout{ nullptr };
+
+    /** The local player that owns the shared layout. */
+    UPROPERTY(Transient)
+    TObjectPtr<const ULocalPlayer> SharedLayoutOwner{ nullptr };
+
     void AddPrimaryLayoutToViewport(ULocalPlayer* LocalPlayer, UBlazePrimaryLayout* Layout);
     void RemovePrimaryLayoutFromViewport(ULocalPlayer* LocalPlayer, UBlazePrimaryLayout* Layout);
 
@@ -150,5 +269,38 @@ private:
 
     void TryCreateAndAddPrimaryLayoutToViewport(ULocalPlayer* LocalPlayer);
 
+    /**
+     * Create the primary layout for the player and record it without adding it to the viewport.
+     *
+     * @return The new layout, or nullptr if the player has no player controller or the layout could not be created.
+     */
+    UBlazePrimaryLayout* CreatePrimaryLayoutForPlayer(ULocalPlayer* LocalPlayer);
+
+    /** The added players whose primary layout is waiting to be created, in the order they were added. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<ULocalPlayer>> PendingPlayerJoins;
+
+    /** The handle of the end of frame delegate that processes the pending player joins. */
+    FDelegateHandle PendingPlayerJoinsHandle;
+
+    /**
+     * Create the primary layouts of pending players until the budget is exhausted and add them to the viewport.
+     * At least one layout is created per step.
+     *
+     * @param BudgetSeconds The time that the step may spend creating layouts.
+     */
+    void ProcessPendingPlayerJoins(double BudgetSeconds);
+
+    void TryCreateSharedLayout(ULocalPlayer* LocalPlayer, APlayerController* PlayerController);
+
+    /**
+     * Remove the shared widgets that are owned by the destroyed player and transfer the shared layout to another
+     * player, or release it if no players remain.
+     */
+    void ReleaseSharedWidgets(const ULocalPlayer* LocalPlayer);
+
+    /** Record the number of input suspended players and the widgets in each layout into the CSV profiler. */
+    void RecordCsvStats() const;
+
     friend class UBlazeSubsystem;
 };
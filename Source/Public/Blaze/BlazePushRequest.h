@@ -0,0 +1,160 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Delegates/Delegate.h"
+#include "GameplayTagContainer.h"
+#include "UObject/SoftObjectPtr.h"
+
+struct FInstancedStruct;
+class UBlazePrimaryLayout;
+class UCommonActivatableWidget;
+
+/**
+ * The state of the async operation to push a widget onto a Layer.
+ */
+enum class EBlazePushWidgetToLayerState : uint8
+{
+    // State when the widget push operation is canceled or the Widget Class failed to resolve.
+    Canceled,
+    // State after the widget has been initialized and before pushed onto the layer.
+    Initialize,
+    // State after the widget has been pushed onto the layer.
+    AfterPush
+};
+
+/**
+ * The status of a push request as reported by FBlazePushRequest::GetStatus().
+ */
+enum class EBlazePushRequestStatus : uint8
+{
+    // The handle does not reference a request.
+    Invalid,
+    // The widget class is loading or the widget is being pushed onto the layer.
+    Pending,
+    // The widget has been pushed onto the layer.
+    Completed,
+    // The request was canceled or failed.
+    Canceled
+};
+
+/**
+ * Native delegate invoked as a push request progresses.
+ * The widget is null when the state is EBlazePushWidgetToLayerState::Canceled.
+ */
+DECLARE_DELEGATE_TwoParams(FBlazePushRequestDelegate, EBlazePushWidgetToLayerState, UCommonActivatableWidget*);
+
+/**
+ * @brief A handle to an asynchronous request to load a widget class and push an instance onto a layer.
+ *
+ * The state of each request is held in a pool of recycled slots rather than in a UObject so that native
+ * code can issue a large number of requests without creating garbage. The handle is a small ref-counted
+ * value type; the slot is returned to the pool once the request has finished and the last handle that
+ * references it has been released. A handle whose request has finished can still be used to query the
+ * status and the pushed widget.
+ *
+ * Requests are created via UBlazePrimaryLayout::PushWidgetToLayerAsync and must only be used on the game thread.
+ */
+class FBlazePushRequest final
+{
+public:
+    FBlazePushRequest() = default;
+
+    BLAZE_API FBlazePushRequest(const FBlazePushRequest& Other);
+
+    BLAZE_API FBlazePushRequest(FBlazePushRequest&& Other);
+
+    BLAZE_API FBlazePushRequest& operator=(const FBlazePushRequest& Other);
+
+    BLAZE_API FBlazePushRequest& operator=(FBlazePushRequest&& Other);
+
+    BLAZE_API ~FBlazePushRequest();
+
+    /** Return true if the handle references a request. */
+    FORCEINLINE bool IsValid() const { return 0 != Serial; }
+
+    /** Return the status of the referenced request, or EBlazePushRequestStatus::Invalid if the handle is empty. */
+    BLAZE_API EBlazePushRequestStatus GetStatus() const;
+
+    /** Return true if the referenced request has not yet completed or been canceled. */
+    FORCEINLINE bool IsPending() const { return EBlazePushRequestStatus::Pending == GetStatus(); }
+
+    /** Return the layer that the widget is pushed onto, or an empty tag if the handle is empty. */
+    BLAZE_API FGameplayTag GetLayerName() const;
+
+    /** Return the path of the widget class that the request pushes, or an empty path if the request has finished. */
+    BLAZE_API FSoftObjectPath GetWidgetClassPath() const;
+
+    /** Return the widget pushed by the request, if the request completed and the widget is still alive. */
+    BLAZE_API UCommonActivatableWidget* GetWidget() const;
+
+    /**
+     * Cancel the request if the widget class is still loading.
+     * The delegate is invoked with EBlazePushWidgetToLayerState::Canceled and any suspended input is resumed.
+     * Cancellation has no effect once the widget class has loaded.
+     */
+    BLAZE_API void Cancel();
+
+    /** Release the reference to the request. This does not cancel the request. */
+    BLAZE_API void Reset();
+
+    /** Return the number of requests that occupy a slot in the pool, either pending or referenced by a handle. */
+    BLAZE_API static int32 GetNumLiveRequests();
+
+    /** Return the number of requests whose widget class is loading or whose widget is being pushed. */
+    BLAZE_API static int32 GetNumPendingRequests();
+
+    FORCEINLINE bool operator==(const FBlazePushRequest& Other) const
+    {
+        return Index == Other.Index && Serial == Other.Serial;
+    }
+
+private:
+    friend class UBlazePrimaryLayout;
+
+    FBlazePushRequest(uint32 InIndex, uint32 InSerial);
+
+    /**
+     * Start a request that loads the widget class and pushes an instance onto the layer of the layout.
+     *
+     * @return The handle to the request, or an empty handle if the load could not be started. The delegate has been
+     * invoked with EBlazePushWidgetToLayerState::Canceled in the latter case.
+     */
+    static FBlazePushRequest Start(UBlazePrimaryLayout& Layout,
+                                   const FGameplayTag& LayerName,
+                                   bool bSuspendInputUntilComplete,
+                                   const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass,
+                                   FInstancedStruct&& Payload,
+                                   FBlazePushRequestDelegate&& Delegate,
+                                   bool bRevealWhenResident);
+
+    /** Start loading the widget class and the assets it references, if the request is still pending. */
+    static void BeginLoad(uint32 InIndex, uint32 InSerial, const TArray<FSoftObjectPath>& Paths);
+
+    /** Invoked when the widget class has loaded. */
+    static void OnLoaded(uint32 InIndex, uint32 InSerial);
+
+    /** Resume input, record the outcome and notify the delegate if the request is still pending. */
+    static void
+    Finish(uint32 InIndex, uint32 InSerial, EBlazePushWidgetToLayerState State, UCommonActivatableWidget* Widget);
+
+    /** Increment the reference count of the slot if the handle is valid. */
+    void AddRef() const;
+
+    /** Decrement the reference count of the slot and return the slot to the pool if it is no longer used. */
+    void Release();
+
+    uint32 Index{ 0 };
+    uint32 Serial{ 0 };
+};
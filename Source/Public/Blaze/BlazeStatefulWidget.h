@@ -0,0 +1,48 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "UObject/Interface.h"
+#include "BlazeStatefulWidget.generated.h"
+
+class FArchive;
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UBlazeStatefulWidget : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * @class IBlazeStatefulWidget
+ * @brief Interface implemented by widgets that can save and restore their state when Blaze recreates them.
+ *
+ * Blaze uses this interface when capturing a layout snapshot and when a widget is recreated from a
+ * saved record, so that the recreated widget appears to the user as the original did.
+ */
+class IBlazeStatefulWidget
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Save or restore the state of the widget.
+     *
+     * The same archive layout MUST be used when saving and loading. When restoring, this is invoked after
+     * the widget has been created and before it is added to a layer.
+     *
+     * @param Ar The archive to save the state to or load the state from. Use Ar.IsLoading() to determine the direction.
+     */
+    virtual void SerializeWidgetState(FArchive& Ar) = 0;
+};
@@ -13,6 +13,7 @@
  */
 #pragma once
 
+#include "GameplayTagContainer.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "UObject/SoftObjectPtr.h"
 #include "BlazeSubsystem.generated.h"
@@ -90,6 +91,12 @@ public:
      */
     BLAZE_API virtual void NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer);
 
+    /** Return true if the subsystem is configured to run headless. */
+    FORCEINLINE bool IsHeadless() const { return bHeadless; }
+
+    /** Return the layers registered with each layout when the subsystem runs headless. */
+    FORCEINLINE const FGameplayTagContainer& GetHeadlessLayers() const { return HeadlessLayers; }
+
 protected:
     /**
      * @brief A template method invoked after a primary layout manager is switched in.
@@ -118,10 +125,30 @@ private:
     UPROPERTY(Transient)
     TObjectPtr<UBlazePrimaryLayoutManager> PrimaryLayoutManager{ nullptr };
 
-    UPROPERTY(Config, EditAnywhere)
+    UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "!bHeadless"))
     TSoftClassPtr<UBlazePrimaryLayoutManager> PrimaryLayoutManagerClass{ nullptr };
 
+    /**
+     * Whether the subsystem runs headless, such as on bot clients driving load tests.
+     *
+     * A headless subsystem uses UBlazeHeadlessPrimaryLayoutManager rather than PrimaryLayoutManagerClass. Widgets
+     * pushed onto layers are recorded as lightweight proxies and no UMG or Slate widgets are constructed, while
+     * pushes, pops and their callbacks behave as they do when the UI is displayed.
+     */
+    UPROPERTY(Config, EditAnywhere)
+    bool bHeadless{ false };
+
+    /** The layers registered with each layout when the subsystem runs headless. */
+    UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bHeadless", Categories = "UILayersCategory"))
+    FGameplayTagContainer HeadlessLayers;
+
     void SwitchToPrimaryLayoutManager(UBlazePrimaryLayoutManager* InPrimaryLayoutManager);
 
+    FDelegateHandle EndFrameHandle;
+
+    /** Record the per-frame counts of Blaze into the CSV profiler when a capture is in progress. */
+    void RecordCsvStats() const;
+
     friend class UBlazeFunctionLibrary;
+    friend class FBlazeTestWorld;
 };
@@ -0,0 +1,183 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Blaze/BlazePayloadReceiver.h"
+#include "Engine/EngineBaseTypes.h"
+#include "GameplayTagContainer.h"
+#include "UObject/Object.h"
+#include "BlazeViewModelStore.generated.h"
+
+class UWorld;
+
+/** Invoked at most once per frame with the bound fields that changed during the frame. */
+DECLARE_DELEGATE_OneParam(FBlazeViewModelFieldsChanged, const FGameplayTagContainer& /* ChangedFields */);
+
+/** Invoked at most once per frame with the bound fields that changed during the frame. */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FBlazeViewModelFieldsChangedDynamic, const FGameplayTagContainer&, ChangedFields);
+
+/**
+ * A value held by a UBlazeViewModelStore.
+ */
+USTRUCT()
+struct FBlazeViewModelField
+{
+    GENERATED_BODY()
+
+    /** The current value of the field. */
+    UPROPERTY(Transient)
+    FInstancedStruct Value;
+
+    /** The number of times the value of the field has changed. */
+    uint32 Version{ 0 };
+
+    /** True while the field is in the dirty queue of the store. */
+    bool bDirty{ false };
+};
+
+/**
+ * @brief The per-player store of the values that widgets on layers display.
+ *
+ * HUD widgets that poll gameplay state every tick, or that subscribe to per-property delegates that fire several
+ * times a frame, refresh far more often than the player can see. Gameplay code instead writes values into the store
+ * of the player via SetField. Each field is identified by a gameplay tag and holds a versioned value. Writing a value
+ * that differs from the current value bumps the version of the field and adds it to a dirty queue, which the store
+ * drains once per frame after the actors of the world have ticked. Each binding is then notified once, with every
+ * bound field that changed during the frame, so a widget refreshes at most once per frame however many writes occur.
+ *
+ * The store is owned by the UBlazePrimaryLayout of the player and is created on first use.
+ *
+ * @see UBlazePrimaryLayout::GetViewModelStore
+ */
+UCLASS(MinimalAPI, BlueprintType)
+class UBlazeViewModelStore final : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    BLAZE_API virtual void BeginDestroy() override;
+
+    /**
+     * Set the value of a field.
+     *
+     * If the value differs from the current value, the version of the field is incremented and the field is queued
+     * so that bindings are notified after gameplay has ticked this frame.
+     *
+     * @param Field The tag identifying the field.
+     * @param Value The new value, which is moved into the store.
+     * @return true if the value changed.
+     */
+    BLAZE_API bool SetField(const FGameplayTag& Field, FInstancedStruct&& Value);
+
+    /** Set the value of a field from a struct. */
+    template <typename T>
+    bool SetFieldValue(const FGameplayTag& Field, const T& Value)
+    {
+        return SetField(Field, FInstancedStruct::Make(Value));
+    }
+
+    /** Return the value of a field, or nullptr if the field has not been set. */
+    BLAZE_API const FInstancedStruct* GetField(const FGameplayTag& Field) const;
+
+    /** Return the value of a field as a struct, or nullptr if the field has not been set or is of another type. */
+    template <typename T>
+    const T* GetFieldValue(const FGameplayTag& Field) const
+    {
+        const auto Value = GetField(Field);
+        return Value ? Value->GetPtr<T>() : nullptr;
+    }
+
+    /** Return the number of times the value of a field has changed, or 0 if the field has not been set. */
+    UFUNCTION(BlueprintPure, Category = "Blaze")
+    BLAZE_API int32 GetFieldVersion(FGameplayTag Field) const;
+
+    /**
+     * Bind a delegate that is invoked at most once per frame with the fields that changed during the frame.
+     *
+     * @param Fields The fields that the delegate observes.
+     * @param Delegate The delegate to invoke.
+     * @return The handle used to unbind the delegate.
+     */
+    BLAZE_API FDelegateHandle BindFields(const FGameplayTagContainer& Fields, FBlazeViewModelFieldsChanged&& Delegate);
+
+    /** Unbind a delegate bound via BindFields. */
+    BLAZE_API void UnbindFields(FDelegateHandle Handle);
+
+    /** Unbind every delegate bound to the object. */
+    UFUNCTION(BlueprintCallable, Category = "Blaze")
+    BLAZE_API void UnbindAllFields(const UObject* Object);
+
+    /** Set the value of a field. */
+    UFUNCTION(DisplayName = "Set Field", BlueprintCallable, Category = "Blaze")
+    bool BP_SetField(FGameplayTag Field, const FInstancedStruct& Value);
+
+    /** Return the value of a field, or an empty value if the field has not been set. */
+    UFUNCTION(DisplayName = "Get Field", BlueprintPure, Category = "Blaze")
+    FInstancedStruct BP_GetField(FGameplayTag Field) const;
+
+    /** Bind a delegate that is invoked at most once per frame with the fields that changed during the frame. */
+    UFUNCTION(DisplayName = "Bind Fields", BlueprintCallable, Category = "Blaze")
+    void BP_BindFields(const FGameplayTagContainer& InFields, FBlazeViewModelFieldsChangedDynamic Delegate);
+
+    /** Return the number of fields that changed this frame and have not yet been dispatched. */
+    FORCEINLINE int32 GetNumDirtyFields() const { return DirtyFields.Num(); }
+
+    /**
+     * Notify the bindings of the fields that changed since the last dispatch.
+     *
+     * This is invoked automatically once per frame while fields are queued. Fields set by a binding while it is
+     * notified are dispatched on the next frame. Delegates bound or unbound while the bindings are notified take
+     * effect once every binding has been notified.
+     */
+    BLAZE_API void DispatchDirtyFields();
+
+private:
+    /** A delegate bound to a set of fields. */
+    struct FBinding
+    {
+        FGameplayTagContainer Fields;
+        FBlazeViewModelFieldsChanged Delegate;
+
+        /** True if the binding was unbound while the bindings were being notified. */
+        bool bRemoved{ false };
+    };
+
+    /** The fields of the store. */
+    UPROPERTY(Transient)
+    TMap<FGameplayTag, FBlazeViewModelField> Fields;
+
+    /** The fields that changed since the last dispatch, in the order they first changed. */
+    TArray<FGameplayTag> DirtyFields;
+
+    /** The delegates bound to the store. */
+    TArray<FBinding> Bindings;
+
+    /** The delegates bound while the bindings are being notified, which are added once the dispatch completes. */
+    TArray<FBinding> PendingBindings;
+
+    /** True while the bindings are being notified. */
+    bool bDispatching{ false };
+
+    /**
+     * The handle of the delegate that dispatches dirty fields after the actors of the world have ticked.
+     * It is only bound while fields are queued, so an idle store costs nothing per frame.
+     */
+    FDelegateHandle PostActorTickHandle;
+
+    /** Remove the bindings that match the predicate, deferring the removal while the bindings are notified. */
+    void RemoveBindings(TFunctionRef<bool(const FBinding&)> Predicate);
+
+    /** Dispatch the dirty fields once the actors of the world of the owning layout have ticked. */
+    void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+};
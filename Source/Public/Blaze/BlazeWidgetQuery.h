@@ -0,0 +1,49 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Templates/SubclassOf.h"
+#include "BlazeWidgetQuery.generated.h"
+
+class UCommonActivatableWidget;
+
+/**
+ * @struct FBlazeWidgetQuery
+ * @brief A query that selects widgets across the layers of a primary layout.
+ *
+ * An empty query matches every widget on every layer.
+ */
+USTRUCT(BlueprintType)
+struct FBlazeWidgetQuery
+{
+    GENERATED_BODY()
+
+    /** The layers to match. If empty then widgets on any layer match. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze", meta = (Categories = "UILayersCategory"))
+    FGameplayTagContainer LayerNames;
+
+    /** The class that matching widgets must be or derive from. If null then widgets of any class match. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blaze")
+    TSubclassOf<UCommonActivatableWidget> WidgetClass{ nullptr };
+
+    /**
+     * Return true if the widget on the specified layer matches the query.
+     *
+     * @param LayerName The layer the widget is present on.
+     * @param Widget The widget to test.
+     * @return true if the widget matches the query.
+     */
+    BLAZE_API bool Matches(const FGameplayTag& LayerName, const UCommonActivatableWidget& Widget) const;
+};